@@ -178,6 +178,11 @@ namespace utils
 		return content;
 	}
 
+	MappedFile AndroidApp::mapFileContent( std::string const & fileName )const
+	{
+		return MappedFile{ m_activity->assetManager, fileName };
+	}
+
 	std::string AndroidApp::setFileTextContent( std::string const & content
 		, std::string const & fileName )const
 	{
@@ -10,6 +10,7 @@
 
 #include "AndroidWindow.h"
 #include "GestureDetector.h"
+#include "MappedFile.h"
 
 #include <android/native_activity.h>
 
@@ -119,6 +120,16 @@ namespace utils
 			, bool fromResource )const;
 		/**
 		*\brief
+		*	Projette le contenu d'un fichier des ressources en mémoire, sans
+		*	le copier.
+		*\param[in] fileName
+		*	Le nom du fichier.
+		*\return
+		*	La projection, invalide si le fichier n'a pas été trouvé.
+		*/
+		MappedFile mapFileContent( std::string const & fileName )const;
+		/**
+		*\brief
 		*	Ecrit un texte dans un fichier du système de fichiers.
 		*\param[in] content
 		*	Le contenu du fichier.
@@ -20,6 +20,7 @@ namespace utils
 	class ObjLoader;
 	class AndroidApp;
 	class AndroidWindow;
+	class MappedFile;
 	/**@}*/
 	/**
 	*\name Définitions diverses depuis les prédéclarations.
@@ -0,0 +1,127 @@
+#include "MappedFile.h"
+
+#include <sys/mman.h>
+
+namespace utils
+{
+	MappedFile::MappedFile( AAssetManager * manager
+		, std::string const & fileName )
+	{
+		auto asset = AAssetManager_open( manager
+			, fileName.c_str()
+			, AASSET_MODE_BUFFER );
+
+		if ( asset )
+		{
+			off_t start{ 0 };
+			off_t length{ 0 };
+			auto fd = AAsset_openFileDescriptor( asset, &start, &length );
+
+			if ( fd >= 0 )
+			{
+				// Asset non compressé : projection directe depuis l'APK.
+				auto page = off_t( sysconf( _SC_PAGESIZE ) );
+				auto offset = start % page;
+				m_mappingSize = size_t( length + offset );
+				m_mapping = mmap( nullptr
+					, m_mappingSize
+					, PROT_READ
+					, MAP_PRIVATE
+					, fd
+					, start - offset );
+				close( fd );
+
+				if ( m_mapping != MAP_FAILED )
+				{
+					m_data = static_cast< char const * >( m_mapping ) + offset;
+					m_size = size_t( length );
+				}
+				else
+				{
+					m_mapping = nullptr;
+					m_mappingSize = 0u;
+				}
+			}
+
+			if ( m_data )
+			{
+				AAsset_close( asset );
+			}
+			else
+			{
+				// Asset compressé : le tampon est décompressé une seule fois
+				// par AAsset_getBuffer, et reste valide tant que l'asset est
+				// ouvert.
+				m_data = static_cast< char const * >( AAsset_getBuffer( asset ) );
+
+				if ( m_data )
+				{
+					m_size = size_t( AAsset_getLength( asset ) );
+					m_asset = asset;
+				}
+				else
+				{
+					AAsset_close( asset );
+				}
+			}
+		}
+
+		if ( !m_data )
+		{
+			std::cerr << "Couldn't map asset [" << fileName << "]." << std::endl;
+		}
+	}
+
+	MappedFile::MappedFile( MappedFile && rhs )noexcept
+		: m_data{ rhs.m_data }
+		, m_size{ rhs.m_size }
+		, m_asset{ rhs.m_asset }
+		, m_mapping{ rhs.m_mapping }
+		, m_mappingSize{ rhs.m_mappingSize }
+	{
+		rhs.m_data = nullptr;
+		rhs.m_size = 0u;
+		rhs.m_asset = nullptr;
+		rhs.m_mapping = nullptr;
+		rhs.m_mappingSize = 0u;
+	}
+
+	MappedFile & MappedFile::operator=( MappedFile && rhs )noexcept
+	{
+		if ( this != &rhs )
+		{
+			doCleanup();
+			std::swap( m_data, rhs.m_data );
+			std::swap( m_size, rhs.m_size );
+			std::swap( m_asset, rhs.m_asset );
+			std::swap( m_mapping, rhs.m_mapping );
+			std::swap( m_mappingSize, rhs.m_mappingSize );
+		}
+
+		return *this;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		doCleanup();
+	}
+
+	void MappedFile::doCleanup()noexcept
+	{
+		if ( m_mapping )
+		{
+			munmap( m_mapping, m_mappingSize );
+		}
+
+		if ( m_asset )
+		{
+			AAsset_close( m_asset );
+		}
+
+		m_data = nullptr;
+		m_size = 0u;
+		m_asset = nullptr;
+		m_mapping = nullptr;
+		m_mappingSize = 0u;
+	}
+}
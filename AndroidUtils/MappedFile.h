@@ -0,0 +1,108 @@
+/**
+*\file
+*	MappedFile.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___AndroidUtils_MappedFile_HPP___
+#define ___AndroidUtils_MappedFile_HPP___
+#pragma once
+
+#include "AndroidUtilsPrerequisites.h"
+
+#include <android/asset_manager.h>
+
+namespace utils
+{
+	/**
+	*\brief
+	*	Asset projeté en mémoire, en lecture seule.
+	*\remarks
+	*	Un asset stocké sans compression est projeté directement depuis
+	*	l'APK, via son descripteur de fichier. Sinon, le tampon fourni par
+	*	AAsset_getBuffer est utilisé, sans copie supplémentaire.
+	*/
+	class MappedFile
+	{
+	private:
+		MappedFile( MappedFile const & ) = delete;
+		MappedFile & operator=( MappedFile const & ) = delete;
+
+	public:
+		/**
+		*\brief
+		*	Constructeur, projette l'asset en mémoire.
+		*\param[in] manager
+		*	Le gestionnaire d'assets.
+		*\param[in] fileName
+		*	Le nom de l'asset.
+		*/
+		MappedFile( AAssetManager * manager
+			, std::string const & fileName );
+		/**
+		*\brief
+		*	Constructeur par déplacement.
+		*/
+		MappedFile( MappedFile && rhs )noexcept;
+		/**
+		*\brief
+		*	Opérateur d'affectation par déplacement.
+		*/
+		MappedFile & operator=( MappedFile && rhs )noexcept;
+		/**
+		*\brief
+		*	Destructeur, libère la projection.
+		*/
+		~MappedFile();
+		/**
+		*\return
+		*	Le début du contenu, \p nullptr si l'asset n'a pas pu être
+		*	projeté.
+		*/
+		inline char const * begin()const noexcept
+		{
+			return m_data;
+		}
+		/**
+		*\return
+		*	La fin du contenu.
+		*/
+		inline char const * end()const noexcept
+		{
+			return m_data + m_size;
+		}
+		/**
+		*\return
+		*	La taille du contenu.
+		*/
+		inline size_t size()const noexcept
+		{
+			return m_size;
+		}
+		/**
+		*\return
+		*	\p true si l'asset a été projeté.
+		*/
+		inline bool valid()const noexcept
+		{
+			return m_data != nullptr;
+		}
+
+	private:
+		void doCleanup()noexcept;
+
+	private:
+		//! Le début du contenu.
+		char const * m_data{ nullptr };
+		//! La taille du contenu.
+		size_t m_size{ 0u };
+		//! L'asset, lorsque son tampon est utilisé.
+		AAsset * m_asset{ nullptr };
+		//! Le début de la projection, alignée sur une page.
+		void * m_mapping{ nullptr };
+		//! La taille de la projection.
+		size_t m_mappingSize{ 0u };
+	};
+}
+
+#endif
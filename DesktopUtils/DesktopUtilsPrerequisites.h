@@ -38,6 +38,7 @@ namespace utils
 	using Clock = std::chrono::high_resolution_clock;
 
 	class FontLoader;
+	class MappedFile;
 	class ObjLoader;
 	/**
 	*\brief
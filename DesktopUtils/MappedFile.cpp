@@ -0,0 +1,182 @@
+#include "MappedFile.h"
+
+#if defined( _WIN32 )
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace utils
+{
+#if defined( _WIN32 )
+
+	MappedFile::MappedFile( std::string const & fileName )
+	{
+		auto file = ::CreateFileA( fileName.c_str()
+			, GENERIC_READ
+			, FILE_SHARE_READ
+			, nullptr
+			, OPEN_EXISTING
+			, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN
+			, nullptr );
+
+		if ( file != INVALID_HANDLE_VALUE )
+		{
+			m_file = file;
+			LARGE_INTEGER size;
+
+			if ( ::GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+			{
+				m_mapping = ::CreateFileMappingA( file
+					, nullptr
+					, PAGE_READONLY
+					, 0
+					, 0
+					, nullptr );
+
+				if ( m_mapping )
+				{
+					m_data = static_cast< char const * >( ::MapViewOfFile( m_mapping
+						, FILE_MAP_READ
+						, 0
+						, 0
+						, 0 ) );
+					m_size = m_data ? size_t( size.QuadPart ) : 0u;
+				}
+			}
+		}
+
+		if ( !m_data )
+		{
+			std::cerr << "Couldn't map file [" << fileName << "]." << std::endl;
+			doCleanup();
+		}
+	}
+
+	void MappedFile::doCleanup()noexcept
+	{
+		if ( m_data )
+		{
+			::UnmapViewOfFile( m_data );
+		}
+
+		if ( m_mapping )
+		{
+			::CloseHandle( m_mapping );
+		}
+
+		if ( m_file )
+		{
+			::CloseHandle( m_file );
+		}
+
+		m_data = nullptr;
+		m_size = 0u;
+		m_mapping = nullptr;
+		m_file = nullptr;
+	}
+
+	MappedFile::MappedFile( MappedFile && rhs )noexcept
+		: m_data{ rhs.m_data }
+		, m_size{ rhs.m_size }
+		, m_file{ rhs.m_file }
+		, m_mapping{ rhs.m_mapping }
+	{
+		rhs.m_data = nullptr;
+		rhs.m_size = 0u;
+		rhs.m_file = nullptr;
+		rhs.m_mapping = nullptr;
+	}
+
+	MappedFile & MappedFile::operator=( MappedFile && rhs )noexcept
+	{
+		if ( this != &rhs )
+		{
+			doCleanup();
+			std::swap( m_data, rhs.m_data );
+			std::swap( m_size, rhs.m_size );
+			std::swap( m_file, rhs.m_file );
+			std::swap( m_mapping, rhs.m_mapping );
+		}
+
+		return *this;
+	}
+
+#else
+
+	MappedFile::MappedFile( std::string const & fileName )
+	{
+		auto fd = ::open( fileName.c_str(), O_RDONLY );
+
+		if ( fd >= 0 )
+		{
+			struct stat info;
+
+			if ( ::fstat( fd, &info ) == 0 && info.st_size > 0 )
+			{
+				auto data = ::mmap( nullptr
+					, size_t( info.st_size )
+					, PROT_READ
+					, MAP_PRIVATE
+					, fd
+					, 0 );
+
+				if ( data != MAP_FAILED )
+				{
+					::madvise( data, size_t( info.st_size ), MADV_SEQUENTIAL );
+					m_data = static_cast< char const * >( data );
+					m_size = size_t( info.st_size );
+				}
+			}
+
+			// La projection reste valide après la fermeture du fichier.
+			::close( fd );
+		}
+
+		if ( !m_data )
+		{
+			std::cerr << "Couldn't map file [" << fileName << "]." << std::endl;
+		}
+	}
+
+	void MappedFile::doCleanup()noexcept
+	{
+		if ( m_data )
+		{
+			::munmap( const_cast< char * >( m_data ), m_size );
+		}
+
+		m_data = nullptr;
+		m_size = 0u;
+	}
+
+	MappedFile::MappedFile( MappedFile && rhs )noexcept
+		: m_data{ rhs.m_data }
+		, m_size{ rhs.m_size }
+	{
+		rhs.m_data = nullptr;
+		rhs.m_size = 0u;
+	}
+
+	MappedFile & MappedFile::operator=( MappedFile && rhs )noexcept
+	{
+		if ( this != &rhs )
+		{
+			doCleanup();
+			std::swap( m_data, rhs.m_data );
+			std::swap( m_size, rhs.m_size );
+		}
+
+		return *this;
+	}
+
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		doCleanup();
+	}
+}
@@ -0,0 +1,102 @@
+/**
+*\file
+*	MappedFile.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___DesktopUtils_MappedFile_HPP___
+#define ___DesktopUtils_MappedFile_HPP___
+#pragma once
+
+#include "DesktopUtilsPrerequisites.h"
+
+namespace utils
+{
+	/**
+	*\brief
+	*	Fichier projeté en mémoire, en lecture seule.
+	*\remarks
+	*	Le contenu est lu directement depuis les pages du fichier, sans
+	*	copie dans un tampon intermédiaire.
+	*/
+	class MappedFile
+	{
+	private:
+		MappedFile( MappedFile const & ) = delete;
+		MappedFile & operator=( MappedFile const & ) = delete;
+
+	public:
+		/**
+		*\brief
+		*	Constructeur, projette le fichier en mémoire.
+		*\param[in] fileName
+		*	Le nom du fichier.
+		*/
+		MappedFile( std::string const & fileName );
+		/**
+		*\brief
+		*	Constructeur par déplacement.
+		*/
+		MappedFile( MappedFile && rhs )noexcept;
+		/**
+		*\brief
+		*	Opérateur d'affectation par déplacement.
+		*/
+		MappedFile & operator=( MappedFile && rhs )noexcept;
+		/**
+		*\brief
+		*	Destructeur, libère la projection.
+		*/
+		~MappedFile();
+		/**
+		*\return
+		*	Le début du contenu, \p nullptr si le fichier n'a pas pu être
+		*	projeté.
+		*/
+		inline char const * begin()const noexcept
+		{
+			return m_data;
+		}
+		/**
+		*\return
+		*	La fin du contenu.
+		*/
+		inline char const * end()const noexcept
+		{
+			return m_data + m_size;
+		}
+		/**
+		*\return
+		*	La taille du contenu.
+		*/
+		inline size_t size()const noexcept
+		{
+			return m_size;
+		}
+		/**
+		*\return
+		*	\p true si le fichier a été projeté.
+		*/
+		inline bool valid()const noexcept
+		{
+			return m_data != nullptr;
+		}
+
+	private:
+		void doCleanup()noexcept;
+
+	private:
+		//! Le début de la projection.
+		char const * m_data{ nullptr };
+		//! La taille du fichier.
+		size_t m_size{ 0u };
+#if defined( _WIN32 )
+		//! Le fichier.
+		void * m_file{ nullptr };
+		//! L'objet de projection.
+		void * m_mapping{ nullptr };
+#endif
+	};
+}
+
+#endif
@@ -203,6 +203,36 @@ namespace gl
 	};
 	/**
 	*\brief
+	*	Structure de traits définissant les informations d'un attribut, en
+	*	fonction de son type.
+	*\remarks
+	*	Spécialisation pour gl::U16Vec2, lu comme un vec2 dans le shader,
+	*	sans normalisation : les composantes valent de 0 à 65535.
+	*/
+	template<>
+	struct AttributeTraits< gl::U16Vec2 >
+	{
+		static int constexpr size = 2;
+		static AttributeType constexpr type = AttributeType::eUShort;
+		static AttributeFullType constexpr full_type = AttributeFullType::eVec2;
+	};
+	/**
+	*\brief
+	*	Structure de traits définissant les informations d'un attribut, en
+	*	fonction de son type.
+	*\remarks
+	*	Spécialisation pour gl::I8Vec2, lu comme un vec2 dans le shader,
+	*	sans normalisation : les composantes valent de -128 à 127.
+	*/
+	template<>
+	struct AttributeTraits< gl::I8Vec2 >
+	{
+		static int constexpr size = 2;
+		static AttributeType constexpr type = AttributeType::eByte;
+		static AttributeFullType constexpr full_type = AttributeFullType::eVec2;
+	};
+	/**
+	*\brief
 	*	Gère un attribut de sommet lié à un tampon GPU.
 	*	Voir \ref gllib_attribute.
 	*/
@@ -150,6 +150,8 @@ namespace gl
 	using IVec2 = Vec2T< int >;
 	using IVec3 = Vec3T< int >;
 	using IVec4 = Vec4T< int >;
+	using U16Vec2 = Vec2T< uint16_t >;
+	using I8Vec2 = Vec2T< int8_t >;
 	using Quaternion = QuaternionT< float >;
 	using RgbaColour = Vec4;
 	using RgbColour = Vec3;
@@ -220,12 +222,16 @@ namespace gl
 	using Vec2Attribute = Attribute< Vec2 >;
 	using Vec3Attribute = Attribute< Vec3 >;
 	using Vec4Attribute = Attribute< Vec4 >;
+	using U16Vec2Attribute = Attribute< U16Vec2 >;
+	using I8Vec2Attribute = Attribute< I8Vec2 >;
 	template< typename T >
 	using AttributePtr = std::unique_ptr< Attribute< T > >;
 	using FloatAttributePtr = AttributePtr< float >;
 	using Vec2AttributePtr = AttributePtr< Vec2 >;
 	using Vec3AttributePtr = AttributePtr< Vec3 >;
 	using Vec4AttributePtr = AttributePtr< Vec4 >;
+	using U16Vec2AttributePtr = AttributePtr< U16Vec2 >;
+	using I8Vec2AttributePtr = AttributePtr< I8Vec2 >;
 	/**@}*/
 	/**
 	*\name Typedefs de variables uniformes.
@@ -0,0 +1,63 @@
+/**
+*\file
+*	Packing.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___GlLib_Packing_HPP___
+#define ___GlLib_Packing_HPP___
+#pragma once
+
+#include "GlLibPrerequisites.h"
+
+namespace gl
+{
+	/**
+	*\brief
+	*	Convertit un flottant en demi-flottant IEEE 754 (binary16).
+	*\remarks
+	*	L'arrondi se fait au plus proche, les valeurs trop grandes donnent
+	*	l'infini.
+	*\param[in] value
+	*	La valeur à convertir.
+	*\return
+	*	Les bits du demi-flottant.
+	*/
+	inline uint16_t packHalf( float value )noexcept;
+	/**
+	*\brief
+	*	Convertit un demi-flottant IEEE 754 (binary16) en flottant.
+	*\param[in] value
+	*	Les bits du demi-flottant.
+	*\return
+	*	La valeur convertie.
+	*/
+	inline float unpackHalf( uint16_t value )noexcept;
+	/**
+	*\brief
+	*	Encode une direction en coordonnées octaédriques, sur 2x16 bits.
+	*\remarks
+	*	La direction est projetée sur l'octaèdre unité, dont la moitié
+	*	inférieure est dépliée sur le carré [-1, 1]².\n
+	*	La norme de la direction est perdue, une direction nulle est décodée
+	*	en (0, 0, 1).
+	*\param[in] direction
+	*	La direction, pas forcément normalisée.
+	*\return
+	*	Les coordonnées octaédriques.
+	*/
+	inline U16Vec2 packOctahedral( Vec3 const & direction )noexcept;
+	/**
+	*\brief
+	*	Décode une direction encodée par packOctahedral.
+	*\param[in] value
+	*	Les coordonnées octaédriques.
+	*\return
+	*	La direction, normalisée.
+	*/
+	inline Vec3 unpackOctahedral( U16Vec2 const & value )noexcept;
+}
+
+#include "Packing.inl"
+
+#endif
@@ -0,0 +1,147 @@
+#include <cmath>
+#include <cstring>
+
+namespace gl
+{
+	namespace details
+	{
+		inline float signNotZero( float value )noexcept
+		{
+			return value >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		inline uint16_t packSnorm16( float value )noexcept
+		{
+			value = std::min( 1.0f, std::max( -1.0f, value ) );
+			return uint16_t( std::lround( ( value * 0.5f + 0.5f ) * 65535.0f ) );
+		}
+
+		inline float unpackSnorm16( uint16_t value )noexcept
+		{
+			return float( value ) / 65535.0f * 2.0f - 1.0f;
+		}
+	}
+
+	inline uint16_t packHalf( float value )noexcept
+	{
+		uint32_t bits;
+		std::memcpy( &bits, &value, sizeof( bits ) );
+		uint32_t const sign = ( bits >> 16 ) & 0x8000u;
+		uint32_t const biased = ( bits >> 23 ) & 0xFFu;
+		uint32_t mantissa = bits & 0x007FFFFFu;
+
+		if ( biased == 0xFFu )
+		{
+			// Infini ou NaN.
+			return uint16_t( sign | 0x7C00u | ( mantissa ? 0x0200u : 0u ) );
+		}
+
+		int32_t const exponent = int32_t( biased ) - 127 + 15;
+
+		if ( exponent >= 31 )
+		{
+			return uint16_t( sign | 0x7C00u );
+		}
+
+		if ( exponent <= 0 )
+		{
+			// Dénormalisé, ou trop petit.
+			if ( exponent < -10 )
+			{
+				return uint16_t( sign );
+			}
+
+			mantissa |= 0x00800000u;
+			uint32_t const shift = uint32_t( 14 - exponent );
+			uint32_t result = mantissa >> shift;
+			uint32_t const rest = mantissa & ( ( 1u << shift ) - 1u );
+			uint32_t const middle = 1u << ( shift - 1u );
+
+			if ( rest > middle || ( rest == middle && ( result & 1u ) ) )
+			{
+				++result;
+			}
+
+			return uint16_t( sign | result );
+		}
+
+		uint32_t result = ( uint32_t( exponent ) << 10 ) | ( mantissa >> 13 );
+		uint32_t const rest = mantissa & 0x1FFFu;
+
+		// La retenue peut déborder sur l'exposant, ce qui reste correct.
+		if ( rest > 0x1000u || ( rest == 0x1000u && ( result & 1u ) ) )
+		{
+			++result;
+		}
+
+		return uint16_t( sign | result );
+	}
+
+	inline float unpackHalf( uint16_t value )noexcept
+	{
+		uint32_t const sign = uint32_t( value & 0x8000u ) << 16;
+		uint32_t const exponent = ( value >> 10 ) & 0x1Fu;
+		uint32_t const mantissa = value & 0x03FFu;
+		uint32_t bits;
+
+		if ( exponent == 0u )
+		{
+			auto result = std::ldexp( float( mantissa ), -24 );
+			return sign ? -result : result;
+		}
+
+		if ( exponent == 31u )
+		{
+			bits = sign | 0x7F800000u | ( mantissa << 13 );
+		}
+		else
+		{
+			bits = sign | ( ( exponent - 15u + 127u ) << 23 ) | ( mantissa << 13 );
+		}
+
+		float result;
+		std::memcpy( &result, &bits, sizeof( result ) );
+		return result;
+	}
+
+	inline U16Vec2 packOctahedral( Vec3 const & direction )noexcept
+	{
+		auto const norm = std::abs( direction.x )
+			+ std::abs( direction.y )
+			+ std::abs( direction.z );
+
+		if ( norm == 0.0f )
+		{
+			return U16Vec2{ details::packSnorm16( 0.0f )
+				, details::packSnorm16( 0.0f ) };
+		}
+
+		auto x = direction.x / norm;
+		auto y = direction.y / norm;
+
+		if ( direction.z < 0.0f )
+		{
+			auto const fx = ( 1.0f - std::abs( y ) ) * details::signNotZero( x );
+			y = ( 1.0f - std::abs( x ) ) * details::signNotZero( y );
+			x = fx;
+		}
+
+		return U16Vec2{ details::packSnorm16( x )
+			, details::packSnorm16( y ) };
+	}
+
+	inline Vec3 unpackOctahedral( U16Vec2 const & value )noexcept
+	{
+		Vec3 result
+		{
+			details::unpackSnorm16( value.x ),
+			details::unpackSnorm16( value.y ),
+			0.0f
+		};
+		result.z = 1.0f - std::abs( result.x ) - std::abs( result.y );
+		auto const t = std::max( -result.z, 0.0f );
+		result.x += result.x >= 0.0f ? -t : t;
+		result.y += result.y >= 0.0f ? -t : t;
+		return normalize( result );
+	}
+}
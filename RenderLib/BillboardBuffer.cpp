@@ -67,8 +67,10 @@ namespace render
 		//*********************************************************************
 	}
 
-	BillboardBuffer::BillboardBuffer( bool scale )
+	BillboardBuffer::BillboardBuffer( bool scale
+		, bool threshold )
 		: m_scale{ scale }
+		, m_threshold{ threshold }
 	{
 	}
 
@@ -93,9 +95,9 @@ namespace render
 	{
 		auto it = std::find_if( std::begin( m_buffer )
 			, std::end( m_buffer )
-			, [&threshold]( auto const & element )
+			, [&threshold]( Element const & element )
 		{
-			return element[0].data.magnitude > threshold;
+			return gl::unpackHalf( element.magnitude ) > threshold;
 		} );
 
 		if ( it != std::end( m_buffer ) )
@@ -113,116 +115,183 @@ namespace render
 		, gl::Vec3 const & position
 		, float scale )
 	{
+		static Range< float > const alphaRange{ makeRange( 0.0f, 10.0f ) };
+		static std::array< gl::I8Vec2, 6u > const corners
+		{
+			{
+				gl::I8Vec2{ -1, -1 },
+				gl::I8Vec2{ +1, +1 },
+				gl::I8Vec2{ +1, -1 },
+				gl::I8Vec2{ -1, -1 },
+				gl::I8Vec2{ -1, +1 },
+				gl::I8Vec2{ +1, +1 },
+			}
+		};
 		auto buffer = m_visible->lock();
 
 		if ( buffer )
 		{
 			auto current = buffer;
-			auto count = 0u;
-			std::for_each( std::begin( m_buffer )
-				, std::begin( m_buffer ) + m_buffer.size()
-				, [&count
-					, &camera
-					, &position
-					, &scale
-					, &current
-					, this]( Quad const & quad )
+			auto realScale = m_scale ? 1.5f : 1.0f;
+			auto realAlpha = m_scale ? scale : 1.0f;
+			auto emit = [&]( Element const & element
+				, uint32_t id )
 			{
+				auto magnitude = gl::unpackHalf( element.magnitude );
+				Vertex vertex
+				{
+					element.direction,
+					element.radius,
+					element.scale,
+					gl::U16Vec2{ gl::packHalf( 2.0f * alphaRange.invpercent( magnitude ) / realAlpha )
+						, gl::packHalf( 0.0f ) },
+					gl::I8Vec2{},
+					float( id ),
+				};
+
 				if ( m_scale )
 				{
-					if ( camera.visible( quad[0].data.center + position ) )
+					vertex.scale = gl::U16Vec2{ gl::packHalf( gl::unpackHalf( element.scale.x ) * realScale )
+						, gl::packHalf( gl::unpackHalf( element.scale.y ) * realScale ) };
+				}
+
+				auto & visible = *current;
+
+				for ( size_t i = 0u; i < corners.size(); ++i )
+				{
+					visible[i] = vertex;
+					visible[i].texture = corners[i];
+				}
+
+				++current;
+			};
+			auto test = [&]( uint32_t first
+				, uint32_t last )
+			{
+				for ( auto id = first; id < last; ++id )
+				{
+					auto & element = m_buffer[id];
+					auto center = gl::unpackOctahedral( element.direction ) * element.radius;
+
+					if ( camera.visible( center + position ) )
 					{
-						auto & visible = *current;
-						visible = quad;
-						//auto realScale = scale;
-						//auto realAlpha = 1.0f;
-						auto realScale = 1.5f;
-						auto realAlpha = scale;
-
-						visible[0].data.scale *= realScale;
-						visible[0].alpha /= realAlpha;
-						visible[1].data.scale *= realScale;
-						visible[1].alpha /= realAlpha;
-						visible[2].data.scale *= realScale;
-						visible[2].alpha /= realAlpha;
-						visible[3].data.scale *= realScale;
-						visible[3].alpha /= realAlpha;
-						visible[4].data.scale *= realScale;
-						visible[4].alpha /= realAlpha;
-						visible[5].data.scale *= realScale;
-						visible[5].alpha /= realAlpha;
-
-						count++;
-						++current;
+						emit( element, id );
 					}
 				}
-				else
+			};
+
+			if ( doHasClusters() )
+			{
+				// Un seul test par groupe suffit, sauf pour ceux coupant le
+				// frustum.
+				for ( auto & cluster : m_clusters )
 				{
-					if ( camera.visible( quad[0].data.center + position ) )
+					auto last = cluster.first + cluster.count;
+
+					switch ( camera.frustum().intersects( cluster.centre + position
+						, cluster.radius ) )
 					{
-						auto & visible = *current;
-						visible = quad;
-						++current;
-					}
+					case Intersection::eIn:
+						for ( auto id = cluster.first; id < last; ++id )
+						{
+							emit( m_buffer[id], id );
+						}
+						break;
+
+					case Intersection::eIntersect:
+						test( cluster.first, last );
+						break;
 
-					count++;
+					case Intersection::eOut:
+						break;
+					}
 				}
-			} );
+			}
+			else
+			{
+				// Les points étant triés par magnitude, ceux au-delà du seuil
+				// ne sont pas parcourus.
+				test( 0u
+					, m_threshold
+						? std::min( m_unculled, uint32_t( m_buffer.size() ) )
+						: uint32_t( m_buffer.size() ) );
+			}
+
 			m_count = uint32_t( std::distance( buffer, current ) );
 		}
 
 		m_visible->unlock();
 	}
 
+	void BillboardBuffer::clusters( ClusterArray && clusters )
+	{
+		assert( !m_threshold );
+		m_clusters = std::move( clusters );
+	}
+
 	void BillboardBuffer::remove( uint32_t index )
 	{
 		assert( index < m_buffer.size() );
 		m_buffer.erase( m_buffer.begin() + index );
 	}
 
+	void BillboardBuffer::clear()
+	{
+		m_buffer.clear();
+		m_clusters.clear();
+		m_unculled = 0u;
+		m_count = 0u;
+	}
+
 	void BillboardBuffer::add( BillboardData const & data )
 	{
-		static Range< float > const alphaRange{ makeRange( 0.0f, 10.0f ) };
-		float fid{ float( m_buffer.size() ) };
-		auto quad = Quad
+		m_buffer.push_back( Element
 		{
-			{
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { -0.5, -0.5 }, fid },
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { +0.5, +0.5 }, fid },
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { +0.5, -0.5 }, fid },
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { -0.5, -0.5 }, fid },
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { -0.5, +0.5 }, fid },
-				Vertex{ data, 2.0f * alphaRange.invpercent( data.magnitude ), { +0.5, +0.5 }, fid },
-			}
-		};
-		m_buffer.push_back( quad );
+			gl::packOctahedral( data.center ),
+			gl::length( data.center ),
+			gl::packHalf( data.magnitude ),
+			gl::U16Vec2{ gl::packHalf( data.scale.x ), gl::packHalf( data.scale.y ) },
+		} );
 	}
 
 	void BillboardBuffer::add( BillboardDataArray const & datas )
 	{
+		m_buffer.reserve( m_buffer.size() + datas.size() );
+
 		for ( auto & data : datas )
 		{
 			add( data );
 		}
 	}
 
-	BillboardData const & BillboardBuffer::at( uint32_t index )const
+	BillboardData BillboardBuffer::at( uint32_t index )const
 	{
 		assert( index < m_buffer.size() );
-		return m_buffer[index][0].data;
+		auto & element = m_buffer[index];
+		return BillboardData
+		{
+			gl::unpackHalf( element.magnitude ),
+			gl::unpackOctahedral( element.direction ) * element.radius,
+			gl::Vec2{ gl::unpackHalf( element.scale.x ), gl::unpackHalf( element.scale.y ) },
+		};
 	}
 
 	void BillboardBuffer::at( uint32_t index, BillboardData const & data )
 	{
 		assert( index < m_buffer.size() );
-
-		for ( auto & in : m_buffer[index] )
-		{
-			in.data = data;
-		}
-
+		auto & element = m_buffer[index];
+		element.direction = gl::packOctahedral( data.center );
+		element.radius = gl::length( data.center );
+		element.magnitude = gl::packHalf( data.magnitude );
+		element.scale = gl::U16Vec2{ gl::packHalf( data.scale.x ), gl::packHalf( data.scale.y ) };
 		onBillboardBufferChanged( *this );
 	}
 
+	bool BillboardBuffer::doHasClusters()const
+	{
+		return !m_clusters.empty()
+			&& m_clusters.back().first + m_clusters.back().count == m_buffer.size();
+	}
+
 	//*************************************************************************
 }
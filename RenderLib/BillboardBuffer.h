@@ -11,6 +11,8 @@
 #include "Range.h"
 #include "RenderSignal.h"
 
+#include <GlLib/Packing.h>
+
 #include <array>
 
 namespace render
@@ -40,24 +42,60 @@ namespace render
 		/**
 		*\brief
 		*	Les données d'un sommet en VRAM.
+		*\remarks
+		*	Les données sont compactées, et décodées dans le vertex shader.
 		*/
 		struct Vertex
 		{
-			//! Ses données.
-			BillboardData data;
-			//! Sa transparence.
-			float alpha;
-			//! Ses coordonnées de texture.
-			gl::Vec2 texture;
+			//! La direction de son centre, en coordonnées octaédriques.
+			gl::U16Vec2 direction;
+			//! La distance de son centre à l'origine.
+			float radius;
+			//! Son échelle, en demi-flottants.
+			gl::U16Vec2 scale;
+			//! Sa transparence, et s'il est highlight, en demi-flottants.
+			gl::U16Vec2 alpha;
+			//! Son coin dans le quad, -1 ou 1 sur chaque axe.
+			gl::I8Vec2 texture;
 			//! Son ID de billboard.
 			float id;
-			//! Si elle est highlight ou pas.
-			int highlight;
+		};
+		/**
+		*\brief
+		*	Les données compactes d'un billboard en RAM.
+		*/
+		struct Element
+		{
+			//! La direction de son centre, en coordonnées octaédriques.
+			gl::U16Vec2 direction;
+			//! La distance de son centre à l'origine.
+			float radius;
+			//! Sa magnitude, en demi-flottant.
+			uint16_t magnitude;
+			//! Son échelle, en demi-flottants.
+			gl::U16Vec2 scale;
 		};
 		//! Un quad est composé de 6 sommets, pour l'afficher en tant que triangle.
 		using Quad = std::array< Vertex, 6 >;
 		/**
 		*\brief
+		*	Un groupe de billboards consécutifs, et la sphère les englobant.
+		*/
+		struct Cluster
+		{
+			//! L'index du premier billboard.
+			uint32_t first;
+			//! Le nombre de billboards.
+			uint32_t count;
+			//! Le centre de la sphère englobante.
+			gl::Vec3 centre;
+			//! Le rayon de la sphère englobante.
+			float radius;
+		};
+		//! Un tableau de groupes.
+		using ClusterArray = std::vector< Cluster >;
+		/**
+		*\brief
 		*	Le stockage des billboards visibles.
 		*/
 		class Storage
@@ -99,8 +137,12 @@ namespace render
 		*\param[in] scale
 		*	Dit si on veut que les billboards soient mis à l'échelle du zoom, c'est à
 		*	dire qu'ils ne varieront pas de taille.
+		*\param[in] threshold
+		*	Dit si le culling s'arrête au seuil de magnitude de la scène
+		*	(voir update), les points devant alors être triés par magnitude.
 		*/
-		BillboardBuffer( bool scale );
+		BillboardBuffer( bool scale
+			, bool threshold = false );
 		/**
 		*\brief
 		*	Initialise le VBO afin qu'il puisse contenir les données du tampon.
@@ -133,6 +175,21 @@ namespace render
 			, float scale );
 		/**
 		*\brief
+		*	Définit les groupes de billboards utilisés par cull().
+		*\remarks
+		*	Les billboards des groupes entièrement hors du frustum sont
+		*	ignorés, ceux des groupes entièrement dedans sont affichés sans
+		*	être testés un à un.\n
+		*	Les groupes doivent couvrir tous les points, dans l'ordre : ils
+		*	sont ignorés dès que la liste change de taille. Ils ne sont pas
+		*	utilisables avec le seuil de magnitude, qui veut les points
+		*	triés par magnitude.
+		*\param[in] clusters
+		*	Les groupes, dont le contenu est déplacé.
+		*/
+		void clusters( ClusterArray && clusters );
+		/**
+		*\brief
 		*	Retire un point de la liste.
 		*\param[in] index
 		*	L'index du point.
@@ -140,6 +197,13 @@ namespace render
 		void remove( uint32_t index );
 		/**
 		*\brief
+		*	Vide la liste.
+		*\remarks
+		*	Le stockage GPU garde sa taille, jusqu'à sa réinitialisation.
+		*/
+		void clear();
+		/**
+		*\brief
 		*	Ajoute un point à la liste.
 		*\param[in] data
 		*	Les données du point.
@@ -160,7 +224,7 @@ namespace render
 		*\return
 		*	Le point.
 		*/
-		BillboardData const & at( uint32_t index )const;
+		BillboardData at( uint32_t index )const;
 		/**
 		*\brief
 		*	Définit la position d'un point de la liste.
@@ -171,6 +235,23 @@ namespace render
 		*/
 		void at( uint32_t index, BillboardData const & data );
 		/**
+		*\brief
+		*	Définit la direction d'un point de la liste, sans changer sa
+		*	distance.
+		*\remarks
+		*	Les sommets visibles étant recalculés à chaque cull(), aucune
+		*	notification n'est émise.
+		*\param[in] index
+		*	L'index du point.
+		*\param[in] direction
+		*	La direction, en coordonnées octaédriques.
+		*/
+		inline void direction( uint32_t index, gl::U16Vec2 const & direction )
+		{
+			assert( index < m_buffer.size() );
+			m_buffer[index].direction = direction;
+		}
+		/**
 		*\return
 		*	Le nombre de billboards à afficher (prend en compte le seuil).
 		*/
@@ -186,7 +267,7 @@ namespace render
 		*\return
 		*	Le point.
 		*/
-		inline BillboardData const & operator[]( uint32_t index )const
+		inline BillboardData operator[]( uint32_t index )const
 		{
 			return at( index );
 		}
@@ -200,6 +281,13 @@ namespace render
 			return m_visible->vbo();
 		}
 
+	private:
+		/**
+		*\brief
+		*	Dit si les groupes couvrent tous les points.
+		*/
+		bool doHasClusters()const;
+
 	public:
 		//! La notification de tampon changé.
 		OnBillboardBufferChanged onBillboardBufferChanged;
@@ -209,12 +297,16 @@ namespace render
 		uint32_t m_unculled{ 0u };
 		//! Le nombre de billboards à afficher (en fonction du seuil et du culling).
 		uint32_t m_count{ 0u };
-		//! La liste des sommets.
-		std::vector< Quad > m_buffer;
+		//! La liste des billboards.
+		std::vector< Element > m_buffer;
+		//! Les groupes de billboards, voir clusters().
+		ClusterArray m_clusters;
 		//! Le stockage des sommets visibles.
 		StoragePtr m_visible;
 		//! Dit si on veut que les billboards soient mis à l'échelle du zoom.
 		bool m_scale{ false };
+		//! Dit si les billboards plus faibles que le seuil sont ignorés.
+		bool m_threshold{ false };
 	};
 }
 
@@ -26,6 +26,7 @@ namespace render
 				, m_position + front
 				, up );
 			m_frustum.update( m_position, right, up, front );
+			m_front = front;
 			m_changed = false;
 		}
 
@@ -41,4 +42,20 @@ namespace render
 	{
 		return m_frustum.visible( position );
 	}
+
+	gl::Vec3 Camera::ray( gl::IVec2 const & position )const
+	{
+		// Les axes de la vue sont les lignes de sa matrice, la position est
+		// ramenée dans [-1, 1] puis à l'ouverture de la projection.
+		auto const & size = m_viewport.size();
+		auto const ratio = float( size.x ) / float( size.y );
+		auto const tan = float( gl::tan( gl::Radians{ m_viewport.fovY() / 2 } ) );
+		auto const x = 1.0f - 2.0f * float( position.x ) / float( size.x );
+		auto const y = 1.0f - 2.0f * float( position.y ) / float( size.y );
+		gl::Vec3 const right{ m_transform[0][0], m_transform[1][0], m_transform[2][0] };
+		gl::Vec3 const up{ m_transform[0][1], m_transform[1][1], m_transform[2][1] };
+		return gl::normalize( m_front
+			+ right * ( x * tan * ratio )
+			+ up * ( y * tan ) );
+	}
 }
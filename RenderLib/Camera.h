@@ -52,6 +52,19 @@ namespace render
 		*/
 		bool visible( gl::Vec3 const & position )const;
 		/**
+		*\brief
+		*	Calcule la direction du rayon partant de la caméra et passant par
+		*	la position écran donnée.
+		*\remarks
+		*	La position est en coordonnées fenêtre, comme pour le picking :
+		*	les deux axes sont inversés par rapport à ceux d'OpenGL.
+		*\param[in] position
+		*	La position écran.
+		*\return
+		*	La direction, normalisée.
+		*/
+		gl::Vec3 ray( gl::IVec2 const & position )const;
+		/**
 		*\return
 		*	La position de la caméra.
 		*/
@@ -61,6 +74,14 @@ namespace render
 		}
 		/**
 		*\return
+		*	La direction de visée de la caméra, calculée lors de update().
+		*/
+		inline gl::Vec3 const & front()const noexcept
+		{
+			return m_front;
+		}
+		/**
+		*\return
 		*	La matrice de vue.
 		*/
 		inline gl::Mat4 const & view()const noexcept
@@ -165,6 +186,8 @@ namespace render
 		gl::Vec3 m_position;
 		//! L'orientation de la caméra dans le monde.
 		gl::Quaternion m_orientation;
+		//! La direction de visée de la caméra.
+		gl::Vec3 m_front{ 0, 0, 1 };
 		//! La matrice de vue.
 		gl::Mat4 m_transform;
 		//! Le viewport.
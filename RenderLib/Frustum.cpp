@@ -71,5 +71,28 @@ namespace render
 		return it == m_planes.end();
 	}
 
+	Intersection Frustum::intersects( gl::Vec3 const & centre
+		, float radius )const
+	{
+		auto result = Intersection::eIn;
+
+		for ( auto & plane : m_planes )
+		{
+			auto distance = plane.distance( centre );
+
+			if ( distance < -radius )
+			{
+				return Intersection::eOut;
+			}
+
+			if ( distance < radius )
+			{
+				result = Intersection::eIntersect;
+			}
+		}
+
+		return result;
+	}
+
 	//*************************************************************************
 }
@@ -37,6 +37,19 @@ namespace render
 		GlLib_EnumBounds( eLeft )
 	};
 	/**
+	*\brief
+	*	La position d'un volume par rapport au frustum.
+	*/
+	enum class Intersection
+	{
+		//! Entièrement en dehors.
+		eOut,
+		//! En partie dans le frustum.
+		eIntersect,
+		//! Entièrement dans le frustum.
+		eIn,
+	};
+	/**
 	\brief
 	*	Implémente un frustum et les vérifications relatives au frustum
 	*	culling.
@@ -76,6 +89,18 @@ namespace render
 		*	\p false si le point en dehors du frustum de vue.
 		*/
 		bool visible( gl::Vec3 const & point )const;
+		/**
+		*\brief
+		*	Situe la sphère donnée par rapport au frustum de vue.
+		*\param[in] centre
+		*	Le centre de la sphère.
+		*\param[in] radius
+		*	Le rayon de la sphère.
+		*\return
+		*	La position de la sphère.
+		*/
+		Intersection intersects( gl::Vec3 const & centre
+			, float radius )const;
 
 	private:
 		//! Le viewport.
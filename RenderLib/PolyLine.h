@@ -89,6 +89,14 @@ namespace render
 		void add( LineArray const & lines );
 		/**
 		*\brief
+		*	Vide la liste.
+		*/
+		inline void clear()
+		{
+			m_buffer.clear();
+		}
+		/**
+		*\brief
 		*	Définit le matériau.
 		*\param[in] value
 		*	La nouvelle valeur.
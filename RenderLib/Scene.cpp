@@ -154,6 +154,18 @@ namespace render
 		m_newBillboardBuffers.push_back( buffer );
 	}
 
+	void Scene::updateBillboardBuffer( BillboardBufferPtr buffer )
+	{
+		if ( std::find( m_newBillboardBuffers.begin()
+			, m_newBillboardBuffers.end()
+			, buffer ) == m_newBillboardBuffers.end() )
+		{
+			m_newBillboardBuffers.push_back( buffer );
+		}
+
+		m_cameraChanged = true;
+	}
+
 	void Scene::onMovableChanged( Movable & movable )
 	{
 		m_changedMovables.push_back( &movable );
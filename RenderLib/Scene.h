@@ -126,6 +126,14 @@ namespace render
 		void addBillboardBuffer( std::string const & name
 			, BillboardBufferPtr buffer );
 		/**
+		*\brief
+		*	Signale qu'un tampon de billboard de la liste a été agrandi, son
+		*	stockage GPU sera recréé lors de la prochaine mise à jour.
+		*\param[in] buffer
+		*	Le tampon.
+		*/
+		void updateBillboardBuffer( BillboardBufferPtr buffer );
+		/**
 		*\return
 		*	La caméra.
 		*/
@@ -150,21 +150,21 @@ namespace render
 		, m_billboardUbo{ "Billboard", 2u, *m_program }
 		, m_dimensions{ &m_billboardUbo.createUniform< gl::Vec2 >( "dimensions" ) }
 		, m_camera{ &m_billboardUbo.createUniform< gl::Vec3 >( "camera" ) }
-		, m_position{ m_program->createAttribute< gl::Vec3 >( "position"
+		, m_direction{ m_program->createAttribute< gl::U16Vec2 >( "direction"
+			, sizeof( BillboardBuffer::Vertex )
+			, offsetof( BillboardBuffer::Vertex, direction ) ) }
+		, m_radius{ m_program->createAttribute< float >( "radius"
 			, sizeof( BillboardBuffer::Vertex )
-			, offsetof( BillboardData, center ) ) }
-		, m_scale{ m_program->createAttribute< gl::Vec2 >( "scale"
+			, offsetof( BillboardBuffer::Vertex, radius ) ) }
+		, m_scale{ m_program->createAttribute< gl::U16Vec2 >( "scale"
 			, sizeof( BillboardBuffer::Vertex )
-			, offsetof( BillboardData, scale ) ) }
-		, m_alpha{ m_program->createAttribute< float >( "alpha"
+			, offsetof( BillboardBuffer::Vertex, scale ) ) }
+		, m_alpha{ m_program->createAttribute< gl::U16Vec2 >( "alpha"
 			, sizeof( BillboardBuffer::Vertex )
 			, offsetof( BillboardBuffer::Vertex, alpha ) ) }
-		, m_texture{ m_program->createAttribute< gl::Vec2 >( "texture"
+		, m_texture{ m_program->createAttribute< gl::I8Vec2 >( "texture"
 			, sizeof( BillboardBuffer::Vertex )
 			, offsetof( BillboardBuffer::Vertex, texture ) ) }
-		, m_highlight{ m_program->createAttribute< float >( "highlight"
-			, sizeof( BillboardBuffer::Vertex )
-			, offsetof( BillboardBuffer::Vertex, highlight ) ) }
 	{
 		m_billboardUbo.initialise();
 	}
@@ -407,20 +407,20 @@ namespace render
 					node.m_matUbo.bind( 1u );
 					node.m_billboardUbo.bind( 2u );
 					billboard->buffer().vbo().bind();
-					node.m_position->bind();
+					node.m_direction->bind();
+					node.m_radius->bind();
 					node.m_scale->bind();
 					node.m_alpha->bind();
 					node.m_texture->bind();
-					node.m_highlight->bind();
 					glCheckError( glDrawArrays
 						, GL_TRIANGLES
 						, 0
 						, billboard->buffer().count() * 6 );
-					node.m_highlight->unbind();
 					node.m_texture->unbind();
 					node.m_alpha->unbind();
 					node.m_scale->unbind();
-					node.m_position->unbind();
+					node.m_radius->unbind();
+					node.m_direction->unbind();
 					billboard->buffer().vbo().unbind();
 					doUnbindMaterial( node, billboard->material() );
 				}
@@ -117,16 +117,16 @@ namespace render
 			gl::Vec2Uniform * m_dimensions;
 			//! La variable uniforme contenant la position de la caméra.
 			gl::Vec3Uniform * m_camera;
-			//! Attribut de position.
-			gl::Vec3AttributePtr m_position;
+			//! Attribut de direction du centre.
+			gl::U16Vec2AttributePtr m_direction;
+			//! Attribut de distance du centre.
+			gl::FloatAttributePtr m_radius;
 			//! Attribut d'échelle.
-			gl::Vec2AttributePtr m_scale;
+			gl::U16Vec2AttributePtr m_scale;
 			//! Attribut d'opacité.
-			gl::FloatAttributePtr m_alpha;
-			//! Attribut de coordonnées de texture.
-			gl::Vec2AttributePtr m_texture;
-			//! Attribut d'highlight.
-			gl::FloatAttributePtr m_highlight;
+			gl::U16Vec2AttributePtr m_alpha;
+			//! Attribut de coin du quad.
+			gl::I8Vec2AttributePtr m_texture;
 		};
 		//! Un pointeur sur un BillboardNode.
 		using BillboardNodePtr = std::unique_ptr< BillboardNode >;
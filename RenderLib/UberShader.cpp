@@ -191,16 +191,49 @@ void main()
 	vtx_instance = 0.0;
 	vtx_alpha = 1.0;
 }
+)"
+			};
+
+			// Fonctions de décodage des sommets compacts des billboards :
+			// les demi-flottants et les coordonnées octaédriques sont lus
+			// comme des entiers non normalisés.
+			static std::string const BillboardFunctions
+			{
+				R"(float unpackHalf( float value )
+{
+	float signum = 1.0 - 2.0 * step( 32768.0, value );
+	value = mod( value, 32768.0 );
+	float exponent = floor( value / 1024.0 );
+	float mantissa = value - exponent * 1024.0;
+
+	if ( exponent == 0.0 )
+	{
+		return signum * mantissa * exp2( -24.0 );
+	}
+
+	return signum * ( 1.0 + mantissa / 1024.0 ) * exp2( exponent - 15.0 );
+}
+
+vec3 unpackOctahedral( vec2 value )
+{
+	vec2 f = value / 65535.0 * 2.0 - 1.0;
+	vec3 n = vec3( f, 1.0 - abs( f.x ) - abs( f.y ) );
+	float t = max( -n.z, 0.0 );
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize( n );
+}
+
 )"
 			};
 
 			static std::string const BillboardShader
 			{
-				R"([attribute] vec3 position;
+				R"([attribute] vec2 direction;
+[attribute] float radius;
 [attribute] vec2 scale;
-[attribute] float alpha;
+[attribute] vec2 alpha;
 [attribute] vec2 texture;
-[attribute] float highlight;
 
 #ifdef LIGHTING
 [varying] vec3 vtx_normal;
@@ -213,6 +246,9 @@ void main()
 
 void main()
 {
+	vec3 position = unpackOctahedral( direction ) * radius;
+	vec2 size = vec2( unpackHalf( scale.x ), unpackHalf( scale.y ) );
+	vec2 corner = texture * 0.5;
 	vec4 mPosition = mtxModel * vec4( position, 1.0 );
 #ifdef LIGHTING
 	vec3 toCamera = camera - mPosition.xyz;
@@ -224,24 +260,25 @@ void main()
 	vec3 up = -vec3( mtxView[0][1], mtxView[1][1], mtxView[2][1] );
 	float width = dimensions.x;
 	float height = dimensions.y;
-	mPosition.xyz += ( right * texture.x * width * scale.x )
-			+ ( up * texture.y * height * scale.y );
+	mPosition.xyz += ( right * corner.x * width * size.x )
+			+ ( up * corner.y * height * size.y );
 	vec4 mvPosition = mtxView * mPosition;
 	gl_Position = mtxProjection * mvPosition;
 #ifdef TEXTURED
-	vtx_texture = texture + vec2( 0.5, 0.5 );
+	vtx_texture = corner + vec2( 0.5, 0.5 );
 #endif
-	vtx_alpha = alpha * 2.0;
-	vtx_highlight = highlight;
+	vtx_alpha = unpackHalf( alpha.x ) * 2.0;
+	vtx_highlight = unpackHalf( alpha.y );
 }
 )"
 			};
 
 			static std::string const PickingBillboardShader
 			{
-				R"([attribute] vec3 position;
+				R"([attribute] vec2 direction;
+[attribute] float radius;
 [attribute] vec2 scale;
-[attribute] float alpha;
+[attribute] vec2 alpha;
 [attribute] vec2 texture;
 [attribute] float id;
 
@@ -253,20 +290,23 @@ void main()
 
 void main()
 {
+	vec3 position = unpackOctahedral( direction ) * radius;
+	vec2 size = vec2( unpackHalf( scale.x ), unpackHalf( scale.y ) );
+	vec2 corner = texture * 0.5;
 	vec4 mPosition = mtxModel * vec4( position, 1.0 );
 	vec3 right = vec3( mtxView[0][0], mtxView[1][0], mtxView[2][0] );
 	vec3 up = -vec3( mtxView[0][1], mtxView[1][1], mtxView[2][1] );
 	float width = dimensions.x;
 	float height = dimensions.y;
-	mPosition.xyz += ( right * texture.x * width * scale.x )
-			+ ( up * texture.y * height * scale.y );
+	mPosition.xyz += ( right * corner.x * width * size.x )
+			+ ( up * corner.y * height * size.y );
 	vec4 mvPosition = mtxView * mPosition;
 	gl_Position = mtxProjection * mvPosition;
 #ifdef TEXTURED
-	vtx_texture = texture + vec2( 0.5, 0.5 );
+	vtx_texture = corner + vec2( 0.5, 0.5 );
 #endif
 	vtx_instance = float( id );
-	vtx_alpha = alpha;
+	vtx_alpha = unpackHalf( alpha.x );
 }
 )"
 			};
@@ -453,10 +493,12 @@ void main()
 				switch ( render )
 				{
 				case RenderType::eScene:
+					ret += BillboardFunctions;
 					ret += BillboardShader;
 					break;
 
 				case RenderType::ePicking:
+					ret += BillboardFunctions;
 					ret += PickingBillboardShader;
 					break;
 
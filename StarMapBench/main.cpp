@@ -0,0 +1,394 @@
+/**
+*\file
+*	main.cpp
+*\author
+*	Sylvain Doremus
+*\brief
+*	Mesure les temps de lecture d'un catalogue HYG CSV, afin de comparer
+*	les différentes versions des lecteurs.
+*/
+#include <DesktopUtils/MappedFile.h>
+
+#include <RenderLib/StringUtils.h>
+
+#include <StarMapLib/CsvReader.h>
+#include <StarMapLib/Designation.h>
+#include <StarMapLib/SeparatorScanner.h>
+#include <StarMapLib/StarCatalogue.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+	//! Le nombre d'exécutions de chaque mesure, la meilleure étant gardée.
+	static uint32_t constexpr RunCount = 5u;
+	/**
+	*\brief
+	*	Le résultat d'une mesure.
+	*/
+	struct Measure
+	{
+		//! Le meilleur temps, en millisecondes.
+		double time;
+		//! Une valeur calculée par la mesure, pour vérifier que les versions
+		//! comparées font le même travail.
+		size_t check;
+	};
+	/**
+	*\brief
+	*	Exécute une fonction RunCount fois et garde le meilleur temps.
+	*/
+	template< typename FuncT >
+	Measure doMeasure( FuncT function )
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		Measure result{ std::numeric_limits< double >::max(), 0u };
+
+		for ( auto i = 0u; i < RunCount; ++i )
+		{
+			auto begin = Clock::now();
+			result.check = function();
+			auto end = Clock::now();
+			result.time = std::min( result.time
+				, std::chrono::duration< double, std::milli >( end - begin ).count() );
+		}
+
+		return result;
+	}
+
+	void doPrint( std::string const & name
+		, Measure const & measure
+		, Measure const & reference )
+	{
+		std::cout << "  " << std::left << std::setw( 24 ) << name
+			<< std::right << std::setw( 10 ) << std::fixed << std::setprecision( 2 )
+			<< measure.time << " ms"
+			<< std::setw( 8 ) << std::setprecision( 2 )
+			<< reference.time / measure.time << "x"
+			<< "  (" << measure.check << ")" << std::endl;
+	}
+	/**
+	*\brief
+	*	Compte les champs du texte avec SeparatorScanner.
+	*/
+	size_t doScan( std::string const & content
+		, bool vectorised )
+	{
+		starmap::SeparatorScanner scanner{ content.data()
+			, content.data() + content.size()
+			, ','
+			, '\n'
+			, '"'
+			, vectorised };
+		char const * position;
+		size_t result{ 0u };
+		starmap::Separator separator;
+
+		while ( ( separator = scanner.next( position ) ) != starmap::Separator::eEnd )
+		{
+			result += separator == starmap::Separator::eQuote
+				? 0u
+				: 1u;
+		}
+
+		return result;
+	}
+	/**
+	*\brief
+	*	Compare le découpage en lignes puis en champs par render::split, tel
+	*	que le faisait le lecteur CSV, aux versions scalaire et vectorisée de
+	*	SeparatorScanner.
+	*\remarks
+	*	Chaque version compte les séparateurs de champs et
+	*	d'enregistrements rencontrés.
+	*/
+	void doBenchScanners( std::string const & content )
+	{
+		std::cout << "Separators:" << std::endl;
+		auto split = doMeasure( [&content]()
+			{
+				auto lines = render::split( content
+					, "\n"
+					, uint32_t( std::count( content.begin(), content.end(), '\n' ) + 1u )
+					, false );
+				size_t result{ 0u };
+
+				for ( auto & line : lines )
+				{
+					auto fields = render::split( line
+						, ","
+						, uint32_t( std::count( line.begin(), line.end(), ',' ) + 1u )
+						, true );
+					result += fields.size();
+				}
+
+				return result;
+			} );
+		auto scalar = doMeasure( [&content]()
+			{
+				return doScan( content, false );
+			} );
+		auto vectorised = doMeasure( [&content]()
+			{
+				return doScan( content, true );
+			} );
+		doPrint( "render::split", split, split );
+		doPrint( "SeparatorScanner Scalar", scalar, split );
+		doPrint( std::string{ "SeparatorScanner " } + starmap::SeparatorScanner::instructionSet()
+			, vectorised
+			, split );
+	}
+	/**
+	*\brief
+	*	Récupère les valeurs non vides d'une colonne du fichier.
+	*/
+	std::vector< std::string > doReadColumn( std::string const & content
+		, std::string const & name )
+	{
+		std::vector< std::string > result;
+		starmap::SeparatorScanner scanner{ content.data()
+			, content.data() + content.size() };
+		auto begin = content.data();
+		char const * position;
+		uint32_t field{ 0u };
+		uint32_t column{ ~0u };
+		bool header{ true };
+		starmap::Separator separator;
+
+		while ( ( separator = scanner.next( position ) ) != starmap::Separator::eEnd )
+		{
+			if ( separator == starmap::Separator::eQuote )
+			{
+				continue;
+			}
+
+			std::string value{ begin, position };
+
+			if ( header && value == name )
+			{
+				column = field;
+			}
+			else if ( !header && field == column && !value.empty() )
+			{
+				result.push_back( value );
+			}
+
+			++field;
+			begin = position + 1;
+
+			if ( separator == starmap::Separator::eRecord )
+			{
+				header = false;
+				field = 0u;
+			}
+		}
+
+		return result;
+	}
+
+	int doParseInt( std::string const & text )
+	{
+		std::stringstream stream{ text };
+		int result{ 0 };
+		stream >> result;
+		return result;
+	}
+	/**
+	*\brief
+	*	L'analyse d'une colonne "bf" remplacée par parseFlamsteedBayer.
+	*/
+	bool doExtractFromBFRegex( std::string bf
+		, starmap::Designation & designation
+		, std::string & letter )
+	{
+		std::regex regexLetter{ R"((\d*)[^a-zA-Z]*([a-zA-Z]*)(\d*).*)" };
+		bf = bf.substr( 0u, bf.size() - 3u );
+		std::sregex_iterator it( bf.begin(), bf.end(), regexLetter );
+
+		if ( it != std::sregex_iterator{} )
+		{
+			std::smatch match = *it;
+			letter = match[2].str();
+			auto sid = match[1].str();
+			auto sindex = match[3].str();
+
+			if ( !sid.empty()
+				|| !letter.empty()
+				|| !sindex.empty() )
+			{
+				designation.flamsteed = uint32_t( doParseInt( sid ) );
+				designation.index = uint32_t( doParseInt( sindex ) );
+				return true;
+			}
+		}
+
+		return false;
+	}
+	/**
+	*\brief
+	*	L'analyse d'une colonne "bayer" remplacée par parseBayer.
+	*/
+	bool doExtractFromBayerRegex( std::string const & bayer
+		, starmap::Designation & designation
+		, std::string & letter )
+	{
+		std::regex regexLetter{ R"(([a-zA-Z]*)-?(\d*))" };
+		std::sregex_iterator it( bayer.begin(), bayer.end(), regexLetter );
+
+		if ( it != std::sregex_iterator{} )
+		{
+			std::smatch match = *it;
+			letter = match[1].str();
+			auto sindex = match[2].str();
+
+			if ( !letter.empty()
+				|| !sindex.empty() )
+			{
+				designation.index = uint32_t( doParseInt( sindex ) );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	size_t doSum( starmap::Designation const & designation
+		, size_t letter )
+	{
+		return designation.flamsteed
+			+ designation.index * 1000u
+			+ letter * 100000u;
+	}
+	/**
+	*\brief
+	*	Compare l'analyse des colonnes "bf" et "bayer" du fichier par les
+	*	expressions régulières construites à chaque étoile, telles que les
+	*	utilisait le lecteur XML, à parseFlamsteedBayer et parseBayer.
+	*/
+	void doBenchDesignations( std::string const & content )
+	{
+		auto bfs = doReadColumn( content, "bf" );
+		auto bayers = doReadColumn( content, "bayer" );
+		std::cout << "Designations (" << bfs.size() << " bf, "
+			<< bayers.size() << " bayer):" << std::endl;
+		auto regex = doMeasure( [&bfs, &bayers]()
+			{
+				size_t result{ 0u };
+				std::string letter;
+
+				for ( auto & bf : bfs )
+				{
+					starmap::Designation designation;
+
+					if ( doExtractFromBFRegex( bf, designation, letter ) )
+					{
+						result += doSum( designation, letter.size() );
+					}
+				}
+
+				for ( auto & bayer : bayers )
+				{
+					starmap::Designation designation;
+
+					if ( doExtractFromBayerRegex( bayer, designation, letter ) )
+					{
+						result += doSum( designation, letter.size() );
+					}
+				}
+
+				return result;
+			} );
+		auto parser = doMeasure( [&bfs, &bayers]()
+			{
+				size_t result{ 0u };
+
+				for ( auto & bf : bfs )
+				{
+					starmap::Designation designation;
+
+					if ( starmap::parseFlamsteedBayer( bf, designation ) )
+					{
+						result += doSum( designation, designation.letter.size() );
+					}
+				}
+
+				for ( auto & bayer : bayers )
+				{
+					starmap::Designation designation;
+
+					if ( starmap::parseBayer( bayer, designation ) )
+					{
+						result += doSum( designation, designation.letter.size() );
+					}
+				}
+
+				return result;
+			} );
+		doPrint( "std::regex", regex, regex );
+		doPrint( "parseFlamsteedBayer", parser, regex );
+	}
+	/**
+	*\brief
+	*	Compare le chargement des étoiles du fichier sur un thread, puis sur
+	*	tous les coeurs disponibles.
+	*/
+	void doBenchCsvLoad( starmap::StringView const & content )
+	{
+		auto threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+		std::cout << "CSV load (" << threadCount << " threads):" << std::endl;
+		auto load = [&content]( uint32_t count )
+		{
+			starmap::StarCatalogue catalogue;
+			starmap::loadStarsFromCsv( catalogue, content, count );
+			return catalogue.stars().size();
+		};
+		auto serial = doMeasure( [&load]()
+			{
+				return load( 1u );
+			} );
+		auto parallel = doMeasure( [&load, threadCount]()
+			{
+				return load( threadCount );
+			} );
+		doPrint( "Serial", serial, serial );
+		doPrint( "Parallel", parallel, serial );
+	}
+}
+
+int main( int argc, char * argv[] )
+{
+	if ( argc != 2 )
+	{
+		std::cerr << "Usage: " << argv[0] << " <hygdata.csv>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	utils::MappedFile file{ argv[1] };
+
+	if ( !file.valid() )
+	{
+		return EXIT_FAILURE;
+	}
+
+	// Le texte est copié sans ses '\r', comme le faisait le lecteur CSV
+	// avant de le découper.
+	std::string content;
+	content.reserve( file.size() );
+	std::copy_if( file.begin()
+		, file.end()
+		, std::back_inserter( content )
+		, []( char c )
+		{
+			return c != '\r';
+		} );
+	std::cout << "[" << argv[1] << "]: " << content.size() << " bytes." << std::endl;
+	doBenchScanners( content );
+	doBenchDesignations( content );
+	doBenchCsvLoad( { file.begin(), file.end() } );
+	return EXIT_SUCCESS;
+}
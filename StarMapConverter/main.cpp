@@ -0,0 +1,187 @@
+/**
+*\file
+*	main.cpp
+*\author
+*	Sylvain Doremus
+*\brief
+*	Convertit un catalogue HYG, CSV ou XML, en catalogue binaire .smc, ou
+*	en catalogue par tuiles .smt.
+*/
+#include <DesktopUtils/MappedFile.h>
+
+#include <StarMapLib/CsvReader.h>
+#include <StarMapLib/SkyTiling.h>
+#include <StarMapLib/SmcWriter.h>
+#include <StarMapLib/SmtWriter.h>
+#include <StarMapLib/StarCatalogue.h>
+#include <StarMapLib/XmlReader.h>
+
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+	bool doEndsWith( std::string const & value
+		, std::string const & suffix )
+	{
+		return value.size() >= suffix.size()
+			&& std::equal( suffix.rbegin(), suffix.rend(), value.rbegin() );
+	}
+
+	bool doLoadStars( starmap::StarCatalogue & catalogue
+		, std::string const & fileName )
+	{
+		utils::MappedFile file{ fileName };
+
+		if ( !file.valid() )
+		{
+			return false;
+		}
+
+		if ( doEndsWith( fileName, ".csv" ) )
+		{
+			starmap::loadStarsFromCsv( catalogue
+				, { file.begin(), file.end() }
+				, std::max( 1u, std::thread::hardware_concurrency() ) );
+		}
+		else
+		{
+			starmap::loadStarsFromXml( catalogue
+				, { file.begin(), file.end() } );
+		}
+
+		return true;
+	}
+
+	bool doMergeStars( starmap::StarCatalogue & catalogue
+		, std::string const & fileName )
+	{
+		utils::MappedFile file{ fileName };
+
+		if ( !file.valid() )
+		{
+			return false;
+		}
+
+		auto statistics = starmap::mergeStarsFromCsv( catalogue
+			, { file.begin(), file.end() }
+			, starmap::MergeMode::eUpdate
+			, std::max( 1u, std::thread::hardware_concurrency() ) );
+		std::cout << "[" << fileName << "]: " << statistics << std::endl;
+		return true;
+	}
+
+	bool doLoadConstellations( starmap::StarCatalogue & catalogue
+		, std::string const & fileName )
+	{
+		utils::MappedFile file{ fileName };
+
+		if ( !file.valid() )
+		{
+			return false;
+		}
+
+		starmap::loadConstellationsFromXml( catalogue
+			, { file.begin(), file.end() } );
+		return true;
+	}
+}
+
+int main( int argc, char * argv[] )
+{
+	// Les catalogues supplémentaires, précédés de --merge, sont fusionnés
+	// dans l'ordre avec le catalogue principal.
+	std::vector< std::string > arguments;
+	std::vector< std::string > supplements;
+	uint32_t level{ 6u };
+
+	for ( int i = 1; i < argc; ++i )
+	{
+		std::string argument{ argv[i] };
+
+		if ( argument == "--merge" && i + 1 < argc )
+		{
+			supplements.emplace_back( argv[++i] );
+		}
+		else if ( argument == "--level" && i + 1 < argc )
+		{
+			level = uint32_t( std::stoul( argv[++i] ) );
+		}
+		else
+		{
+			arguments.push_back( argument );
+		}
+	}
+
+	if ( arguments.size() < 2u || arguments.size() > 3u
+		|| level >= starmap::MaxTileLevel )
+	{
+		std::cerr << "Usage: " << argv[0] << " <stars.csv|stars.xml> [--merge <supplement.csv>]... [constellations.xml] <output.smc>" << std::endl;
+		std::cerr << "       " << argv[0] << " <stars.csv|stars.xml> [--merge <supplement.csv>]... [--level <0-15>] <output.smt>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	starmap::StarCatalogue catalogue;
+
+	if ( !doLoadStars( catalogue, arguments.front() ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	for ( auto & supplement : supplements )
+	{
+		if ( !doMergeStars( catalogue, supplement ) )
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Le tri attribue leur index aux étoiles, qui sont écrites dans cet
+	// ordre.
+	catalogue.sort();
+
+	if ( arguments.size() == 3u
+		&& !doLoadConstellations( catalogue, arguments[1] ) )
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::string output{ arguments.back() };
+
+	if ( doEndsWith( output, ".smt" ) )
+	{
+		// Le catalogue par tuiles est écrit directement dans le fichier,
+		// sans les constellations.
+		std::ofstream file{ output, std::ios::binary };
+		starmap::saveCatalogueToSmt( catalogue, level, file );
+
+		if ( !file )
+		{
+			std::cerr << "Couldn't write file [" << output << "]." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << "Wrote " << catalogue.stars().size() << " stars in "
+			<< starmap::tileCount( level ) << " tiles to ["
+			<< output << "]." << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	render::ByteArray content;
+	starmap::saveCatalogueToSmc( catalogue, content );
+	std::ofstream file{ output, std::ios::binary };
+
+	if ( !file )
+	{
+		std::cerr << "Couldn't open file [" << output << "]." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	file.write( reinterpret_cast< char const * >( content.data() )
+		, std::streamsize( content.size() ) );
+	std::cout << "Wrote " << catalogue.stars().size() << " stars and "
+		<< catalogue.constellations().size() << " constellations to ["
+		<< output << "]." << std::endl;
+	return EXIT_SUCCESS;
+}
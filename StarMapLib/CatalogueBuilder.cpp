@@ -0,0 +1,107 @@
+#include "CatalogueBuilder.h"
+
+namespace starmap
+{
+	void CatalogueBuilder::reserve( size_t stars
+		, size_t constellations )
+	{
+		m_catalogue.stars().reserve( stars );
+		m_constellations.reserve( constellations );
+		m_names.reserve( constellations );
+	}
+
+	void CatalogueBuilder::add( Star const & star )
+	{
+		m_catalogue.add( star );
+	}
+
+	void CatalogueBuilder::add( StarArray && stars )
+	{
+		m_catalogue.add( std::move( stars ) );
+	}
+
+	void CatalogueBuilder::add( StarArray && stars
+		, StarIdentifierArray && identifiers
+		, StarMotionArray && motions )
+	{
+		m_catalogue.add( std::move( stars )
+			, std::move( identifiers )
+			, std::move( motions ) );
+	}
+
+	void CatalogueBuilder::add( Constellation const & constellation )
+	{
+		auto & pending = doFindConstellation( constellation.name() );
+
+		for ( auto & star : constellation.stars() )
+		{
+			pending.constellation->addStar( star.id()
+				, star.letter()
+				, star.name() );
+		}
+
+		for ( auto & link : constellation.links() )
+		{
+			pending.links.emplace_back( link.m_a->letter()
+				, link.m_b->letter() );
+		}
+	}
+
+	void CatalogueBuilder::addConstellationStar( std::string const & constellation
+		, uint32_t id
+		, std::string const & letter
+		, StringView const & name )
+	{
+		doFindConstellation( constellation ).constellation->addStar( id
+			, letter
+			, name );
+	}
+
+	void CatalogueBuilder::addConstellationLink( std::string const & constellation
+		, std::string const & a
+		, std::string const & b )
+	{
+		doFindConstellation( constellation ).links.emplace_back( a, b );
+	}
+
+	StarCatalogue CatalogueBuilder::finalise()
+	{
+		// Toutes les étoiles sont connues : elles ne sont triées qu'une
+		// fois, avant que les constellations ne les référencent.
+		m_catalogue.sort();
+
+		for ( auto & pending : m_constellations )
+		{
+			auto & constellation = *pending.constellation;
+			constellation.fill( m_catalogue );
+
+			// Les liens référencent les étoiles de la constellation, ils ne
+			// sont créés qu'une fois celles-ci toutes ajoutées.
+			for ( auto & link : pending.links )
+			{
+				constellation.addLink( link.first, link.second );
+			}
+
+			m_catalogue.add( std::move( pending.constellation ) );
+		}
+
+		m_constellations.clear();
+		m_names.clear();
+		m_catalogue.finalise();
+		auto result = std::move( m_catalogue );
+		m_catalogue = StarCatalogue{};
+		return result;
+	}
+
+	CatalogueBuilder::PendingConstellation & CatalogueBuilder::doFindConstellation( std::string const & name )
+	{
+		auto it = m_names.emplace( name, m_constellations.size() );
+
+		if ( it.second )
+		{
+			m_constellations.push_back( { std::make_unique< Constellation >( name ), {} } );
+		}
+
+		return m_constellations[it.first->second];
+	}
+}
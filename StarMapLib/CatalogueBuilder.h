@@ -0,0 +1,168 @@
+/**
+*\file
+*	CatalogueBuilder.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_CatalogueBuilder_HPP___
+#define ___StarMapLib_CatalogueBuilder_HPP___
+#pragma once
+
+#include "StarCatalogue.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Construit un catalogue en une fois.
+	*\remarks
+	*	Les étoiles et les constellations (leurs étoiles et leurs liens)
+	*	peuvent être ajoutées dans n'importe quel ordre : rien n'est trié ni
+	*	résolu avant finalise(), qui trie les étoiles, leur attribue leur
+	*	index, résout les étoiles et les liens des constellations, puis
+	*	construit tous les index du catalogue.\n
+	*	Ne dépend d'aucune ressource GPU, il peut donc être utilisé sur un
+	*	thread de travail.
+	*/
+	class CatalogueBuilder
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*/
+		CatalogueBuilder() = default;
+		CatalogueBuilder( CatalogueBuilder const & ) = delete;
+		CatalogueBuilder & operator=( CatalogueBuilder const & ) = delete;
+		CatalogueBuilder( CatalogueBuilder && ) = default;
+		CatalogueBuilder & operator=( CatalogueBuilder && ) = default;
+		/**
+		*\brief
+		*	Réserve la place pour les éléments à venir.
+		*\param[in] stars
+		*	Le nombre d'étoiles attendu.
+		*\param[in] constellations
+		*	Le nombre de constellations attendu.
+		*/
+		void reserve( size_t stars
+			, size_t constellations = 0u );
+		/**
+		*\brief
+		*	Ajoute une étoile.
+		*\param[in] star
+		*	L'étoile.
+		*/
+		void add( Star const & star );
+		/**
+		*\brief
+		*	Ajoute une liste d'étoiles, en une fois.
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*/
+		void add( StarArray && stars );
+		/**
+		*\brief
+		*	Ajoute une liste d'étoiles, en une fois, avec leurs identifiants
+		*	et leurs mouvements propres (voir StarCatalogue::add).
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*\param[in] identifiers
+		*	Les identifiants, un par étoile ou aucun, dont le contenu est
+		*	déplacé.
+		*\param[in] motions
+		*	Les mouvements propres, un par étoile ou aucun, dont le contenu
+		*	est déplacé.
+		*/
+		void add( StarArray && stars
+			, StarIdentifierArray && identifiers
+			, StarMotionArray && motions );
+		/**
+		*\brief
+		*	Ajoute les étoiles et les liens d'une constellation.
+		*\remarks
+		*	Les étoiles sont reprises par leur nom, les liens par les lettres
+		*	de leurs étoiles : la constellation donnée n'a pas à être
+		*	finalisée.
+		*\param[in] constellation
+		*	La constellation.
+		*/
+		void add( Constellation const & constellation );
+		/**
+		*\brief
+		*	Ajoute une étoile à une constellation, créée si besoin.
+		*\param[in] constellation
+		*	Le nom de la constellation.
+		*\param[in] id
+		*	L'ID de l'étoile dans la constellation.
+		*\param[in] letter
+		*	La lettre associée à l'étoile, dans la constellation.
+		*\param[in] name
+		*	Le nom de l'étoile, qui peut n'être ajoutée que plus tard.
+		*/
+		void addConstellationStar( std::string const & constellation
+			, uint32_t id
+			, std::string const & letter
+			, StringView const & name );
+		/**
+		*\brief
+		*	Ajoute un lien entre 2 étoiles d'une constellation, créée si
+		*	besoin.
+		*\param[in] constellation
+		*	Le nom de la constellation.
+		*\param[in] a, b
+		*	Les lettres des 2 étoiles, qui peuvent n'être ajoutées que plus
+		*	tard.
+		*/
+		void addConstellationLink( std::string const & constellation
+			, std::string const & a
+			, std::string const & b );
+		/**
+		*\brief
+		*	Finalise le catalogue, en une passe : tri des étoiles,
+		*	attribution de leur index, résolution des constellations, puis
+		*	construction des index.
+		*\remarks
+		*	Le constructeur est vide en retour.
+		*\return
+		*	Le catalogue.
+		*/
+		StarCatalogue finalise();
+		/**
+		*\remarks
+		*	Les noms des étoiles ajoutées y sont copiés, sauf s'ils en
+		*	proviennent déjà.
+		*\return
+		*	La réserve des noms des étoiles.
+		*/
+		inline NamePool & namePool()noexcept
+		{
+			return m_catalogue.namePool();
+		}
+
+	private:
+		/**
+		*\brief
+		*	Une constellation en attente de la finalisation.
+		*/
+		struct PendingConstellation
+		{
+			//! La constellation, dont les étoiles ne sont pas résolues.
+			ConstellationPtr constellation;
+			//! Les liens, par lettres des étoiles.
+			std::vector< std::pair< std::string, std::string > > links;
+		};
+
+	private:
+		PendingConstellation & doFindConstellation( std::string const & name );
+
+	private:
+		//! Le catalogue, dont les étoiles ne sont pas triées.
+		StarCatalogue m_catalogue;
+		//! Les constellations, dans leur ordre d'ajout.
+		std::vector< PendingConstellation > m_constellations;
+		//! L'index des constellations, par nom.
+		std::unordered_map< std::string, size_t > m_names;
+	};
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "CatalogueLoader.h"
+
+#include <chrono>
+
+namespace starmap
+{
+	CatalogueLoader::~CatalogueLoader()
+	{
+		cancel();
+
+		if ( m_worker.valid() )
+		{
+			m_worker.wait();
+		}
+	}
+
+	void CatalogueLoader::addStep( Step step )
+	{
+		assert( !m_worker.valid() );
+		m_steps.push_back( std::move( step ) );
+	}
+
+	void CatalogueLoader::start()
+	{
+		assert( !m_worker.valid() );
+		m_worker = std::async( std::launch::async
+			, [this]()
+			{
+				doLoad();
+			} );
+	}
+
+	void CatalogueLoader::cancel()
+	{
+		m_read.cancelled = true;
+	}
+
+	bool CatalogueLoader::ready()const
+	{
+		return m_worker.valid()
+			&& m_worker.wait_for( std::chrono::seconds{ 0 } ) == std::future_status::ready;
+	}
+
+	StarCatalogue CatalogueLoader::take()
+	{
+		assert( ready() );
+		m_worker.get();
+
+		if ( m_read.cancelled )
+		{
+			return StarCatalogue{};
+		}
+
+		return std::move( m_catalogue );
+	}
+
+	float CatalogueLoader::progress()const
+	{
+		if ( m_steps.empty() )
+		{
+			return 1.0f;
+		}
+
+		float done = float( m_done );
+		size_t total = m_read.total;
+
+		if ( total )
+		{
+			done += std::min( 1.0f, float( m_read.done ) / float( total ) );
+		}
+
+		return std::min( 1.0f, done / float( m_steps.size() + 1u ) );
+	}
+
+	void CatalogueLoader::doLoad()
+	{
+		ReadMonitor monitor{ m_read };
+
+		for ( auto & step : m_steps )
+		{
+			if ( m_read.cancelled )
+			{
+				return;
+			}
+
+			step( m_catalogue, monitor );
+			m_read.total = 0u;
+			++m_done;
+		}
+
+		if ( !m_read.cancelled )
+		{
+			m_catalogue.finalise();
+			++m_done;
+		}
+	}
+}
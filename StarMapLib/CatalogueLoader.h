@@ -0,0 +1,123 @@
+/**
+*\file
+*	CatalogueLoader.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_CatalogueLoader_HPP___
+#define ___StarMapLib_CatalogueLoader_HPP___
+#pragma once
+
+#include "ReadMonitor.h"
+#include "StarCatalogue.h"
+
+#include <atomic>
+#include <future>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Charge un catalogue sur un thread de travail.
+	*\remarks
+	*	Les étapes (lecture des étoiles, puis des constellations, ...) sont
+	*	exécutées dans l'ordre sur le thread de travail, puis le catalogue
+	*	est finalisé (tri des étoiles, index de recherche). Le catalogue est
+	*	ensuite récupéré par le thread de rendu, via take().\n
+	*	Chaque étape reçoit un ReadMonitor, à transmettre aux lecteurs :
+	*	ceux-ci y signalent leur avancement, et s'interrompent dès que le
+	*	chargement est annulé. Le destructeur annule le chargement et attend
+	*	la fin de l'étape en cours.
+	*/
+	class CatalogueLoader
+	{
+	public:
+		/**
+		*\brief
+		*	Une étape du chargement, exécutée sur le thread de travail.
+		*/
+		using Step = std::function< void( StarCatalogue &, ReadMonitor const & ) >;
+
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*/
+		CatalogueLoader() = default;
+		CatalogueLoader( CatalogueLoader const & ) = delete;
+		CatalogueLoader & operator=( CatalogueLoader const & ) = delete;
+		/**
+		*\brief
+		*	Destructeur, annule le chargement en cours.
+		*/
+		~CatalogueLoader();
+		/**
+		*\brief
+		*	Ajoute une étape au chargement.
+		*\remarks
+		*	Doit être appelé avant start().
+		*\param[in] step
+		*	L'étape.
+		*/
+		void addStep( Step step );
+		/**
+		*\brief
+		*	Démarre le chargement sur le thread de travail.
+		*/
+		void start();
+		/**
+		*\brief
+		*	Demande l'annulation du chargement.
+		*/
+		void cancel();
+		/**
+		*\return
+		*	\p true si le thread de travail a terminé, le catalogue peut
+		*	alors être récupéré.
+		*/
+		bool ready()const;
+		/**
+		*\brief
+		*	Récupère le catalogue chargé.
+		*\remarks
+		*	Ne doit être appelé que lorsque ready() retourne \p true.
+		*	Les exceptions levées par les étapes sont relancées ici.
+		*\return
+		*	Le catalogue, trié, vide si le chargement a été annulé.
+		*/
+		StarCatalogue take();
+		/**
+		*\return
+		*	L'avancement du chargement, de 0 à 1, chaque étape (et la
+		*	finalisation) en représentant une part égale.
+		*/
+		float progress()const;
+		/**
+		*\return
+		*	\p true si le chargement a été annulé.
+		*/
+		inline bool cancelled()const
+		{
+			return m_read.cancelled;
+		}
+
+	private:
+		void doLoad();
+
+	private:
+		//! Les étapes du chargement.
+		std::vector< Step > m_steps;
+		//! Le catalogue en cours de chargement.
+		StarCatalogue m_catalogue;
+		//! Le nombre d'étapes terminées, le tri compris.
+		std::atomic< uint32_t > m_done{ 0u };
+		//! L'avancement de l'étape en cours, et l'annulation.
+		ReadMonitor::State m_read;
+		//! Le résultat du thread de travail.
+		std::future< void > m_worker;
+	};
+	//! Un pointeur sur un CatalogueLoader.
+	using CatalogueLoaderPtr = std::unique_ptr< CatalogueLoader >;
+}
+
+#endif
@@ -0,0 +1,108 @@
+/**
+*\file
+*	CatalogueMerge.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_CatalogueMerge_HPP___
+#define ___StarMapLib_CatalogueMerge_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+#include <RenderLib/FlagCombination.h>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les identifiants d'une étoile dans les catalogues de référence,
+	*	utilisés pour joindre plusieurs catalogues.
+	*/
+	struct StarIdentifiers
+	{
+		//! L'ID de l'étoile dans le catalogue Hipparcos, 0 s'il n'y en a pas.
+		uint32_t hip{ 0u };
+		//! L'ID de l'étoile dans le catalogue Henry Draper, 0 s'il n'y en a pas.
+		uint32_t hd{ 0u };
+		//! Le hash de l'ID de l'étoile dans le Gliese Catalog of Nearby
+		//! Stars, 0 s'il n'y en a pas.
+		size_t gl{ 0u };
+	};
+	//! Un tableau d'identifiants d'étoiles.
+	using StarIdentifierArray = std::vector< StarIdentifiers >;
+	/**
+	*\brief
+	*	Les attributs d'une étoile renseignés par une ligne de catalogue.
+	*/
+	enum class StarField
+		: uint8_t
+	{
+		//! Aucun attribut.
+		eNone = 0x00,
+		//! Le nom propre.
+		eName = 0x01,
+		//! La magnitude.
+		eMagnitude = 0x02,
+		//! La position.
+		ePosition = 0x04,
+		//! La couleur.
+		eColour = 0x08,
+		//! Le mouvement propre.
+		eMotion = 0x10,
+		//! Tous les attributs.
+		eAll = 0x1F,
+	};
+	RenderLib_ImplementFlag( StarField )
+	/**
+	*\brief
+	*	La manière dont les étoiles d'un catalogue sont fusionnées avec
+	*	celles déjà présentes.
+	*/
+	enum class MergeMode
+		: uint8_t
+	{
+		//! Les étoiles sont ajoutées, sans jointure.
+		eAppend,
+		//! Les étoiles ayant un identifiant en commun avec une étoile
+		//! présente mettent à jour celle-ci, les autres sont ajoutées.
+		eUpdate,
+		//! Les étoiles ayant un identifiant en commun avec une étoile
+		//! présente mettent à jour celle-ci, les autres sont ignorées.
+		eUpdateExisting,
+	};
+	/**
+	*\brief
+	*	Le bilan d'une fusion.
+	*/
+	struct MergeStatistics
+	{
+		//! Le nombre d'étoiles fusionnées.
+		size_t rows{ 0u };
+		//! Le nombre d'étoiles ayant mis à jour une étoile présente.
+		size_t matched{ 0u };
+		//! Parmi celles-ci, le nombre d'étoiles ayant mis à jour une étoile
+		//! déjà mise à jour lors de la même fusion.
+		size_t duplicates{ 0u };
+		//! Le nombre d'étoiles ajoutées.
+		size_t added{ 0u };
+		//! Le nombre d'étoiles ignorées, faute de correspondance.
+		size_t ignored{ 0u };
+	};
+	/**
+	*\brief
+	*	Affiche le bilan d'une fusion dans un flux.
+	*/
+	inline std::ostream & operator<<( std::ostream & stream
+		, MergeStatistics const & statistics )
+	{
+		stream << statistics.rows << " stars merged: "
+			<< statistics.matched << " matched ("
+			<< statistics.duplicates << " duplicates), "
+			<< statistics.added << " added, "
+			<< statistics.ignored << " ignored";
+		return stream;
+	}
+}
+
+#endif
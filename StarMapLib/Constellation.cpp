@@ -1,6 +1,7 @@
 #include "Constellation.h"
 
 #include "ConstellationStar.h"
+#include "StarCatalogue.h"
 
 namespace starmap
 {
@@ -11,29 +12,41 @@ namespace starmap
 
 	void Constellation::addStar( uint32_t id
 		, std::string const & letter
-		, std::string const & name )
+		, StringView const & name )
 	{
+		m_names.emplace( hash( name ), uint32_t( m_stars.size() ) );
 		m_stars.emplace_back( id, letter, name, *this );
 	}
 
-	void Constellation::fill( StarArray const & stars )
+	void Constellation::addStar( uint32_t id
+		, std::string const & letter
+		, Star const & star
+		, uint32_t index
+		, StringView const & name )
+	{
+		m_names.emplace( hash( name ), uint32_t( m_stars.size() ) );
+		m_stars.emplace_back( id, letter, StringView{}, *this );
+		m_stars.back().fill( star, index, name );
+		auto count = float( m_stars.size() );
+		m_position = ( m_position * ( count - 1.0f ) + star.position() ) / count;
+		doUpdateCap();
+	}
+
+	void Constellation::fill( StarCatalogue & catalogue )
 	{
 		gl::Vec3 position;
 		uint32_t count{ 0u };
 
 		for ( auto & star : m_stars )
 		{
-			auto it = std::find_if( std::begin( stars )
-				, std::end( stars )
-				, [&star]( Star const & mapStar )
-				{
-					return star.name() == mapStar.name();
-				} );
-
-			if ( it != stars.end() )
+			auto found = catalogue.findStar( star.name() );
+
+			if ( found )
 			{
-				position += it->position();
-				star.fill( *it );
+				position += found->position();
+				star.fill( *found
+					, uint32_t( found - catalogue.stars().data() )
+					, catalogue.name( *found ) );
 				++count;
 			}
 			else
@@ -43,21 +56,60 @@ namespace starmap
 		}
 
 		m_position = position / count;
+		doUpdateCap();
 	}
 
-	ConstellationStar const * Constellation::findStar( std::string const & name )const
+	void Constellation::updatePosition()
 	{
-		ConstellationStar const * result = nullptr;
-		auto it = std::find_if( std::begin( m_stars )
-			, std::end( m_stars )
-			, [&name]( ConstellationStar const & star )
+		gl::Vec3 position;
+		uint32_t count{ 0u };
+
+		for ( auto & star : m_stars )
+		{
+			if ( star.filled() )
 			{
-				return star.name() == name;
-			} );
+				position += star.star().position();
+				++count;
+			}
+		}
+
+		if ( count )
+		{
+			m_position = position / count;
+			doUpdateCap();
+		}
+	}
+
+	void Constellation::remap( StarArray const & stars
+		, std::vector< uint32_t > const & indices )
+	{
+		// Les étoiles ont pu être déplacées par les ajouts précédant le tri,
+		// elles sont donc retrouvées par leur index, pas par leur adresse.
+		for ( auto & star : m_stars )
+		{
+			if ( star.filled() )
+			{
+				assert( star.index() < indices.size() );
+				auto index = indices[star.index()];
+				star.fill( stars[index], index, star.name() );
+			}
+		}
+	}
+
+	ConstellationStar const * Constellation::findStar( StringView const & name )const
+	{
+		ConstellationStar const * result = nullptr;
+		auto range = m_names.equal_range( hash( name ) );
 
-		if ( it != std::end( m_stars ) )
+		for ( auto it = range.first; it != range.second; ++it )
 		{
-			result = &( *it );
+			auto star = &m_stars[it->second];
+
+			if ( star->name() == name
+				&& ( !result || star < result ) )
+			{
+				result = star;
+			}
 		}
 
 		return result;
@@ -104,6 +156,31 @@ namespace starmap
 		}
 	}
 
+	void Constellation::doUpdateCap()
+	{
+		auto length = gl::length( m_position );
+
+		// Sans étoile trouvée, la calotte couvre toute la sphère (rayon
+		// supérieur à pi).
+		if ( !( length > 0.0f ) )
+		{
+			m_cap = SkyCap{ gl::Vec3{ 0, 0, 1 }, 4.0f };
+			return;
+		}
+
+		m_cap.centre = m_position / length;
+		m_cap.radius = 0.0f;
+
+		for ( auto & star : m_stars )
+		{
+			if ( star.filled() )
+			{
+				m_cap.radius = std::max( m_cap.radius
+					, angle( m_cap.centre, gl::normalize( star.star().position() ) ) );
+			}
+		}
+	}
+
 	void Constellation::addLink( uint32_t a, uint32_t b )
 	{
 		auto ita = std::find_if( std::begin( m_stars )
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "ConstellationStar.h"
+#include "SkyTiling.h"
 
 namespace starmap
 {
@@ -51,23 +52,72 @@ namespace starmap
 		*/
 		void addStar( uint32_t id
 			, std::string const & letter
-			, std::string const & name );
+			, StringView const & name );
 		/**
 		*\brief
 		*	Cherche une étoile dans la constellation.
+		*\remarks
+		*	La recherche utilise l'index des noms de la constellation.
 		*\param[in] name
 		*	Le nom de l'étoile.
 		*\return
 		*	L'étoile trouvée, \p nullptr si non trouvée
 		*/
-		ConstellationStar const * findStar( std::string const & name )const;
+		ConstellationStar const * findStar( StringView const & name )const;
 		/**
 		*\brief
-		*	Remplit les étoiles de cette constellation depuis celles données.
+		*	Ajoute une étoile déjà connue à la constellation, sans recherche
+		*	par nom.
+		*\remarks
+		*	La position de la constellation est mise à jour. A n'utiliser que
+		*	lorsque toutes les étoiles de la constellation sont ajoutées
+		*	ainsi.
+		*\param[in] id
+		*	L'ID de l'étoile dans la constellation.
+		*\param[in] letter
+		*	La lettre associée à l'étoile, dans la constellation.
+		*\param[in] star
+		*	L'étoile de la carte du ciel.
+		*\param[in] index
+		*	L'index de l'étoile dans le catalogue.
+		*\param[in] name
+		*	Le nom de l'étoile, dans la réserve de noms de son catalogue.
+		*/
+		void addStar( uint32_t id
+			, std::string const & letter
+			, Star const & star
+			, uint32_t index
+			, StringView const & name );
+		/**
+		*\brief
+		*	Remplit les étoiles de cette constellation depuis celles du
+		*	catalogue donné.
+		*\remarks
+		*	Chaque étoile est recherchée via l'index des noms du catalogue.
+		*	La position et la calotte englobante de la constellation sont
+		*	calculées depuis les étoiles trouvées.
+		*\param[in] catalogue
+		*	Le catalogue de la carte du ciel.
+		*/
+		void fill( StarCatalogue & catalogue );
+		/**
+		*\brief
+		*	Recalcule la position et la calotte englobante de la
+		*	constellation, depuis celles de ses étoiles, après leur
+		*	déplacement.
+		*/
+		void updatePosition();
+		/**
+		*\brief
+		*	Met à jour les étoiles de cette constellation, après un nouveau
+		*	tri des étoiles du catalogue.
 		*\param[in] stars
-		*	Les étoiles de la carte du ciel.
+		*	Les étoiles du catalogue, triées à nouveau.
+		*\param[in] indices
+		*	Le nouvel index de chaque étoile, par index d'avant le tri.
 		*/
-		void fill( StarArray const & stars );
+		void remap( StarArray const & stars
+			, std::vector< uint32_t > const & indices );
 		/**
 		*\brief
 		*	Ajoute un lien entre 2 étoiles appartenant à la constellation.
@@ -125,16 +175,37 @@ namespace starmap
 		{
 			return m_position;
 		};
+		/**
+		*\return
+		*	La calotte englobant les étoiles de la constellation, et donc ses
+		*	liens.
+		*/
+		inline SkyCap const & cap()const noexcept
+		{
+			return m_cap;
+		}
+
+	private:
+		/**
+		*\brief
+		*	Recalcule la calotte englobante, centrée sur la direction de la
+		*	position de la constellation.
+		*/
+		void doUpdateCap();
 
 	private:
 		//! Le nom de la constellation.
 		std::string m_name;
 		//! Les étoiles composant la constellation.
 		ConstellationStarArray m_stars;
+		//! L'index des étoiles composant la constellation, par hash de leur nom.
+		std::unordered_multimap< size_t, uint32_t > m_names;
 		//! Les liens entre les étoiles, formant la constellation.
 		LinkArray m_links;
 		//! La position de la constellation, fonction des étoiles qui la composent.
 		gl::Vec3 m_position;
+		//! La calotte englobant les étoiles de la constellation.
+		SkyCap m_cap{ gl::Vec3{ 0, 0, 1 }, 0.0f };
 	};
 }
 
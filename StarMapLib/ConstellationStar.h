@@ -27,32 +27,43 @@ namespace starmap
 		*\param[in] letter
 		*	La lettre associée à l'étoile, dans la constellation.
 		*\param[in] name
-		*	Le nom de l'étoile.
+		*	Le nom de l'étoile, copié jusqu'à ce que l'étoile soit définie.
 		*\param[in] constellation
 		*	La constellation.
 		*/
 		ConstellationStar( uint32_t id
 			, std::string const & letter
-			, std::string const & name
+			, StringView const & name
 			, Constellation const & constellation );
 		/**
 		*\brief
 		*	Définit l'étoile.
 		*\param[in] star
 		*	L'étoile.
+		*\param[in] index
+		*	L'index de l'étoile dans le catalogue.
+		*\param[in] name
+		*	Le nom de l'étoile, dans la réserve de noms de son catalogue.
 		*/
-		inline void fill( Star const & star )noexcept
+		inline void fill( Star const & star
+			, uint32_t index
+			, StringView const & name )noexcept
 		{
-			m_name.clear();
+			// Le nom est désormais celui de l'étoile, la copie est libérée.
+			m_starName = name;
+			std::string{}.swap( m_name );
 			m_star = &star;
+			m_index = index;
 		}
 		/**
 		*\return
 		*	Le nom de l'étoile.
 		*/
-		inline std::string const & name()const noexcept
+		inline StringView name()const noexcept
 		{
-			return m_star ? m_star->name() : m_name;
+			return m_star
+				? m_starName
+				: StringView{ m_name };
 		}
 		/**
 		*\return
@@ -64,6 +75,14 @@ namespace starmap
 		}
 		/**
 		*\return
+		*	L'index de l'étoile dans le catalogue, lorsqu'elle a été définie.
+		*/
+		inline uint32_t index()const noexcept
+		{
+			return m_index;
+		}
+		/**
+		*\return
 		*	La lettre associée à l'étoile, dans la constellation.
 		*/
 		inline std::string const & letter()const noexcept
@@ -72,6 +91,14 @@ namespace starmap
 		}
 		/**
 		*\return
+		*	\p true si l'étoile a été trouvée dans la carte du ciel.
+		*/
+		inline bool filled()const noexcept
+		{
+			return m_star != nullptr;
+		}
+		/**
+		*\return
 		*	L'étoile.
 		*/
 		inline Star const & star()const noexcept
@@ -93,12 +120,16 @@ namespace starmap
 		uint32_t m_id;
 		//! La lettre associée à l'étoile, dans la constellation.
 		std::string m_letter;
-		//! Le nom de l'étoile.
+		//! Le nom de l'étoile, tant qu'elle n'est pas définie.
 		std::string m_name;
 		//! La constellation.
 		Constellation const & m_constellation;
 		//! L'étoile
 		Star const * m_star{ nullptr };
+		//! Le nom de l'étoile, lorsqu'elle a été définie.
+		StringView m_starName;
+		//! L'index de l'étoile dans le catalogue, lorsqu'elle a été définie.
+		uint32_t m_index{ 0u };
 	};
 }
 
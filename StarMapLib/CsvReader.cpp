@@ -1,150 +1,887 @@
 #include "CsvReader.h"
 
-#include "StarMap.h"
+#include "DeepSkyObject.h"
+#include "ReadMonitor.h"
+#include "StarCatalogue.h"
+#include "SeparatorScanner.h"
+#include "StarKernels.h"
+#include "StringView.h"
 
-#include <RenderLib/StringUtils.h>
+#include <array>
+#include <future>
+#include <thread>
 
 namespace starmap
 {
 	namespace
 	{
-		float doParseFloat( std::string text )
+		/**
+		*\brief
+		*	Les colonnes du catalogue connues du loader.
+		*/
+		enum class Column
+			: uint8_t
 		{
-			text = render::replace( text, "\"", "" );
-			text = render::replace( text, ",", "." );
-			std::stringstream stream{ text };
-			float result{ 0.0f };
-			stream >> result;
-			return result;
-		}
+			eProper,
+			eGl,
+			eHip,
+			eHd,
+			eRarad,
+			eDecrad,
+			eMag,
+			eCi,
+			eSpect,
+			eDist,
+			ePmrarad,
+			ePmdecrad,
+			eCon,
+			eType,
+			eName,
+			eR1,
+			eDisplayMag,
+			eCat1,
+			eId1,
+			eDupid,
+			eCount,
+			//! Colonne non utilisée, sautée sans être lue.
+			eSkip = 0xFF,
+		};
+		static size_t constexpr ColumnCount = size_t( Column::eCount );
 
-		struct Index
-		{
-			uint32_t count;
-			uint32_t proper;
-			uint32_t gl;
-			uint32_t hip;
-			uint32_t rarad;
-			uint32_t decrad;
-			uint32_t mag;
-			uint32_t spect;
-			uint32_t ci;
-			uint32_t x;
-			uint32_t y;
-			uint32_t z;
+		static StringView const ColumnNames[ColumnCount]
+		{
+			"proper",
+			"gl",
+			"hip",
+			"hd",
+			"rarad",
+			"decrad",
+			"mag",
+			"ci",
+			"spect",
+			"dist",
+			"pmrarad",
+			"pmdecrad",
+			"con",
+			"type",
+			"name",
+			"r1",
+			"display_mag",
+			"cat1",
+			"id1",
+			"dupid",
+		};
+
+		inline uint32_t doGetMask( Column column )
+		{
+			return 1u << uint32_t( column );
+		}
+		/**
+		*\brief
+		*	Les colonnes nécessaires à la création d'une Star, à son
+		*	mouvement propre, et à sa jointure avec les étoiles d'un autre
+		*	catalogue.
+		*/
+		static uint32_t const StarColumns = doGetMask( Column::eProper )
+			| doGetMask( Column::eGl )
+			| doGetMask( Column::eHip )
+			| doGetMask( Column::eHd )
+			| doGetMask( Column::eRarad )
+			| doGetMask( Column::eDecrad )
+			| doGetMask( Column::eMag )
+			| doGetMask( Column::eCi )
+			| doGetMask( Column::ePmrarad )
+			| doGetMask( Column::ePmdecrad );
+		/**
+		*\brief
+		*	Les colonnes nécessaires à la création d'un DeepSkyObject.
+		*/
+		static uint32_t const DeepSkyColumns = doGetMask( Column::eRarad )
+			| doGetMask( Column::eDecrad )
+			| doGetMask( Column::eMag )
+			| doGetMask( Column::eType )
+			| doGetMask( Column::eName )
+			| doGetMask( Column::eR1 )
+			| doGetMask( Column::eDisplayMag )
+			| doGetMask( Column::eCat1 )
+			| doGetMask( Column::eId1 )
+			| doGetMask( Column::eDupid );
+		/**
+		*\brief
+		*	Le nombre d'étoiles accumulées avant d'être construites en lot.
+		*/
+		static size_t constexpr StarBatchSize = 4096u;
+		/**
+		*\brief
+		*	Les étoiles lues dans un morceau du fichier.
+		*/
+		struct Chunk
+		{
+			//! Les noms des étoiles.
+			NamePool names;
+			//! Les étoiles, dans l'ordre des lignes.
+			StarArray stars;
+			//! Les identifiants des étoiles.
+			StarIdentifierArray identifiers;
+			//! Les mouvements propres des étoiles.
+			StarMotionArray motions;
+			//! Les attributs renseignés par les lignes.
+			std::vector< StarFields > fields;
+		};
+		/**
+		*\brief
+		*	Les objets du ciel profond lus dans un morceau du fichier.
+		*/
+		struct DeepSkyChunk
+		{
+			//! Les noms des objets.
+			NamePool names;
+			//! Les objets, dans l'ordre des lignes.
+			DeepSkyObjectArray objects;
+		};
+		/**
+		*\brief
+		*	Les données brutes d'un lot d'objets du ciel profond, rangées par
+		*	colonnes, dont les directions sont calculées en une fois.
+		*/
+		struct DeepSkyBatch
+		{
+			std::vector< StringView > names;
+			std::vector< DeepSkyType > types;
+			std::vector< float > magnitudes;
+			std::vector< float > radii;
+			std::vector< float > ascensions;
+			std::vector< float > declinations;
 		};
+		/**
+		*\brief
+		*	La projection des colonnes du fichier sur les colonnes utilisées.
+		*\remarks
+		*	Compilée une fois depuis l'en-tête, elle indique pour chaque
+		*	colonne du fichier, jusqu'à la dernière utilisée, la colonne
+		*	connue qu'elle alimente, ou Column::eSkip. Les colonnes suivantes
+		*	ne sont pas parcourues.
+		*/
+		struct Projection
+		{
+			std::vector< Column > columns;
+		};
+		/**
+		*\brief
+		*	Les vues sur les champs projetés d'une ligne, non encore décodés.
+		*/
+		using Row = std::array< StringView, ColumnCount >;
+		/**
+		*\brief
+		*	Récupère la ligne commençant au curseur, et avance ce dernier au
+		*	début de la ligne suivante.
+		*\remarks
+		*	Le '\\r' éventuel de fin de ligne est exclu de la vue retournée.
+		*/
+		StringView doNextLine( char const *& it
+			, char const * end )
+		{
+			auto begin = it;
+			auto eol = static_cast< char const * >( memchr( begin, '\n', size_t( end - begin ) ) );
 
-		Index doLoadIndex( std::string const & line )
+			if ( eol )
+			{
+				it = eol + 1;
+			}
+			else
+			{
+				eol = end;
+				it = end;
+			}
+
+			if ( eol != begin && *( eol - 1 ) == '\r' )
+			{
+				--eol;
+			}
+
+			return StringView{ begin, eol };
+		}
+		/**
+		*\brief
+		*	Récupère le champ commençant au curseur, et avance ce dernier au
+		*	début du champ suivant.
+		*\remarks
+		*	Un champ entre guillemets peut contenir des virgules, les
+		*	guillemets sont exclus de la vue retournée.
+		*/
+		StringView doNextField( char const *& it
+			, char const * end )
 		{
-			auto begin = std::begin( line );
-			auto end = std::end( line );
-			Index result{ 0xFFFFFFFF };
-			result.count = uint32_t( std::count( begin, end, ',' ) + 1u );
-			auto fields = render::split( line
-				, ","
-				, result.count
-				, false );
-			uint32_t i = 0u;
+			auto begin = it;
 
-			for ( auto & field : fields )
+			if ( begin != end && *begin == '"' )
 			{
-				if ( field == "proper" )
+				auto close = std::find( begin + 1, end, '"' );
+				auto sep = std::find( close, end, ',' );
+				it = sep == end ? end : sep + 1;
+				return StringView{ begin + 1, close };
+			}
+
+			auto sep = std::find( begin, end, ',' );
+			it = sep == end ? end : sep + 1;
+			return StringView{ begin, sep };
+		}
+
+		/**
+		*\brief
+		*	Compile la projection des colonnes \p needed à partir de la
+		*	ligne d'en-tête.
+		*/
+		Projection doCompileProjection( StringView const & line
+			, uint32_t needed )
+		{
+			Projection result;
+			auto it = line.begin();
+			size_t last{ 0u };
+
+			while ( it != line.end() )
+			{
+				auto field = doNextField( it, line.end() );
+				auto found = std::find( std::begin( ColumnNames )
+					, std::end( ColumnNames )
+					, field );
+				auto column = Column::eSkip;
+
+				if ( found != std::end( ColumnNames ) )
 				{
-					result.proper = i;
+					column = Column( found - std::begin( ColumnNames ) );
+
+					if ( needed & doGetMask( column ) )
+					{
+						// Une colonne présente deux fois n'est lue qu'une fois.
+						needed &= ~doGetMask( column );
+					}
+					else
+					{
+						column = Column::eSkip;
+					}
 				}
-				else if ( field == "gl" )
+
+				result.columns.push_back( column );
+
+				if ( column != Column::eSkip )
 				{
-					result.gl = i;
+					last = result.columns.size();
 				}
-				else if ( field == "hip" )
+			}
+
+			result.columns.resize( last );
+			return result;
+		}
+		/**
+		*\brief
+		*	Ajoute au lot l'étoile décrite par les champs d'une ligne.
+		*\remarks
+		*	Les champs ne sont décodés qu'ici, et seulement ceux qui sont
+		*	effectivement utilisés.
+		*/
+		void doLoadStar( Row const & row
+			, Chunk & chunk
+			, StarBatch & batch )
+		{
+			auto & proper = row[size_t( Column::eProper )];
+			auto & gl = row[size_t( Column::eGl )];
+			auto & hip = row[size_t( Column::eHip )];
+			auto name = proper;
+
+			if ( name.empty() )
+			{
+				name = gl;
+			}
+
+			if ( name.empty() )
+			{
+				name = hip;
+			}
+
+			batch.push( chunk.names.add( name )
+				, toFloat( row[size_t( Column::eMag )] )
+				, toFloat( row[size_t( Column::eRarad )] )
+				, toFloat( row[size_t( Column::eDecrad )] )
+				, toFloat( row[size_t( Column::eCi )] )
+				, toFloat( row[size_t( Column::ePmrarad )] )
+				, toFloat( row[size_t( Column::ePmdecrad )] ) );
+
+			StarIdentifiers identifiers;
+			parseUInt( hip, identifiers.hip );
+			parseUInt( row[size_t( Column::eHd )], identifiers.hd );
+			identifiers.gl = gl.empty() ? 0u : hash( gl );
+			chunk.identifiers.push_back( identifiers );
+
+			// Seuls les attributs renseignés par la ligne mettent à jour une
+			// étoile lors d'une fusion.
+			StarFields fields{ StarField::eNone };
+
+			if ( !proper.empty() )
+			{
+				fields |= StarField::eName;
+			}
+
+			if ( !row[size_t( Column::eMag )].empty() )
+			{
+				fields |= StarField::eMagnitude;
+			}
+
+			if ( !row[size_t( Column::eRarad )].empty()
+				&& !row[size_t( Column::eDecrad )].empty() )
+			{
+				fields |= StarField::ePosition;
+			}
+
+			if ( !row[size_t( Column::eCi )].empty() )
+			{
+				fields |= StarField::eColour;
+			}
+
+			if ( !row[size_t( Column::ePmrarad )].empty()
+				&& !row[size_t( Column::ePmdecrad )].empty() )
+			{
+				fields |= StarField::eMotion;
+			}
+
+			chunk.fields.push_back( fields );
+		}
+		/**
+		*\brief
+		*	Parcourt les lignes de l'intervalle donné.
+		*\remarks
+		*	Les séparateurs sont trouvés par SeparatorScanner, les octets
+		*	entre deux séparateurs ne sont donc pas relus.\n
+		*	Les octets lus sont signalés au moniteur toutes les
+		*	StarBatchSize lignes, le parcours s'arrêtant s'il est annulé.
+		*\param[in] projection
+		*	La projection des colonnes.
+		*\param[in] begin, end
+		*	L'intervalle, commençant au début d'une ligne.
+		*\param[in] monitor
+		*	Le suivi de la lecture.
+		*\param[in] onRow
+		*	Appelée pour chaque ligne non vide, avec ses champs projetés.
+		*/
+		template< typename RowFunc >
+		void doParseRows( Projection const & projection
+			, char const * begin
+			, char const * end
+			, ReadMonitor const & monitor
+			, RowFunc onRow )
+		{
+			auto lastColumn = projection.columns.size();
+			Row row;
+			SeparatorScanner scanner{ begin, end };
+			auto lineBegin = begin;
+			auto fieldBegin = begin;
+			auto reported = begin;
+			size_t rows{ 0u };
+			size_t column{ 0u };
+			bool quoted{ false };
+			char const * position;
+			Separator separator;
+
+			do
+			{
+				separator = scanner.next( position );
+
+				if ( separator == Separator::eQuote )
 				{
-					result.hip = i;
+					// Les séparateurs entre guillemets font partie du champ.
+					quoted = !quoted;
+					continue;
 				}
-				else if ( field == "rarad" )
+
+				if ( quoted && separator != Separator::eEnd )
 				{
-					result.rarad = i;
+					continue;
 				}
-				else if ( field == "decrad" )
+
+				auto fieldEnd = position;
+
+				if ( separator != Separator::eField
+					&& fieldEnd != fieldBegin
+					&& *( fieldEnd - 1 ) == '\r' )
 				{
-					result.decrad = i;
+					--fieldEnd;
 				}
-				else if ( field == "mag" )
+
+				bool empty = separator != Separator::eField
+					&& column == 0u
+					&& fieldEnd == lineBegin;
+
+				if ( column < lastColumn
+					&& projection.columns[column] != Column::eSkip )
 				{
-					result.mag = i;
+					row[size_t( projection.columns[column] )] = unquote( StringView{ fieldBegin, fieldEnd } );
 				}
-				else if ( field == "spect" )
+
+				++column;
+
+				if ( separator == Separator::eField
+					&& column == lastColumn )
 				{
-					result.spect = i;
+					// Toutes les colonnes utilisées sont lues, le reste de la
+					// ligne est sauté sans en énumérer les champs.
+					separator = scanner.nextRecord( position );
 				}
-				else if ( field == "ci" )
+
+				if ( separator == Separator::eField )
 				{
-					result.ci = i;
+					fieldBegin = position + 1;
 				}
-				else if ( field == "x" )
+				else
 				{
-					result.x = i;
+					if ( !empty )
+					{
+						onRow( row );
+					}
+
+					row.fill( StringView{} );
+					column = 0u;
+					quoted = false;
+					lineBegin = position + 1;
+					fieldBegin = lineBegin;
+
+					if ( ++rows == StarBatchSize )
+					{
+						rows = 0u;
+
+						if ( !monitor.advance( size_t( lineBegin - reported ) ) )
+						{
+							return;
+						}
+
+						reported = lineBegin;
+					}
 				}
-				else if ( field == "y" )
+			}
+			while ( separator != Separator::eEnd );
+
+			monitor.advance( size_t( end - reported ) );
+		}
+		/**
+		*\brief
+		*	Crée les étoiles décrites par les lignes de l'intervalle donné.
+		*\remarks
+		*	Les champs sont accumulés par lots de StarBatchSize lignes, les
+		*	étoiles et leurs mouvements propres étant ensuite construits par
+		*	packStars et appendMotions.
+		*\param[in] projection
+		*	La projection des colonnes.
+		*\param[in] begin, end
+		*	L'intervalle, commençant au début d'une ligne.
+		*\param[in] monitor
+		*	Le suivi de la lecture.
+		*\param[out] chunk
+		*	Reçoit les étoiles, dans l'ordre des lignes.
+		*/
+		void doLoadStars( Projection const & projection
+			, char const * begin
+			, char const * end
+			, ReadMonitor const & monitor
+			, Chunk & chunk )
+		{
+			StarBatch batch;
+			batch.reserve( StarBatchSize );
+			doParseRows( projection
+				, begin
+				, end
+				, monitor
+				, [&chunk, &batch]( Row const & row )
 				{
-					result.y = i;
-				}
-				else if ( field == "z" )
+					doLoadStar( row, chunk, batch );
+
+					if ( batch.size() == StarBatchSize )
+					{
+						appendStars( batch, chunk.stars );
+						appendMotions( batch, chunk.stars, chunk.motions );
+						batch.clear();
+					}
+				} );
+			appendStars( batch, chunk.stars );
+			appendMotions( batch, chunk.stars, chunk.motions );
+		}
+		/**
+		*\brief
+		*	Ajoute au lot l'objet décrit par les champs d'une ligne.
+		*\remarks
+		*	Les doublons (dupid renseigné) sont ignorés, comme le préconise la
+		*	base HYG, ainsi que les objets sans magnitude ni position. La
+		*	magnitude d'affichage (display_mag) est préférée à la magnitude
+		*	lorsqu'elle est renseignée, le nom (name) à la désignation
+		*	(cat1 id1).
+		*/
+		void doLoadDeepSkyObject( Row const & row
+			, DeepSkyChunk & chunk
+			, DeepSkyBatch & batch
+			, std::string & designation )
+		{
+			auto magnitude = row[size_t( Column::eDisplayMag )];
+
+			if ( magnitude.empty() )
+			{
+				magnitude = row[size_t( Column::eMag )];
+			}
+
+			if ( !row[size_t( Column::eDupid )].empty()
+				|| magnitude.empty()
+				|| row[size_t( Column::eRarad )].empty()
+				|| row[size_t( Column::eDecrad )].empty() )
+			{
+				return;
+			}
+
+			auto name = row[size_t( Column::eName )];
+
+			if ( name.empty() )
+			{
+				designation.assign( row[size_t( Column::eCat1 )].begin()
+					, row[size_t( Column::eCat1 )].end() );
+
+				if ( !designation.empty() )
 				{
-					result.z = i;
+					designation += ' ';
 				}
 
-				++i;
+				designation.append( row[size_t( Column::eId1 )].begin()
+					, row[size_t( Column::eId1 )].end() );
+				name = StringView{ designation };
 			}
 
-			return result;
+			batch.names.push_back( chunk.names.intern( name ) );
+			batch.types.push_back( deepSkyType( row[size_t( Column::eType )] ) );
+			batch.magnitudes.push_back( toFloat( magnitude ) );
+			batch.radii.push_back( toFloat( row[size_t( Column::eR1 )] ) );
+			batch.ascensions.push_back( toFloat( row[size_t( Column::eRarad )] ) );
+			batch.declinations.push_back( toFloat( row[size_t( Column::eDecrad )] ) );
 		}
-	}
+		/**
+		*\brief
+		*	Construit les objets d'un lot, puis vide celui-ci.
+		*/
+		void doFlushDeepSkyObjects( DeepSkyBatch & batch
+			, DeepSkyObjectArray & objects )
+		{
+			auto count = batch.names.size();
+			std::vector< gl::U16Vec2 > directions( count );
+			packDirections( batch.ascensions.data()
+				, batch.declinations.data()
+				, count
+				, directions.data() );
+			objects.reserve( objects.size() + count );
 
-	void loadStarsFromCsv( StarMap & starmap, std::string content )
-	{
-		content = render::replace( content, '\r', "" );
-		auto begin = std::begin( content );
-		auto end = std::end( content );
-		auto lines = render::split( content
-			, "\n"
-			, uint32_t( std::count( begin, end, '\n' ) + 1u )
-			, false );
-		content.clear();
+			for ( size_t i = 0u; i < count; ++i )
+			{
+				objects.emplace_back( batch.names[i]
+					, batch.types[i]
+					, batch.magnitudes[i]
+					, batch.radii[i]
+					, directions[i] );
+			}
 
-		if ( lines.size() > 1 )
+			batch = DeepSkyBatch{};
+		}
+		/**
+		*\brief
+		*	Crée les objets du ciel profond décrits par les lignes de
+		*	l'intervalle donné.
+		*\param[in] projection
+		*	La projection des colonnes.
+		*\param[in] begin, end
+		*	L'intervalle, commençant au début d'une ligne.
+		*\param[in] monitor
+		*	Le suivi de la lecture.
+		*\param[out] chunk
+		*	Reçoit les objets, dans l'ordre des lignes.
+		*/
+		void doLoadDeepSkyObjects( Projection const & projection
+			, char const * begin
+			, char const * end
+			, ReadMonitor const & monitor
+			, DeepSkyChunk & chunk )
 		{
-#if !defined( NDEBUG )
-			auto linesEnd = lines.begin() + std::min( 10000u, uint32_t( lines.size() ) );
-#else
-			auto linesEnd = lines.end();
-#endif
-			auto index = doLoadIndex( lines[0] );
-			std::for_each( lines.begin() + 1
-				, linesEnd
-				, [&starmap, &index]( std::string & line )
+			DeepSkyBatch batch;
+			std::string designation;
+			doParseRows( projection
+				, begin
+				, end
+				, monitor
+				, [&chunk, &batch, &designation]( Row const & row )
 				{
-					auto values = render::split( line, ",", index.count, true );
-					assert( values.size() == index.count );
-					auto name = render::replace( values[index.proper], "\"", "" );
+					doLoadDeepSkyObject( row, chunk, batch, designation );
 
-					if ( name.empty() )
+					if ( batch.names.size() == StarBatchSize )
 					{
-						name = render::replace( values[index.gl], "\"", "" );
+						doFlushDeepSkyObjects( batch, chunk.objects );
 					}
+				} );
+			doFlushDeepSkyObjects( batch, chunk.objects );
+		}
+		/**
+		*\brief
+		*	Décale les positions des noms des étoiles d'un morceau, une fois
+		*	sa réserve fusionnée dans celle du catalogue.
+		*/
+		void doRebaseNames( Chunk & chunk
+			, uint32_t base )
+		{
+			if ( base )
+			{
+				for ( auto & star : chunk.stars )
+				{
+					star.name( star.name() + base );
+				}
+			}
+		}
+		/**
+		*\brief
+		*	Les objets du ciel profond gardent une vue sur leur nom, qui reste
+		*	valide après la fusion des réserves.
+		*/
+		void doRebaseNames( DeepSkyChunk &
+			, uint32_t )
+		{
+		}
+		/**
+		*\brief
+		*	Découpe l'intervalle donné en morceaux de tailles similaires,
+		*	chacun se terminant sur une fin de ligne.
+		*\return
+		*	Les bornes des morceaux, il y en a \p count + 1 au maximum.
+		*/
+		std::vector< char const * > doSplitChunks( char const * begin
+			, char const * end
+			, uint32_t count )
+		{
+			std::vector< char const * > result;
+			auto chunkSize = size_t( end - begin ) / count;
+			result.push_back( begin );
+
+			for ( auto i = 1u; i < count && result.back() != end; ++i )
+			{
+				auto it = std::max( result.back(), begin + i * chunkSize );
+				auto eol = static_cast< char const * >( memchr( it, '\n', size_t( end - it ) ) );
+				result.push_back( eol ? eol + 1 : end );
+			}
+
+			if ( result.back() != end )
+			{
+				result.push_back( end );
+			}
+
+			return result;
+		}
+		/**
+		*\brief
+		*	Analyse le contenu par morceaux, en parallèle.
+		*\param[in,out] catalogue
+		*	Le catalogue, dont la réserve reçoit les noms lus.
+		*\param[in] content
+		*	Le contenu du fichier.
+		*\param[in] needed
+		*	Les colonnes utilisées.
+		*\param[in] threadCount
+		*	Le nombre de threads utilisés pour l'analyse, 0 pour utiliser le
+		*	nombre de coeurs disponibles.
+		*\param[in] monitor
+		*	Le suivi de la lecture, partagé par les threads.
+		*\param[in] load
+		*	Analyse un morceau : load( projection, begin, end, monitor, chunk ).
+		*\return
+		*	Les morceaux, dans l'ordre des lignes.
+		*/
+		template< typename ChunkT, typename LoadFunc >
+		std::vector< ChunkT > doLoadChunks( StarCatalogue & catalogue
+			, StringView const & content
+			, uint32_t needed
+			, uint32_t threadCount
+			, ReadMonitor const & monitor
+			, LoadFunc load )
+		{
+			std::vector< ChunkT > chunks;
+			auto it = content.begin();
+			auto end = content.end();
+			monitor.start( content.size() );
+
+			if ( it == end )
+			{
+				return chunks;
+			}
+
+			auto projection = doCompileProjection( doNextLine( it, end ), needed );
+			monitor.advance( size_t( it - content.begin() ) );
+#if !defined( NDEBUG )
+			auto limit = it;
+
+			for ( auto i = 0u; i < 10000u && limit != end; ++i )
+			{
+				doNextLine( limit, end );
+			}
+
+			end = limit;
+#endif
 
-					if ( name.empty() )
+			if ( !threadCount )
+			{
+				threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+			}
+
+			auto bounds = doSplitChunks( it, end, threadCount );
+			chunks.resize( bounds.size() - 1u );
+			std::vector< std::future< void > > workers;
+
+			// Le premier morceau est traité sur le thread appelant, les autres
+			// sur des threads de travail.
+			for ( size_t i = 1u; i < chunks.size(); ++i )
+			{
+				workers.emplace_back( std::async( std::launch::async
+					, [&projection, &bounds, &chunks, &monitor, &load, i]()
 					{
-						name = render::replace( values[index.hip], "\"", "" );
-					}
+						load( projection, bounds[i], bounds[i + 1], monitor, chunks[i] );
+					} ) );
+			}
 
-					auto magnitude = doParseFloat( values[index.mag] );
-					auto ra = doParseFloat( values[index.rarad] );
-					auto dec = doParseFloat( values[index.decrad] );
-					auto ci = doParseFloat( values[index.ci] );
-					auto colour = bvToRgb( ci );
-					starmap.add( Star{ name, magnitude, gl::Vec2{ ra, dec }, colour } );
-					line.clear();
-				} );
+			if ( !chunks.empty() )
+			{
+				load( projection, bounds[0], bounds[1], monitor, chunks[0] );
+			}
+
+			for ( auto & worker : workers )
+			{
+				worker.get();
+			}
+
+			// Les blocs de noms de chaque thread sont repris par le catalogue,
+			// les noms ne sont donc pas recopiés, seules leurs positions sont
+			// décalées.
+			for ( auto & chunk : chunks )
+			{
+				doRebaseNames( chunk
+					, catalogue.namePool().merge( std::move( chunk.names ) ) );
+			}
+
+			return chunks;
+		}
+		/**
+		*\brief
+		*	Lit les étoiles du contenu, en parallèle, puis les rassemble
+		*	dans l'ordre des lignes.
+		*\param[in,out] catalogue
+		*	Le catalogue, dont la réserve reçoit les noms des étoiles.
+		*\param[in] content
+		*	Le contenu du fichier.
+		*\param[in] threadCount
+		*	Le nombre de threads utilisés pour l'analyse, 0 pour utiliser le
+		*	nombre de coeurs disponibles.
+		*\param[in] monitor
+		*	Le suivi de la lecture.
+		*\param[out] result
+		*	Reçoit les étoiles.
+		*/
+		void doLoadContent( StarCatalogue & catalogue
+			, StringView const & content
+			, uint32_t threadCount
+			, ReadMonitor const & monitor
+			, Chunk & result )
+		{
+			auto chunks = doLoadChunks< Chunk >( catalogue
+				, content
+				, StarColumns
+				, threadCount
+				, monitor
+				, doLoadStars );
+
+			// Fusion dans l'ordre des lignes.
+			size_t count{ 0u };
+
+			for ( auto & chunk : chunks )
+			{
+				count += chunk.stars.size();
+			}
+
+			result.stars.reserve( count );
+			result.identifiers.reserve( count );
+			result.motions.reserve( count );
+			result.fields.reserve( count );
+
+			for ( auto & chunk : chunks )
+			{
+				std::move( chunk.stars.begin(), chunk.stars.end(), std::back_inserter( result.stars ) );
+				result.identifiers.insert( result.identifiers.end()
+					, chunk.identifiers.begin()
+					, chunk.identifiers.end() );
+				result.motions.insert( result.motions.end()
+					, chunk.motions.begin()
+					, chunk.motions.end() );
+				result.fields.insert( result.fields.end()
+					, chunk.fields.begin()
+					, chunk.fields.end() );
+				chunk = Chunk{};
+			}
+		}
+	}
+
+	void loadStarsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, uint32_t threadCount
+		, ReadMonitor const & monitor )
+	{
+		Chunk stars;
+		doLoadContent( catalogue, content, threadCount, monitor, stars );
+
+		if ( monitor.cancelled() )
+		{
+			return;
+		}
+
+		catalogue.add( std::move( stars.stars )
+			, std::move( stars.identifiers )
+			, std::move( stars.motions ) );
+	}
+
+	MergeStatistics mergeStarsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, MergeMode mode
+		, uint32_t threadCount
+		, ReadMonitor const & monitor )
+	{
+		Chunk stars;
+		doLoadContent( catalogue, content, threadCount, monitor, stars );
+
+		if ( monitor.cancelled() )
+		{
+			return MergeStatistics{};
+		}
+
+		return catalogue.merge( std::move( stars.stars )
+			, std::move( stars.identifiers )
+			, std::move( stars.motions )
+			, stars.fields
+			, mode );
+	}
+
+	void loadDeepSkyObjectsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, uint32_t threadCount
+		, ReadMonitor const & monitor )
+	{
+		auto chunks = doLoadChunks< DeepSkyChunk >( catalogue
+			, content
+			, DeepSkyColumns
+			, threadCount
+			, monitor
+			, doLoadDeepSkyObjects );
+
+		if ( monitor.cancelled() )
+		{
+			return;
+		}
+
+		for ( auto & chunk : chunks )
+		{
+			catalogue.add( std::move( chunk.objects ) );
 		}
 	}
 }
@@ -8,7 +8,9 @@
 #define ___StarMapLib_CsvReader_HPP___
 #pragma once
 
-#include "StarMapLibPrerequisites.h"
+#include "CatalogueMerge.h"
+#include "ReadMonitor.h"
+#include "StringView.h"
 
 namespace starmap
 {
@@ -24,14 +26,113 @@ namespace starmap
 	*\li proper: Le nom commun de l'étoile (optionnel).
 	*\li gl: L'ID de l'étoile dans le Gliese Catalog of Nearby Stars (optionnel).
 	*\li hip: L'ID de l'étoile dans le catalogue Hipparcos.
+	*\li hd: L'ID de l'étoile dans le catalogue Henry Draper (optionnel).
 	*\li rarad: L'ascension de l'étoile, en radians.
 	*\li decrad: La déclinaison de l'étoile, en radians.
 	*\li mag: La magnitude de l'étoile.
 	*\li spect: Le type spectral de l'étoile (optionnel).
 	*\li ci: L'index de la couleur de l'étoile (optionnel).
+	*\li pmrarad, pmdecrad: Le mouvement propre de l'étoile, en radians par
+	*	an (optionnel).
 	*
+	*	Le contenu est parcouru sur place, seuls les noms des étoiles
+	*	retenues sont copiés.\n
+	*	L'en-tête est compilé en une projection : les colonnes inutilisées
+	*	ne sont pas lues, et le reste d'une ligne après la dernière colonne
+	*	utilisée est sauté d'un bloc. Les champs retenus ne sont décodés
+	*	qu'au moment de créer l'étoile. Un retour à la ligne entre
+	*	guillemets n'est donc supporté que dans les colonnes utilisées.\n
+	*	Le contenu peut être découpé en morceaux, aux fins de lignes, traités
+	*	en parallèle. Les étoiles obtenues sont ajoutées au catalogue en une
+	*	fois, dans l'ordre du fichier, avec leurs identifiants (hip, hd,
+	*	gl), qui permettent d'y fusionner d'autres catalogues, et leurs
+	*	mouvements propres (voir StarCatalogue::epoch).\n
+	*	L'avancement est compté en octets du contenu. Si la lecture est
+	*	annulée, le catalogue ne reçoit aucune étoile.
+	*\param[in,out] catalogue
+	*	Le catalogue recevant les étoiles.
+	*\param[in] content
+	*	Le contenu du fichier, qui peut être une projection mémoire du
+	*	fichier (une std::string est convertie implicitement).
+	*\param[in] threadCount
+	*	Le nombre de threads utilisés pour l'analyse, 0 pour utiliser le
+	*	nombre de coeurs disponibles.
+	*\param[in] monitor
+	*	Le suivi de la lecture, consulté par lots de lignes.
 	*/
-	void loadStarsFromCsv( StarMap & starmap, std::string content );
+	void loadStarsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, uint32_t threadCount = 1u
+		, ReadMonitor const & monitor = ReadMonitor{} );
+	/**
+	*\brief
+	*	Fusionne les étoiles d'un fichier CSV avec celles du catalogue.
+	*\remarks
+	*	Le fichier est lu comme par loadStarsFromCsv, ses lignes sont
+	*	ensuite jointes aux étoiles du catalogue par leurs identifiants (voir
+	*	StarCatalogue::merge).\n
+	*	Une ligne jointe ne met à jour que les attributs dont les colonnes
+	*	sont renseignées : le nom pour proper, la magnitude pour mag, la
+	*	position pour rarad et decrad, la couleur pour ci, le mouvement
+	*	propre pour pmrarad et pmdecrad. Une ligne non
+	*	jointe n'est ajoutée que si elle renseigne la magnitude et la
+	*	position.
+	*\param[in,out] catalogue
+	*	Le catalogue, dont les étoiles ont été chargées avec leurs
+	*	identifiants.
+	*\param[in] content
+	*	Le contenu du fichier.
+	*\param[in] mode
+	*	Le mode de fusion.
+	*\param[in] threadCount
+	*	Le nombre de threads utilisés pour l'analyse, 0 pour utiliser le
+	*	nombre de coeurs disponibles.
+	*\param[in] monitor
+	*	Le suivi de la lecture, consulté par lots de lignes. Si la lecture
+	*	est annulée, rien n'est fusionné.
+	*\return
+	*	Le bilan de la fusion.
+	*/
+	MergeStatistics mergeStarsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, MergeMode mode = MergeMode::eUpdate
+		, uint32_t threadCount = 1u
+		, ReadMonitor const & monitor = ReadMonitor{} );
+	/**
+	*\brief
+	*	Charge des objets du ciel profond depuis un fichier CSV, tel le
+	*	fichier dso.csv de la base HYG.
+	*\remarks
+	*	Le fichier est lu comme par loadStarsFromCsv, le loader cherchant
+	*	les champs suivants:\n
+	*\li rarad, decrad: La position de l'objet, en radians.
+	*\li mag: La magnitude de l'objet.
+	*\li display_mag: La magnitude à utiliser pour l'affichage, préférée à
+	*	mag (optionnel).
+	*\li type: Le type de l'objet (voir deepSkyType).
+	*\li r1: Le rayon apparent de l'objet, en minutes d'arc (optionnel).
+	*\li name: Le nom commun de l'objet (optionnel).
+	*\li cat1, id1: La désignation principale de l'objet, utilisée comme
+	*	nom en l'absence de nom commun.
+	*\li dupid: L'identifiant de l'objet dont celui-ci est un doublon,
+	*	l'objet est alors ignoré (optionnel).
+	*
+	*	Les objets sans magnitude ni position sont ignorés.
+	*\param[in,out] catalogue
+	*	Le catalogue recevant les objets.
+	*\param[in] content
+	*	Le contenu du fichier.
+	*\param[in] threadCount
+	*	Le nombre de threads utilisés pour l'analyse, 0 pour utiliser le
+	*	nombre de coeurs disponibles.
+	*\param[in] monitor
+	*	Le suivi de la lecture, consulté par lots de lignes. Si la lecture
+	*	est annulée, le catalogue ne reçoit aucun objet.
+	*/
+	void loadDeepSkyObjectsFromCsv( StarCatalogue & catalogue
+		, StringView const & content
+		, uint32_t threadCount = 1u
+		, ReadMonitor const & monitor = ReadMonitor{} );
 }
 
 #endif
@@ -0,0 +1,114 @@
+#include "DeepSkyObject.h"
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	Un code de type d'objet, et sa famille.
+		*/
+		struct TypeCode
+		{
+			char const * code;
+			DeepSkyType type;
+		};
+		/**
+		*\brief
+		*	Les codes connus, en minuscules : ceux du HCNGC, auxquels la base
+		*	HYG se réfère, et ceux du SAC, dont proviennent une partie de ses
+		*	objets.
+		*/
+		static TypeCode const TypeCodes[]
+		{
+			{ "gx", DeepSkyType::eGalaxy },
+			{ "gxy", DeepSkyType::eGalaxy },
+			{ "galxy", DeepSkyType::eGalaxy },
+			{ "galcl", DeepSkyType::eGalaxy },
+			{ "gx+dn", DeepSkyType::eGalaxy },
+			{ "oc", DeepSkyType::eOpenCluster },
+			{ "ocl", DeepSkyType::eOpenCluster },
+			{ "opncl", DeepSkyType::eOpenCluster },
+			{ "lmcoc", DeepSkyType::eOpenCluster },
+			{ "smcoc", DeepSkyType::eOpenCluster },
+			{ "gb", DeepSkyType::eGlobularCluster },
+			{ "gc", DeepSkyType::eGlobularCluster },
+			{ "glocl", DeepSkyType::eGlobularCluster },
+			{ "lmcgc", DeepSkyType::eGlobularCluster },
+			{ "smcgc", DeepSkyType::eGlobularCluster },
+			{ "nb", DeepSkyType::eNebula },
+			{ "en", DeepSkyType::eNebula },
+			{ "rn", DeepSkyType::eNebula },
+			{ "dn", DeepSkyType::eNebula },
+			{ "bn", DeepSkyType::eNebula },
+			{ "hii", DeepSkyType::eNebula },
+			{ "c+n", DeepSkyType::eNebula },
+			{ "cl+nb", DeepSkyType::eNebula },
+			{ "brtnb", DeepSkyType::eNebula },
+			{ "drknb", DeepSkyType::eNebula },
+			{ "lmccn", DeepSkyType::eNebula },
+			{ "lmcdn", DeepSkyType::eNebula },
+			{ "smccn", DeepSkyType::eNebula },
+			{ "smcdn", DeepSkyType::eNebula },
+			{ "pl", DeepSkyType::ePlanetaryNebula },
+			{ "pn", DeepSkyType::ePlanetaryNebula },
+			{ "plnnb", DeepSkyType::ePlanetaryNebula },
+			{ "snr", DeepSkyType::eSupernovaRemnant },
+			{ "snrem", DeepSkyType::eSupernovaRemnant },
+		};
+		/**
+		*\brief
+		*	La taille maximale d'un code connu.
+		*/
+		static size_t constexpr MaxCodeSize = 8u;
+	}
+
+	DeepSkyType deepSkyType( StringView const & code )
+	{
+		if ( code.size() > MaxCodeSize )
+		{
+			return DeepSkyType::eOther;
+		}
+
+		std::array< char, MaxCodeSize + 1u > lower{};
+		std::transform( code.begin()
+			, code.end()
+			, lower.begin()
+			, []( char c )
+			{
+				return char( ::tolower( static_cast< unsigned char >( c ) ) );
+			} );
+		auto it = std::find_if( std::begin( TypeCodes )
+			, std::end( TypeCodes )
+			, [&lower]( TypeCode const & lookup )
+			{
+				return strcmp( lookup.code, lower.data() ) == 0;
+			} );
+
+		return it == std::end( TypeCodes )
+			? DeepSkyType::eOther
+			: it->type;
+	}
+
+	DeepSkyTier deepSkyTier( float radius )
+	{
+		return radius < 2.0f
+			? DeepSkyTier::eSmall
+			: ( radius < 15.0f
+				? DeepSkyTier::eMedium
+				: DeepSkyTier::eLarge );
+	}
+
+	DeepSkyObject::DeepSkyObject( StringView const & name
+		, DeepSkyType type
+		, float magnitude
+		, float radius
+		, gl::U16Vec2 const & position )
+		: m_name{ name }
+		, m_position{ position }
+		, m_magnitude{ gl::packHalf( magnitude ) }
+		, m_radius{ gl::packHalf( radius ) }
+		, m_type{ type }
+	{
+	}
+}
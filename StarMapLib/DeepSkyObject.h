@@ -0,0 +1,204 @@
+/**
+*\file
+*	DeepSkyObject.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_DeepSkyObject_HPP___
+#define ___StarMapLib_DeepSkyObject_HPP___
+#pragma once
+
+#include "StringView.h"
+
+#include <GlLib/Packing.h>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les familles d'objets du ciel profond, chacune ayant son sprite.
+	*/
+	enum class DeepSkyType
+		: uint8_t
+	{
+		//! Galaxie, ou amas de galaxies.
+		eGalaxy,
+		//! Amas ouvert, ou association.
+		eOpenCluster,
+		//! Amas globulaire.
+		eGlobularCluster,
+		//! Nébuleuse diffuse (émission, réflexion, obscure), avec ou sans
+		//! amas.
+		eNebula,
+		//! Nébuleuse planétaire.
+		ePlanetaryNebula,
+		//! Rémanent de supernova.
+		eSupernovaRemnant,
+		//! Astérisme, étoile, ou type inconnu.
+		eOther,
+		eCount,
+	};
+	/**
+	*\brief
+	*	Les tailles apparentes des objets du ciel profond, chacune ayant ses
+	*	billboards.
+	*/
+	enum class DeepSkyTier
+		: uint8_t
+	{
+		//! Moins de 2 minutes d'arc de rayon, quasi ponctuel.
+		eSmall,
+		//! Moins de 15 minutes d'arc de rayon.
+		eMedium,
+		//! 15 minutes d'arc de rayon, ou plus.
+		eLarge,
+		eCount,
+	};
+	/**
+	*\brief
+	*	Récupère la famille d'un type d'objet, tel que donné par la colonne
+	*	type du fichier dso.csv de la base HYG.
+	*\param[in] code
+	*	Le code du type (Gx, OC, Gb, Pl, EN, SNR, ...), la casse n'étant pas
+	*	prise en compte.
+	*\return
+	*	La famille, DeepSkyType::eOther si le code n'est pas connu.
+	*/
+	DeepSkyType deepSkyType( StringView const & code );
+	/**
+	*\brief
+	*	Récupère la taille apparente correspondant à un rayon.
+	*\param[in] radius
+	*	Le rayon, en minutes d'arc.
+	*\return
+	*	La taille.
+	*/
+	DeepSkyTier deepSkyTier( float radius );
+	/**
+	*\brief
+	*	Un objet du ciel profond (galaxie, amas, nébuleuse).
+	*\remarks
+	*	Comme les étoiles, les objets sont sur la sphère céleste, seule leur
+	*	direction est conservée, et leur nom est conservé dans la réserve de
+	*	noms du catalogue.
+	*/
+	class DeepSkyObject
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] name
+		*	Le nom de l'objet, qui doit survivre à celui-ci (voir NamePool).
+		*\param[in] type
+		*	La famille de l'objet.
+		*\param[in] magnitude
+		*	La magnitude de l'objet, permettant de le cacher, en fonction du
+		*	zoom.
+		*\param[in] radius
+		*	Le rayon apparent de l'objet, en minutes d'arc.
+		*\param[in] position
+		*	La direction de l'objet, en coordonnées octaédriques.
+		*/
+		DeepSkyObject( StringView const & name
+			, DeepSkyType type
+			, float magnitude
+			, float radius
+			, gl::U16Vec2 const & position );
+		/**
+		*\return
+		*	Le nom de l'objet.
+		*/
+		inline StringView const & name()const noexcept
+		{
+			return m_name;
+		}
+		/**
+		*\return
+		*	La famille de l'objet.
+		*/
+		inline DeepSkyType type()const noexcept
+		{
+			return m_type;
+		}
+		/**
+		*\return
+		*	La taille apparente de l'objet.
+		*/
+		inline DeepSkyTier tier()const noexcept
+		{
+			return deepSkyTier( radius() );
+		}
+		/**
+		*\return
+		*	La magnitude de l'objet.
+		*/
+		inline float magnitude()const noexcept
+		{
+			return gl::unpackHalf( m_magnitude );
+		}
+		/**
+		*\return
+		*	Le rayon apparent de l'objet, en minutes d'arc.
+		*/
+		inline float radius()const noexcept
+		{
+			return gl::unpackHalf( m_radius );
+		}
+		/**
+		*\return
+		*	La position de l'objet, en coordonnées cartésiennes, sur la même
+		*	sphère que les étoiles.
+		*/
+		inline gl::Vec3 position()const noexcept
+		{
+			return gl::unpackOctahedral( m_position ) * 100.0f;
+		}
+		/**
+		*\return
+		*	La direction de l'objet, en coordonnées octaédriques.
+		*/
+		inline gl::U16Vec2 const & direction()const noexcept
+		{
+			return m_position;
+		}
+
+	private:
+		friend class StarCatalogue;
+		/**
+		*\brief
+		*	Remplace la vue sur le nom, par une vue sur une copie de celui-ci.
+		*/
+		inline void name( StringView const & value )noexcept
+		{
+			assert( value == m_name );
+			m_name = value;
+		}
+
+	private:
+		//! Le nom de l'objet.
+		StringView m_name;
+		//! La direction de l'objet, en coordonnées octaédriques.
+		gl::U16Vec2 m_position;
+		//! La magnitude de l'objet, en demi-flottant.
+		uint16_t m_magnitude;
+		//! Le rayon apparent de l'objet, en demi-flottant.
+		uint16_t m_radius;
+		//! La famille de l'objet.
+		DeepSkyType m_type;
+	};
+	/**
+	*\brief
+	*	Opérateur de comparaison "inférieur à".
+	*\param[in] lhs, rhs
+	*	Les objets à comparer.
+	*\return
+	*	\p true si la magnitude de lhs est inférieure à la magnitude de rhs.
+	*/
+	inline bool operator<( DeepSkyObject const & lhs, DeepSkyObject const & rhs )
+	{
+		return lhs.magnitude() < rhs.magnitude();
+	}
+}
+
+#endif
@@ -0,0 +1,310 @@
+#include "Designation.h"
+
+namespace starmap
+{
+	namespace
+	{
+		inline bool isDigit( char c )noexcept
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		inline bool isLetter( char c )noexcept
+		{
+			return ( c >= 'a' && c <= 'z' )
+				|| ( c >= 'A' && c <= 'Z' );
+		}
+
+		char const * doParseDigits( char const * it
+			, char const * end
+			, uint32_t & value )noexcept
+		{
+			uint32_t result{ 0u };
+
+			while ( it != end && isDigit( *it ) )
+			{
+				result = result * 10u + uint32_t( *it - '0' );
+				++it;
+			}
+
+			value = result;
+			return it;
+		}
+
+		char const * doParseLetters( char const * it
+			, char const * end
+			, StringView & value )noexcept
+		{
+			auto begin = it;
+
+			while ( it != end && isLetter( *it ) )
+			{
+				++it;
+			}
+
+			value = StringView{ begin, it };
+			return it;
+		}
+		/**
+		*\brief
+		*	Table de correspondance à adressage ouvert, indexée par des
+		*	abréviations de 3 caractères au plus, compactées dans un entier.
+		*\remarks
+		*	Le nombre de cases est au moins le double du nombre d'entrées,
+		*	une recherche ne parcourt donc que quelques cases.
+		*/
+		template< size_t SlotCount >
+		class AbbreviationTable
+		{
+			static_assert( ( SlotCount & ( SlotCount - 1u ) ) == 0u
+				, "SlotCount must be a power of two" );
+
+		public:
+			struct Entry
+			{
+				char const * abbreviation;
+				char const * name;
+			};
+
+			AbbreviationTable( std::initializer_list< Entry > entries )
+			{
+				assert( entries.size() * 2u <= SlotCount );
+				m_keys.fill( 0u );
+
+				for ( auto & entry : entries )
+				{
+					auto key = doMakeKey( entry.abbreviation );
+					assert( key != 0u );
+					auto slot = doHash( key );
+
+					while ( m_keys[slot] != 0u )
+					{
+						assert( m_keys[slot] != key );
+						slot = ( slot + 1u ) & ( SlotCount - 1u );
+					}
+
+					m_keys[slot] = key;
+					m_names[slot] = entry.name;
+				}
+			}
+
+			char const * find( StringView const & abbreviation )const noexcept
+			{
+				auto key = doMakeKey( abbreviation );
+
+				if ( key == 0u )
+				{
+					return nullptr;
+				}
+
+				auto slot = doHash( key );
+
+				while ( m_keys[slot] != 0u )
+				{
+					if ( m_keys[slot] == key )
+					{
+						return m_names[slot];
+					}
+
+					slot = ( slot + 1u ) & ( SlotCount - 1u );
+				}
+
+				return nullptr;
+			}
+
+		private:
+			static uint32_t doMakeKey( StringView const & abbreviation )noexcept
+			{
+				if ( abbreviation.empty() || abbreviation.size() > 3u )
+				{
+					return 0u;
+				}
+
+				uint32_t result{ 0u };
+
+				for ( auto c : abbreviation )
+				{
+					result = ( result << 8 ) | uint8_t( c );
+				}
+
+				return result;
+			}
+
+			static size_t doHash( uint32_t key )noexcept
+			{
+				return size_t( ( key * 2654435761u ) >> 16 ) & ( SlotCount - 1u );
+			}
+
+		private:
+			std::array< uint32_t, SlotCount > m_keys;
+			std::array< char const *, SlotCount > m_names;
+		};
+	}
+
+	bool parseFlamsteedBayer( StringView const & bf
+		, Designation & result )noexcept
+	{
+		auto it = bf.begin();
+		auto end = bf.size() >= 3u
+			? bf.end() - 3u
+			: bf.end();
+		auto flamsteedEnd = doParseDigits( it, end, result.flamsteed );
+		auto hasFlamsteed = flamsteedEnd != it;
+		it = flamsteedEnd;
+
+		while ( it != end && !isLetter( *it ) )
+		{
+			++it;
+		}
+
+		it = doParseLetters( it, end, result.letter );
+		auto indexEnd = doParseDigits( it, end, result.index );
+		return hasFlamsteed
+			|| !result.letter.empty()
+			|| indexEnd != it;
+	}
+
+	bool parseBayer( StringView const & bayer
+		, Designation & result )noexcept
+	{
+		auto it = doParseLetters( bayer.begin(), bayer.end(), result.letter );
+
+		if ( it != bayer.end() && *it == '-' )
+		{
+			++it;
+		}
+
+		auto indexEnd = doParseDigits( it, bayer.end(), result.index );
+		return !result.letter.empty()
+			|| indexEnd != it;
+	}
+
+	char const * findGreekLetter( StringView const & abbreviation )noexcept
+	{
+		static AbbreviationTable< 64u > const letters
+		{
+			{ "Alp", "Alpha" },
+			{ "Bet", "Beta" },
+			{ "Gam", "Gamma" },
+			{ "Del", "Delta" },
+			{ "Eps", "Epsilon" },
+			{ "Zet", "Zeta" },
+			{ "Eta", "Eta" },
+			{ "The", "Theta" },
+			{ "Iot", "Iota" },
+			{ "Kap", "Kappa" },
+			{ "Lam", "Lambda" },
+			{ "Mu", "Mu" },
+			{ "Nu", "Nu" },
+			{ "Ksi", "Ksi" },
+			{ "Omi", "Omicron" },
+			{ "Pi", "Pi" },
+			{ "Rho", "Rho" },
+			{ "Sig", "Sigma" },
+			{ "Tau", "Tau" },
+			{ "Ups", "Upsilon" },
+			{ "Phi", "Phi" },
+			{ "Chi", "Chi" },
+			{ "Psi", "Psi" },
+			{ "Ome", "Omega" },
+			{ "Xi", "Xi" },
+		};
+		return letters.find( abbreviation );
+	}
+
+	char const * findConstellationName( StringView const & abbreviation )noexcept
+	{
+		static AbbreviationTable< 256u > const names
+		{
+			{ "And", "Andromeda" },
+			{ "Ant", "Antlia" },
+			{ "Aps", "Apus" },
+			{ "Ara", "Ara" },
+			{ "Ari", "Aries" },
+			{ "Aql", "" },
+			{ "Aqr", "Aquarius" },
+			{ "Aur", "" },
+			{ "Boo", "Bootes" },
+			{ "Cae", "" },
+			{ "Cam", "Camelopardalis" },
+			{ "Cap", "" },
+			{ "Car", "" },
+			{ "Cas", "Cassiopea" },
+			{ "Cnc", "" },
+			{ "Cen", "Centaurus" },
+			{ "Cep", "" },
+			{ "Cet", "" },
+			{ "Cha", "" },
+			{ "Cir", "" },
+			{ "CMa", "Canis Majoris" },
+			{ "CMi", "Canis Minor" },
+			{ "Col", "" },
+			{ "Com", "" },
+			{ "CrA", "" },
+			{ "CrB", "" },
+			{ "Crt", "" },
+			{ "Cru", "" },
+			{ "Crv", "" },
+			{ "CVn", "" },
+			{ "Cyg", "Cygnus" },
+			{ "Del", "" },
+			{ "Dor", "" },
+			{ "Dra", "Dragonis" },
+			{ "Equ", "Equuleus" },
+			{ "Eri", "" },
+			{ "For", "" },
+			{ "Gem", "Gemini" },
+			{ "Gru", "Grus" },
+			{ "Her", "Hercules" },
+			{ "Hya", "Hydra" },
+			{ "Hyi", "Hydrus" },
+			{ "Hor", "Horologium" },
+			{ "Ind", "Indus" },
+			{ "Lac", "Lacerta" },
+			{ "Leo", "Leo" },
+			{ "Lep", "Lepus" },
+			{ "Lib", "Libra" },
+			{ "LMi", "Leo Minor" },
+			{ "Lup", "Lupus" },
+			{ "Lyn", "Lynx" },
+			{ "Lyr", "Lyra" },
+			{ "Men", "Mensa" },
+			{ "Mic", "Microscopium" },
+			{ "Mon", "Monoceros" },
+			{ "Mus", "Musca" },
+			{ "Nor", "Norma" },
+			{ "Oct", "Octant" },
+			{ "Oph", "Ophiuchus" },
+			{ "Ori", "Orion" },
+			{ "Pav", "Pavo" },
+			{ "Peg", "Pegasus" },
+			{ "Per", "Perseus" },
+			{ "Phe", "Phoenix" },
+			{ "Pic", "Pictor" },
+			{ "PsA", "Piscis Austrinus" },
+			{ "Psc", "Pisces" },
+			{ "Pyx", "" },
+			{ "Pup", "Puppis" },
+			{ "Ret", "Reticulum" },
+			{ "Scl", "Sculptor" },
+			{ "Sco", "Scorpio" },
+			{ "Sct", "" },
+			{ "Ser", "Serpens" },
+			{ "Sex", "Sextant" },
+			{ "Sge", "" },
+			{ "Sgr", "Sagittarius" },
+			{ "Tau", "Taurus" },
+			{ "Tel", "Telescopium" },
+			{ "TrA", "Triangulum Australe" },
+			{ "Tri", "Triangulum" },
+			{ "Tuc", "Tucana" },
+			{ "UMa", "Ursa Major" },
+			{ "UMi", "Ursa Minor" },
+			{ "Vel", "Vela" },
+			{ "Vir", "Virgo" },
+			{ "Vol", "Volans" },
+			{ "Vul", "Vulpecula" },
+		};
+		return names.find( abbreviation );
+	}
+}
@@ -0,0 +1,82 @@
+/**
+*\file
+*	Designation.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_Designation_HPP___
+#define ___StarMapLib_Designation_HPP___
+#pragma once
+
+#include "StringView.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Désignation de Bayer et/ou Flamsteed d'une étoile.
+	*/
+	struct Designation
+	{
+		//! Le numéro de Flamsteed, 0 s'il n'y en a pas.
+		uint32_t flamsteed{ 0u };
+		//! L'indice de la lettre grecque (Alp1, Alp2...), 0 s'il n'y en a pas.
+		uint32_t index{ 0u };
+		//! L'abréviation de la lettre grecque, vide s'il n'y en a pas.
+		StringView letter;
+	};
+	/**
+	*\brief
+	*	Analyse une colonne "bf" HYG, de la forme "21Alp And", "Alp1Cen",
+	*	"33    Psc"...
+	*\remarks
+	*	Les trois derniers caractères, l'abréviation de la constellation,
+	*	sont ignorés.\n
+	*	La lettre référence le texte donné.
+	*\param[in] bf
+	*	Le texte de la colonne.
+	*\param[out] result
+	*	Reçoit la désignation.
+	*\return
+	*	\p false si aucun numéro ni lettre n'ont été trouvés.
+	*/
+	bool parseFlamsteedBayer( StringView const & bf
+		, Designation & result )noexcept;
+	/**
+	*\brief
+	*	Analyse une colonne "bayer" HYG, de la forme "Alp", "Alp-1"...
+	*\remarks
+	*	Seules la lettre et son indice sont modifiés.\n
+	*	La lettre référence le texte donné.
+	*\param[in] bayer
+	*	Le texte de la colonne.
+	*\param[out] result
+	*	Reçoit la désignation.
+	*\return
+	*	\p false si aucune lettre ni indice n'ont été trouvés.
+	*/
+	bool parseBayer( StringView const & bayer
+		, Designation & result )noexcept;
+	/**
+	*\brief
+	*	Récupère le nom d'une lettre grecque, depuis son abréviation ("Alp").
+	*\param[in] abbreviation
+	*	L'abréviation.
+	*\return
+	*	Le nom, \p nullptr si l'abréviation est inconnue.
+	*/
+	char const * findGreekLetter( StringView const & abbreviation )noexcept;
+	/**
+	*\brief
+	*	Récupère le nom d'une constellation, depuis son abréviation IAU
+	*	("UMa").
+	*\param[in] abbreviation
+	*	L'abréviation.
+	*\return
+	*	Le nom, vide pour les constellations non gérées, \p nullptr si
+	*	l'abréviation est inconnue.
+	*/
+	char const * findConstellationName( StringView const & abbreviation )noexcept;
+}
+
+#endif
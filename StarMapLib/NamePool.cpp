@@ -0,0 +1,138 @@
+#include "NamePool.h"
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	La taille minimale d'un bloc.
+		*/
+		static size_t constexpr BlockSize = 64u * 1024u;
+	}
+
+	uint32_t NamePool::add( StringView const & text )
+	{
+		if ( text.empty() )
+		{
+			return 0u;
+		}
+
+		reserve( text.size() + 1u );
+		auto & block = m_blocks.back();
+		auto begin = block.data.get() + m_used;
+		memcpy( begin, text.data(), text.size() );
+		begin[text.size()] = '\0';
+		auto result = block.base + uint32_t( m_used );
+		m_used += text.size() + 1u;
+		return result;
+	}
+
+	StringView NamePool::get( uint32_t position )const noexcept
+	{
+		if ( !position )
+		{
+			return StringView{};
+		}
+
+		// Les blocs sont rangés par position croissante.
+		auto it = std::upper_bound( m_blocks.begin()
+			, m_blocks.end()
+			, position
+			, []( uint32_t lhs, Block const & rhs )
+			{
+				return lhs < rhs.base;
+			} );
+		assert( it != m_blocks.begin() );
+		--it;
+		assert( position - it->base < it->capacity );
+		auto begin = it->data.get() + ( position - it->base );
+		return StringView{ begin, begin + strlen( begin ) };
+	}
+
+	void NamePool::reserve( size_t size )
+	{
+		// Le premier bloc commence par la chaîne vide.
+		if ( m_blocks.empty() )
+		{
+			doAllocate( std::max( size + 1u, BlockSize ) );
+		}
+		else if ( m_blocks.back().capacity - m_used < size )
+		{
+			doAllocate( std::max( size, BlockSize ) );
+		}
+	}
+
+	uint32_t NamePool::merge( NamePool && other )
+	{
+		uint32_t result{ 0u };
+
+		if ( other.m_blocks.empty() )
+		{
+			return result;
+		}
+
+		if ( m_blocks.empty() )
+		{
+			*this = std::move( other );
+		}
+		else
+		{
+			// Les blocs de l'autre réserve suivent les nôtres, son bloc
+			// courant devient le nôtre.
+			auto & last = m_blocks.back();
+			result = last.base + uint32_t( last.capacity );
+
+			for ( auto & block : other.m_blocks )
+			{
+				assert( uint64_t( result ) + block.base + block.capacity <= ~0u );
+				block.base += result;
+				m_blocks.push_back( std::move( block ) );
+			}
+
+			m_used = other.m_used;
+		}
+
+		other.clear();
+		return result;
+	}
+
+	bool NamePool::owns( StringView const & text )const noexcept
+	{
+		std::less< char const * > less;
+		return std::any_of( m_blocks.begin()
+			, m_blocks.end()
+			, [&text, &less]( Block const & block )
+			{
+				return !less( text.begin(), block.data.get() )
+					&& !less( block.data.get() + block.capacity, text.end() );
+			} );
+	}
+
+	void NamePool::clear()noexcept
+	{
+		m_blocks.clear();
+		m_used = 0u;
+	}
+
+	void NamePool::doAllocate( size_t size )
+	{
+		uint32_t base{ 0u };
+
+		if ( !m_blocks.empty() )
+		{
+			base = m_blocks.back().base + uint32_t( m_blocks.back().capacity );
+		}
+
+		assert( uint64_t( base ) + size <= ~0u );
+		m_blocks.push_back( { std::unique_ptr< char[] >{ new char[size] }, size, base } );
+		m_used = 0u;
+
+		if ( !base )
+		{
+			// La position 0 est réservée à la chaîne vide.
+			m_blocks.back().data[0] = '\0';
+			m_used = 1u;
+		}
+	}
+}
@@ -0,0 +1,132 @@
+/**
+*\file
+*	NamePool.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_NamePool_HPP___
+#define ___StarMapLib_NamePool_HPP___
+#pragma once
+
+#include "StringView.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Réserve de chaînes, stockées les unes à la suite des autres dans
+	*	de grands blocs.
+	*\remarks
+	*	Les blocs ne sont jamais déplacés ni libérés avant la réserve : les
+	*	vues retournées par intern() et get() restent donc valides quand la
+	*	réserve est déplacée, ou quand ses blocs sont repris par une autre
+	*	réserve.\n
+	*	Chaque chaîne est terminée par un zéro, et repérée par sa position
+	*	sur 32 bits, les blocs se suivant comme s'ils étaient contigus. La
+	*	position 0 est celle de la chaîne vide.\n
+	*	Le nombre d'allocations dépend du volume total des chaînes, pas de
+	*	leur nombre.
+	*/
+	class NamePool
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*/
+		NamePool() = default;
+		NamePool( NamePool const & ) = delete;
+		NamePool & operator=( NamePool const & ) = delete;
+		NamePool( NamePool && ) = default;
+		NamePool & operator=( NamePool && ) = default;
+		/**
+		*\brief
+		*	Copie une chaîne dans la réserve.
+		*\param[in] text
+		*	La chaîne.
+		*\return
+		*	La position de la copie.
+		*/
+		uint32_t add( StringView const & text );
+		/**
+		*\brief
+		*	Récupère une chaîne de la réserve.
+		*\param[in] position
+		*	La position de la chaîne, retournée par add().
+		*\return
+		*	La vue sur la chaîne.
+		*/
+		StringView get( uint32_t position )const noexcept;
+		/**
+		*\brief
+		*	Copie une chaîne dans la réserve.
+		*\param[in] text
+		*	La chaîne.
+		*\return
+		*	La vue sur la copie.
+		*/
+		inline StringView intern( StringView const & text )
+		{
+			return get( add( text ) );
+		}
+		/**
+		*\brief
+		*	S'assure que les prochaines chaînes, pour une taille totale
+		*	donnée, tiennent dans le bloc courant.
+		*\param[in] size
+		*	La taille totale des prochaines chaînes, zéros terminaux
+		*	compris.
+		*/
+		void reserve( size_t size );
+		/**
+		*\brief
+		*	Reprend les blocs d'une autre réserve, sans les copier.
+		*\remarks
+		*	Les vues sur les chaînes de \p other restent valides, leurs
+		*	positions sont décalées de la valeur retournée.
+		*\param[in] other
+		*	La réserve, vide en retour.
+		*\return
+		*	Le décalage à ajouter aux positions des chaînes de \p other.
+		*/
+		uint32_t merge( NamePool && other );
+		/**
+		*\brief
+		*	Dit si la vue donnée référence une chaîne de la réserve.
+		*\param[in] text
+		*	La vue.
+		*/
+		bool owns( StringView const & text )const noexcept;
+		/**
+		*\brief
+		*	Libère tous les blocs.
+		*/
+		void clear()noexcept;
+
+	private:
+		/**
+		*\brief
+		*	Un bloc de chaînes.
+		*/
+		struct Block
+		{
+			//! Les données du bloc.
+			std::unique_ptr< char[] > data;
+			//! La taille du bloc.
+			size_t capacity;
+			//! La position du début du bloc.
+			uint32_t base;
+		};
+
+	private:
+		void doAllocate( size_t size );
+
+	private:
+		//! Les blocs, le dernier étant le bloc courant.
+		std::vector< Block > m_blocks;
+		//! La taille utilisée dans le bloc courant.
+		size_t m_used{ 0u };
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+/**
+*\file
+*	ReadMonitor.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_ReadMonitor_HPP___
+#define ___StarMapLib_ReadMonitor_HPP___
+#pragma once
+
+#include <atomic>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Suit l'avancement d'une lecture de catalogue, et permet de
+	*	l'interrompre.
+	*\remarks
+	*	Les lecteurs annoncent la taille de leur travail via start(), puis
+	*	appellent advance() après chaque lot d'éléments lus, éventuellement
+	*	depuis plusieurs threads, et interrompent la lecture dès que
+	*	advance() retourne \p false.\n
+	*	Un ReadMonitor ne fait que référencer son état, il se copie donc
+	*	librement. Construit par défaut, il n'a pas d'état et n'interrompt
+	*	jamais la lecture.
+	*/
+	class ReadMonitor
+	{
+	public:
+		/**
+		*\brief
+		*	L'état partagé entre les lecteurs et celui qui les suit.
+		*/
+		struct State
+		{
+			//! Dit si la lecture doit être interrompue.
+			std::atomic< bool > cancelled{ false };
+			//! La taille du travail de la lecture en cours.
+			std::atomic< size_t > total{ 0u };
+			//! La part du travail effectuée.
+			std::atomic< size_t > done{ 0u };
+		};
+
+	public:
+		/**
+		*\brief
+		*	Constructeur, sans suivi.
+		*/
+		ReadMonitor() = default;
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] state
+		*	L'état mis à jour par les lecteurs, qui doit survivre à la
+		*	lecture.
+		*/
+		explicit ReadMonitor( State & state )noexcept
+			: m_state{ &state }
+		{
+		}
+		/**
+		*\brief
+		*	Démarre une lecture.
+		*\param[in] total
+		*	La taille du travail, dans l'unité choisie par le lecteur (octets,
+		*	éléments).
+		*/
+		inline void start( size_t total )const noexcept
+		{
+			if ( m_state )
+			{
+				m_state->done = 0u;
+				m_state->total = total;
+			}
+		}
+		/**
+		*\brief
+		*	Ajoute une part de travail effectuée.
+		*\param[in] count
+		*	La part effectuée, dans l'unité donnée à start().
+		*\return
+		*	\p false si la lecture doit être interrompue.
+		*/
+		inline bool advance( size_t count )const noexcept
+		{
+			if ( m_state )
+			{
+				m_state->done += count;
+				return !m_state->cancelled;
+			}
+
+			return true;
+		}
+		/**
+		*\return
+		*	\p true si la lecture doit être interrompue.
+		*/
+		inline bool cancelled()const noexcept
+		{
+			return m_state && m_state->cancelled;
+		}
+
+	private:
+		//! L'état, nul s'il n'y a pas de suivi.
+		State * m_state{ nullptr };
+	};
+}
+
+#endif
@@ -30,6 +30,22 @@ namespace starmap
 	{
 	}
 
+	ScreenEvents::ScreenEvents( OnScreenTap & onScreenTap
+		, OnScreenDoubleTap & onScreenDoubleTap
+		, OnScreenSingleMove & onScreenSingleMove
+		, OnScreenDoubleMove & onScreenDoubleMove
+		, OnScreenHover & onScreenHover )
+		: ScreenEvents{ onScreenTap
+			, onScreenDoubleTap
+			, onScreenSingleMove
+			, onScreenDoubleMove }
+	{
+		m_onScreenHover = onScreenHover.connect( std::bind
+			( &ScreenEvents::onScreenHover
+			, this
+			, std::placeholders::_1 ) );
+	}
+
 	void ScreenEvents::onScreenTap( gl::IVec2 const & coord )
 	{
 		onPick( coord );
@@ -50,4 +66,9 @@ namespace starmap
 	{
 		onSetZoomVelocity( -distanceOffset );
 	}
+
+	void ScreenEvents::onScreenHover( gl::IVec2 const & coord )
+	{
+		onHover( coord );
+	}
 }
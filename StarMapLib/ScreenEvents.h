@@ -46,6 +46,26 @@ namespace starmap
 			, OnScreenDoubleMove & onScreenDoubleMove );
 		/**
 		*\brief
+		*	Constructeur, avec le survol, pour les plateformes ayant un
+		*	pointeur.
+		*\param[in,out] onScreenTap
+		*	Evènement d'écran "cliqué", pour s'y abonner.
+		*\param[in,out] onScreenDoubleTap
+		*	Evènement d'écran "double cliqué", pour s'y abonner.
+		*\param[in,out] onScreenSingleMove
+		*	Evènement de déplacement avec un doigt, pour s'y abonner.
+		*\param[in,out] onScreenDoubleMove
+		*	Evènement de déplacement avec deux doigts, pour s'y abonner.
+		*\param[in,out] onScreenHover
+		*	Evènement de survol de l'écran par le pointeur, pour s'y abonner.
+		*/
+		ScreenEvents( OnScreenTap & onScreenTap
+			, OnScreenDoubleTap & onScreenDoubleTap
+			, OnScreenSingleMove & onScreenSingleMove
+			, OnScreenDoubleMove & onScreenDoubleMove
+			, OnScreenHover & onScreenHover );
+		/**
+		*\brief
 		*	D�finit la carte des étoiles.
 		*/
 		void starMap( StarMap * starmap )
@@ -62,6 +82,8 @@ namespace starmap
 		OnSetVelocity onSetVelocity;
 		//! Le signal émis lorsque l'on définit la vitesse de zoom de la caméra.
 		OnSetZoomVelocity onSetZoomVelocity;
+		//! Le signal émis lorsque le pointeur survole l'écran.
+		OnHover onHover;
 
 	private:
 		/**
@@ -96,6 +118,13 @@ namespace starmap
 		*/
 		void onScreenDoubleMove( gl::IVec2 const & diff
 			, float distanceOffset );
+		/**
+		*\brief
+		*	Traitement de l'évènement de survol de l'écran.
+		*\param[in] coord
+		*	La coordonnée du pointeur.
+		*/
+		void onScreenHover( gl::IVec2 const & coord );
 
 	private:
 		//! La connexion au signal émis lorsque l'on "clique" sur l'écran.
@@ -106,6 +135,8 @@ namespace starmap
 		render::Connection< OnScreenSingleMove > m_onScreenSingleMove;
 		//! La connexion au signal émis lorsque l'on effectue un déplacement avec deux doigts sur l'écran.
 		render::Connection< OnScreenDoubleMove > m_onScreenDoubleMove;
+		//! La connexion au signal émis lorsque le pointeur survole l'écran.
+		render::Connection< OnScreenHover > m_onScreenHover;
 		//! La carte.
 		StarMap * m_starmap;
 	};
@@ -0,0 +1,288 @@
+#include "SearchIndex.h"
+
+#include "StarCatalogue.h"
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	Le nombre maximal de formes correspondant à un préfixe qui sont
+		*	classées par pertinence. Au-delà, les premières formes dans
+		*	l'ordre alphabétique sont retenues.
+		*/
+		static size_t constexpr MaxRankedEntries = 4096u;
+		/**
+		*\brief
+		*	La taille minimale d'une recherche pour que les fautes de frappe
+		*	soient tolérées.
+		*/
+		static size_t constexpr MinFuzzySize = 3u;
+
+		inline bool isDigit( char c )noexcept
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		void doNormalise( StringView const & text
+			, std::string & result )
+		{
+			for ( auto c : text )
+			{
+				if ( c >= 'A' && c <= 'Z' )
+				{
+					result.push_back( char( c - 'A' + 'a' ) );
+				}
+				else if ( ( c >= 'a' && c <= 'z' )
+					|| isDigit( c )
+					|| uint8_t( c ) >= 0x80u )
+				{
+					result.push_back( c );
+				}
+			}
+		}
+
+		bool doIsNumber( StringView const & text )noexcept
+		{
+			return !text.empty()
+				&& std::all_of( text.begin(), text.end(), isDigit );
+		}
+
+		bool doStartsWith( StringView const & text
+			, StringView const & prefix )noexcept
+		{
+			return text.size() >= prefix.size()
+				&& std::equal( prefix.begin(), prefix.end(), text.begin() );
+		}
+
+		bool doLess( StringView const & lhs
+			, StringView const & rhs )noexcept
+		{
+			return std::lexicographical_compare( lhs.begin(), lhs.end()
+				, rhs.begin(), rhs.end() );
+		}
+		/**
+		*\brief
+		*	Les caractères des formes normalisées, utilisés pour générer les
+		*	variantes d'une recherche.
+		*/
+		static StringView const Alphabet{ "abcdefghijklmnopqrstuvwxyz0123456789" };
+
+		void doAppend( std::vector< uint32_t > & result
+			, uint32_t star
+			, uint32_t limit )
+		{
+			if ( result.size() < limit
+				&& std::find( result.begin(), result.end(), star ) == result.end() )
+			{
+				result.push_back( star );
+			}
+		}
+	}
+
+	void SearchIndex::build( StarCatalogue const & catalogue )
+	{
+		clear();
+		auto & stars = catalogue.stars();
+		m_entries.reserve( stars.size() * 2u );
+		uint32_t index{ 0u };
+
+		for ( auto & star : stars )
+		{
+			auto name = catalogue.name( star );
+			doAdd( name, index );
+
+			if ( doIsNumber( name ) )
+			{
+				doAdd( "hip", name, index );
+			}
+
+			auto member = catalogue.findMembership( star );
+
+			if ( member && !member->letter().empty() )
+			{
+				doAdd( member->letter(), member->constellation().name(), index );
+			}
+
+			++index;
+		}
+
+		std::sort( m_entries.begin()
+			, m_entries.end()
+			, [this]( Entry const & lhs, Entry const & rhs )
+			{
+				auto lhsKey = doGetKey( lhs );
+				auto rhsKey = doGetKey( rhs );
+				return doLess( lhsKey, rhsKey )
+					|| ( lhsKey == rhsKey && lhs.star < rhs.star );
+			} );
+	}
+
+	void SearchIndex::clear()
+	{
+		m_keys.clear();
+		m_entries.clear();
+	}
+
+	std::vector< uint32_t > SearchIndex::search( StringView const & text
+		, uint32_t limit )const
+	{
+		std::string query;
+		doNormalise( text, query );
+		std::vector< uint32_t > result;
+
+		if ( query.empty() || !limit )
+		{
+			return result;
+		}
+
+		result.reserve( limit );
+		auto range = doFindRange( query );
+
+		if ( size_t( std::distance( range.first, range.second ) ) <= MaxRankedEntries )
+		{
+			// Les correspondances exactes, puis les plus brillantes.
+			EntryArray ranked{ range.first, range.second };
+			std::sort( ranked.begin()
+				, ranked.end()
+				, [&query]( Entry const & lhs, Entry const & rhs )
+				{
+					auto lhsExact = lhs.size == query.size();
+					auto rhsExact = rhs.size == query.size();
+					return lhsExact != rhsExact
+						? lhsExact
+						: lhs.star < rhs.star;
+				} );
+
+			for ( auto & entry : ranked )
+			{
+				doAppend( result, entry.star, limit );
+			}
+		}
+		else
+		{
+			for ( auto it = range.first; it != range.second && result.size() < limit; ++it )
+			{
+				doAppend( result, it->star, limit );
+			}
+		}
+
+		if ( result.size() < limit
+			&& query.size() >= MinFuzzySize )
+		{
+			doSearchFuzzy( query, range, limit, result );
+		}
+
+		return result;
+	}
+
+	void SearchIndex::doAdd( StringView const & form
+		, uint32_t star )
+	{
+		doAdd( StringView{}, form, star );
+	}
+
+	void SearchIndex::doAdd( StringView const & prefix
+		, StringView const & form
+		, uint32_t star )
+	{
+		auto offset = m_keys.size();
+		doNormalise( prefix, m_keys );
+		doNormalise( form, m_keys );
+
+		if ( m_keys.size() > offset )
+		{
+			m_entries.push_back( { uint32_t( offset )
+				, uint32_t( m_keys.size() - offset )
+				, star } );
+		}
+	}
+
+	StringView SearchIndex::doGetKey( Entry const & entry )const noexcept
+	{
+		auto begin = m_keys.data() + entry.offset;
+		return StringView{ begin, begin + entry.size };
+	}
+
+	SearchIndex::EntryRange SearchIndex::doFindRange( StringView const & prefix )const
+	{
+		auto begin = std::lower_bound( m_entries.begin()
+			, m_entries.end()
+			, prefix
+			, [this]( Entry const & entry, StringView const & value )
+			{
+				return doLess( doGetKey( entry ), value );
+			} );
+		auto end = std::partition_point( begin
+			, m_entries.end()
+			, [this, &prefix]( Entry const & entry )
+			{
+				return doStartsWith( doGetKey( entry ), prefix );
+			} );
+		return { begin, end };
+	}
+
+	void SearchIndex::doSearchFuzzy( std::string const & query
+		, EntryRange const & exact
+		, uint32_t limit
+		, std::vector< uint32_t > & result )const
+	{
+		// Plutôt que de parcourir tout l'index, chaque variante de la
+		// recherche à une faute de frappe près (lettre en trop, inversée,
+		// remplacée ou manquante) est cherchée par dichotomie.
+		std::vector< uint32_t > fuzzy;
+		std::string variant;
+		auto collect = [this, &exact, &fuzzy]( std::string const & prefix )
+		{
+			auto range = doFindRange( prefix );
+			size_t count{ 0u };
+
+			for ( auto it = range.first;
+				it != range.second && count < MaxRankedEntries;
+				++it, ++count )
+			{
+				if ( it < exact.first || it >= exact.second )
+				{
+					fuzzy.push_back( it->star );
+				}
+			}
+		};
+
+		for ( size_t i = 0u; i < query.size(); ++i )
+		{
+			variant = query;
+			variant.erase( i, 1u );
+			collect( variant );
+
+			if ( i + 1u < query.size() && query[i] != query[i + 1u] )
+			{
+				variant = query;
+				std::swap( variant[i], variant[i + 1u] );
+				collect( variant );
+			}
+
+			for ( auto c : Alphabet )
+			{
+				if ( c != query[i] )
+				{
+					variant = query;
+					variant[i] = c;
+					collect( variant );
+				}
+
+				variant = query;
+				variant.insert( variant.begin() + i, c );
+				collect( variant );
+			}
+		}
+
+		std::sort( fuzzy.begin(), fuzzy.end() );
+		fuzzy.erase( std::unique( fuzzy.begin(), fuzzy.end() ), fuzzy.end() );
+
+		for ( auto star : fuzzy )
+		{
+			doAppend( result, star, limit );
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/**
+*\file
+*	SearchIndex.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SearchIndex_HPP___
+#define ___StarMapLib_SearchIndex_HPP___
+#pragma once
+
+#include "StringView.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Index de recherche des étoiles d'un catalogue, par nom.
+	*\remarks
+	*	Les noms sont normalisés (minuscules, sans espaces ni ponctuation)
+	*	puis triés dans un tableau de préfixes, une recherche par préfixe se
+	*	fait donc par dichotomie.\n
+	*	Chaque étoile y est présente sous plusieurs formes :
+	*\li son nom (nom propre, identifiant Gliese ou Hipparcos),
+	*\li "hip" suivi de son identifiant, si son nom est un identifiant
+	*	Hipparcos,
+	*\li sa lettre de Bayer suivie du nom de sa constellation, si elle
+	*	appartient à une constellation ("alpha1centauri").
+	*/
+	class SearchIndex
+	{
+	public:
+		/**
+		*\brief
+		*	Construit l'index depuis un catalogue trié.
+		*\param[in] catalogue
+		*	Le catalogue.
+		*/
+		void build( StarCatalogue const & catalogue );
+		/**
+		*\brief
+		*	Vide l'index.
+		*/
+		void clear();
+		/**
+		*\brief
+		*	Recherche les étoiles dont un des noms commence par le texte donné.
+		*\remarks
+		*	La casse, les espaces et la ponctuation sont ignorés.\n
+		*	Les correspondances exactes viennent en premier, puis les étoiles
+		*	les plus brillantes. Si moins de \p limit étoiles sont trouvées,
+		*	les noms dont le préfixe est à une faute de frappe près du texte
+		*	(une lettre ajoutée, manquante, remplacée ou inversée) sont
+		*	ajoutés aux résultats.
+		*\param[in] text
+		*	Le texte recherché.
+		*\param[in] limit
+		*	Le nombre maximal de résultats.
+		*\return
+		*	Les index des étoiles trouvées, dans le catalogue trié.
+		*/
+		std::vector< uint32_t > search( StringView const & text
+			, uint32_t limit )const;
+		/**
+		*\return
+		*	\p true si l'index est vide.
+		*/
+		inline bool empty()const noexcept
+		{
+			return m_entries.empty();
+		}
+
+	private:
+		/**
+		*\brief
+		*	Une forme du nom d'une étoile.
+		*/
+		struct Entry
+		{
+			//! La position de la forme normalisée dans m_keys.
+			uint32_t offset;
+			//! La taille de la forme normalisée.
+			uint32_t size;
+			//! L'index de l'étoile.
+			uint32_t star;
+		};
+		//! Un tableau de formes.
+		using EntryArray = std::vector< Entry >;
+		//! Un intervalle de formes.
+		using EntryRange = std::pair< EntryArray::const_iterator, EntryArray::const_iterator >;
+
+		void doAdd( StringView const & form
+			, uint32_t star );
+		void doAdd( StringView const & prefix
+			, StringView const & form
+			, uint32_t star );
+		StringView doGetKey( Entry const & entry )const noexcept;
+		EntryRange doFindRange( StringView const & prefix )const;
+		void doSearchFuzzy( std::string const & query
+			, EntryRange const & exact
+			, uint32_t limit
+			, std::vector< uint32_t > & result )const;
+
+	private:
+		//! Les formes normalisées, accolées.
+		std::string m_keys;
+		//! Les formes, triées par forme normalisée puis par index d'étoile.
+		EntryArray m_entries;
+	};
+}
+
+#endif
@@ -0,0 +1,323 @@
+#include "SeparatorScanner.h"
+
+#if defined( __AVX2__ )
+#	define StarMap_ScanAVX2 1
+#	include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#	define StarMap_ScanSSE2 1
+#	include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#	define StarMap_ScanNEON 1
+#	include <arm_neon.h>
+#endif
+
+#if defined( _MSC_VER )
+#	include <intrin.h>
+#endif
+
+namespace starmap
+{
+	namespace
+	{
+		static size_t constexpr BlockSize = 64u;
+		/**
+		*\brief
+		*	Les masques des trois caractères recherchés, pour un bloc.
+		*/
+		struct BlockMasks
+		{
+			uint64_t a;
+			uint64_t b;
+			uint64_t c;
+		};
+
+		inline uint32_t doCountTrailingZeros( uint64_t value )noexcept
+		{
+			assert( value != 0u );
+#if defined( _MSC_VER ) && defined( _M_X64 )
+			unsigned long result;
+			_BitScanForward64( &result, value );
+			return uint32_t( result );
+#elif defined( _MSC_VER )
+			unsigned long result;
+
+			if ( uint32_t( value ) )
+			{
+				_BitScanForward( &result, uint32_t( value ) );
+				return uint32_t( result );
+			}
+
+			_BitScanForward( &result, uint32_t( value >> 32 ) );
+			return uint32_t( result ) + 32u;
+#else
+			return uint32_t( __builtin_ctzll( value ) );
+#endif
+		}
+
+#if StarMap_ScanAVX2
+
+		inline uint64_t doMatch( __m256i const & lo
+			, __m256i const & hi
+			, char c )noexcept
+		{
+			auto ref = _mm256_set1_epi8( c );
+			auto mlo = uint32_t( _mm256_movemask_epi8( _mm256_cmpeq_epi8( lo, ref ) ) );
+			auto mhi = uint32_t( _mm256_movemask_epi8( _mm256_cmpeq_epi8( hi, ref ) ) );
+			return uint64_t( mlo ) | ( uint64_t( mhi ) << 32 );
+		}
+
+		BlockMasks doScanBlock( char const * data
+			, char const * chars )noexcept
+		{
+			auto lo = _mm256_loadu_si256( reinterpret_cast< __m256i const * >( data ) );
+			auto hi = _mm256_loadu_si256( reinterpret_cast< __m256i const * >( data + 32 ) );
+			return BlockMasks
+			{
+				doMatch( lo, hi, chars[0] ),
+				doMatch( lo, hi, chars[1] ),
+				doMatch( lo, hi, chars[2] ),
+			};
+		}
+
+#elif StarMap_ScanSSE2
+
+		inline uint64_t doMatch( __m128i const ( & data )[4]
+			, char c )noexcept
+		{
+			auto ref = _mm_set1_epi8( c );
+			uint64_t result{ 0u };
+
+			for ( auto i = 0u; i < 4u; ++i )
+			{
+				auto mask = uint32_t( _mm_movemask_epi8( _mm_cmpeq_epi8( data[i], ref ) ) );
+				result |= uint64_t( mask ) << ( i * 16u );
+			}
+
+			return result;
+		}
+
+		BlockMasks doScanBlock( char const * data
+			, char const * chars )noexcept
+		{
+			__m128i const blocks[4]
+			{
+				_mm_loadu_si128( reinterpret_cast< __m128i const * >( data ) ),
+				_mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 16 ) ),
+				_mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 32 ) ),
+				_mm_loadu_si128( reinterpret_cast< __m128i const * >( data + 48 ) ),
+			};
+			return BlockMasks
+			{
+				doMatch( blocks, chars[0] ),
+				doMatch( blocks, chars[1] ),
+				doMatch( blocks, chars[2] ),
+			};
+		}
+
+#elif StarMap_ScanNEON
+
+		inline uint64_t doMoveMask( uint8x16_t value )noexcept
+		{
+			static uint8_t const Bits[16]
+			{
+				1, 2, 4, 8, 16, 32, 64, 128,
+				1, 2, 4, 8, 16, 32, 64, 128,
+			};
+			value = vandq_u8( value, vld1q_u8( Bits ) );
+			auto lo = vget_low_u8( value );
+			auto hi = vget_high_u8( value );
+			// Les bits étant distincts, les sommes par paires valent des OU.
+			lo = vpadd_u8( lo, lo );
+			lo = vpadd_u8( lo, lo );
+			lo = vpadd_u8( lo, lo );
+			hi = vpadd_u8( hi, hi );
+			hi = vpadd_u8( hi, hi );
+			hi = vpadd_u8( hi, hi );
+			return uint64_t( vget_lane_u8( lo, 0 ) )
+				| ( uint64_t( vget_lane_u8( hi, 0 ) ) << 8 );
+		}
+
+		inline uint64_t doMatch( uint8x16_t const ( & data )[4]
+			, char c )noexcept
+		{
+			auto ref = vdupq_n_u8( uint8_t( c ) );
+			uint64_t result{ 0u };
+
+			for ( auto i = 0u; i < 4u; ++i )
+			{
+				result |= doMoveMask( vceqq_u8( data[i], ref ) ) << ( i * 16u );
+			}
+
+			return result;
+		}
+
+		BlockMasks doScanBlock( char const * data
+			, char const * chars )noexcept
+		{
+			auto bytes = reinterpret_cast< uint8_t const * >( data );
+			uint8x16_t const blocks[4]
+			{
+				vld1q_u8( bytes ),
+				vld1q_u8( bytes + 16 ),
+				vld1q_u8( bytes + 32 ),
+				vld1q_u8( bytes + 48 ),
+			};
+			return BlockMasks
+			{
+				doMatch( blocks, chars[0] ),
+				doMatch( blocks, chars[1] ),
+				doMatch( blocks, chars[2] ),
+			};
+		}
+
+#endif
+
+		BlockMasks doScanBlockScalar( char const * data
+			, char const * chars )noexcept
+		{
+			BlockMasks result{ 0u, 0u, 0u };
+
+			for ( auto i = 0u; i < BlockSize; ++i )
+			{
+				auto bit = uint64_t( 1u ) << i;
+				result.a |= data[i] == chars[0] ? bit : 0u;
+				result.b |= data[i] == chars[1] ? bit : 0u;
+				result.c |= data[i] == chars[2] ? bit : 0u;
+			}
+
+			return result;
+		}
+
+#if !StarMap_ScanAVX2 && !StarMap_ScanSSE2 && !StarMap_ScanNEON
+
+		BlockMasks doScanBlock( char const * data
+			, char const * chars )noexcept
+		{
+			return doScanBlockScalar( data, chars );
+		}
+
+#endif
+
+		inline BlockMasks doScan( char const * data
+			, char const * chars
+			, bool vectorised )noexcept
+		{
+			return vectorised
+				? doScanBlock( data, chars )
+				: doScanBlockScalar( data, chars );
+		}
+	}
+
+	SeparatorScanner::SeparatorScanner( char const * begin
+		, char const * end
+		, char field
+		, char record
+		, char quote
+		, bool vectorised )
+		: m_end{ end }
+		, m_block{ begin }
+		, m_chars{ field, record, quote }
+		, m_vectorised{ vectorised }
+	{
+		if ( m_block != m_end )
+		{
+			doLoadBlock();
+		}
+	}
+
+	Separator SeparatorScanner::next( char const *& position )
+	{
+		auto all = m_field | m_record | m_quote;
+
+		while ( !all )
+		{
+			// Le bloc n'est avancé qu'une fois la fin vérifiée, afin de ne
+			// jamais pointer au delà de la fin du texte.
+			if ( size_t( m_end - m_block ) <= BlockSize )
+			{
+				m_block = m_end;
+				position = m_end;
+				return Separator::eEnd;
+			}
+
+			m_block += BlockSize;
+			doLoadBlock();
+			all = m_field | m_record | m_quote;
+		}
+
+		auto bit = doCountTrailingZeros( all );
+		auto mask = uint64_t( 1u ) << bit;
+		position = m_block + bit;
+		Separator result = ( m_field & mask )
+			? Separator::eField
+			: ( ( m_record & mask )
+				? Separator::eRecord
+				: Separator::eQuote );
+		m_field &= ~mask;
+		m_record &= ~mask;
+		m_quote &= ~mask;
+		return result;
+	}
+
+	Separator SeparatorScanner::nextRecord( char const *& position )
+	{
+		while ( !m_record )
+		{
+			if ( size_t( m_end - m_block ) <= BlockSize )
+			{
+				m_block = m_end;
+				m_field = 0u;
+				m_quote = 0u;
+				position = m_end;
+				return Separator::eEnd;
+			}
+
+			m_block += BlockSize;
+			doLoadBlock();
+		}
+
+		auto bit = doCountTrailingZeros( m_record );
+		auto mask = uint64_t( 1u ) << bit;
+		auto consumed = mask | ( mask - 1u );
+		position = m_block + bit;
+		m_field &= ~consumed;
+		m_record &= ~consumed;
+		m_quote &= ~consumed;
+		return Separator::eRecord;
+	}
+
+	char const * SeparatorScanner::instructionSet()
+	{
+#if StarMap_ScanAVX2
+		return "AVX2";
+#elif StarMap_ScanSSE2
+		return "SSE2";
+#elif StarMap_ScanNEON
+		return "NEON";
+#else
+		return "Scalar";
+#endif
+	}
+
+	void SeparatorScanner::doLoadBlock()
+	{
+		BlockMasks masks;
+
+		if ( size_t( m_end - m_block ) >= BlockSize )
+		{
+			masks = doScan( m_block, m_chars, m_vectorised );
+		}
+		else
+		{
+			// Dernier bloc incomplet : on le complète avec des zéros, afin de
+			// ne pas lire au delà de la fin du texte.
+			char tail[BlockSize] = { 0 };
+			std::copy( m_block, m_end, tail );
+			masks = doScan( tail, m_chars, m_vectorised );
+		}
+
+		m_field = masks.a;
+		m_record = masks.b;
+		m_quote = masks.c;
+	}
+}
@@ -0,0 +1,114 @@
+/**
+*\file
+*	SeparatorScanner.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SeparatorScanner_HPP___
+#define ___StarMapLib_SeparatorScanner_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les types de séparateurs repérés par SeparatorScanner.
+	*/
+	enum class Separator
+	{
+		//! Séparateur de champs.
+		eField,
+		//! Séparateur d'enregistrements.
+		eRecord,
+		//! Guillemet.
+		eQuote,
+		//! Fin du texte atteinte.
+		eEnd,
+	};
+	/**
+	*\brief
+	*	Parcourt un texte à la recherche de séparateurs de champs et
+	*	d'enregistrements.
+	*\remarks
+	*	Le texte est traité par blocs de 64 octets : pour chaque bloc, un
+	*	masque de bits est construit en une passe pour chaque type de
+	*	séparateur, en utilisant SSE2/AVX2 ou NEON lorsqu'ils sont
+	*	disponibles à la compilation. Les séparateurs sont ensuite énumérés
+	*	à partir des masques, sans relire les octets.
+	*/
+	class SeparatorScanner
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] begin, end
+		*	Le texte à parcourir.
+		*\param[in] field
+		*	Le séparateur de champs.
+		*\param[in] record
+		*	Le séparateur d'enregistrements.
+		*\param[in] quote
+		*	Le caractère de guillemet.
+		*\param[in] vectorised
+		*	\p false pour construire les masques sans SSE2/AVX2/NEON, afin
+		*	de comparer les deux versions.
+		*/
+		SeparatorScanner( char const * begin
+			, char const * end
+			, char field = ','
+			, char record = '\n'
+			, char quote = '"'
+			, bool vectorised = true );
+		/**
+		*\brief
+		*	Récupère le prochain séparateur.
+		*\param[out] position
+		*	Reçoit la position du séparateur, \p end si la fin du texte est
+		*	atteinte.
+		*\return
+		*	Le type du séparateur trouvé.
+		*/
+		Separator next( char const *& position );
+		/**
+		*\brief
+		*	Saute au prochain séparateur d'enregistrements, en ignorant les
+		*	séparateurs de champs et les guillemets qui le précèdent.
+		*\param[out] position
+		*	Reçoit la position du séparateur, \p end si la fin du texte est
+		*	atteinte.
+		*\return
+		*	Separator::eRecord, ou Separator::eEnd.
+		*/
+		Separator nextRecord( char const *& position );
+		/**
+		*\return
+		*	Le nom du jeu d'instructions utilisé pour construire les masques.
+		*/
+		static char const * instructionSet();
+
+	private:
+		void doLoadBlock();
+
+	private:
+		//! La fin du texte.
+		char const * m_end;
+		//! Le début du bloc courant.
+		char const * m_block;
+		//! Les caractères recherchés.
+		char m_chars[3];
+		//! Dit si les masques sont construits avec le jeu d'instructions
+		//! de instructionSet().
+		bool m_vectorised;
+		//! Les séparateurs de champs du bloc courant non encore énumérés.
+		uint64_t m_field{ 0u };
+		//! Les séparateurs d'enregistrements du bloc courant non encore énumérés.
+		uint64_t m_record{ 0u };
+		//! Les guillemets du bloc courant non encore énumérés.
+		uint64_t m_quote{ 0u };
+	};
+}
+
+#endif
@@ -0,0 +1,569 @@
+#include "SkyIndex.h"
+
+#include "StarCatalogue.h"
+
+#include <RenderLib/Frustum.h>
+
+#include <queue>
+
+namespace starmap
+{
+	namespace
+	{
+		//! pi.
+		static float constexpr Pi = 3.14159265358979f;
+		//! Le nombre moyen d'étoiles visé par feuille.
+		static uint32_t constexpr LeafSize = 32u;
+		//! Les niveaux minimal et maximal des feuilles.
+		static uint32_t constexpr MinLevel = 1u;
+		static uint32_t constexpr MaxLevel = 8u;
+		//! La marge ajoutée aux calottes des noeuds, couvrant l'arrondi des
+		//! directions recompactées par les tampons de billboards.
+		static float constexpr CapMargin = 5.0e-4f;
+		/**
+		*\brief
+		*	Une calotte, à classer via ses noeuds puis à tester par étoile.
+		*/
+		struct ConeRegion
+		{
+			explicit ConeRegion( SkyCap const & cap )
+				: cap{ cap }
+				, cosine{ std::cos( cap.radius ) }
+			{
+			}
+
+			render::Intersection classify( SkyCap const & node )const
+			{
+				if ( !starmap::intersects( cap, node ) )
+				{
+					return render::Intersection::eOut;
+				}
+
+				return starmap::contains( cap, node )
+					? render::Intersection::eIn
+					: render::Intersection::eIntersect;
+			}
+
+			bool contains( gl::Vec3 const & direction )const
+			{
+				return cap.radius >= Pi
+					|| gl::dot( cap.centre, direction ) >= cosine;
+			}
+
+			SkyCap cap;
+			float cosine;
+		};
+		/**
+		*\brief
+		*	Un frustum, les noeuds y étant classés via la sphère englobant
+		*	leurs étoiles.
+		*/
+		struct FrustumRegion
+		{
+			render::Intersection classify( SkyCap const & node )const
+			{
+				auto sphere = boundingSphere( node, StarDistance );
+				return frustum.intersects( sphere.centre, sphere.radius );
+			}
+
+			bool contains( gl::Vec3 const & direction )const
+			{
+				return frustum.visible( direction * StarDistance );
+			}
+
+			render::Frustum const & frustum;
+		};
+		/**
+		*\brief
+		*	Un noeud ou une entrée d'une feuille, à parcourir par index
+		*	d'étoile croissant.
+		*/
+		struct Candidate
+		{
+			//! La plus brillante étoile du noeud, ou l'étoile de l'entrée.
+			uint32_t star;
+			uint32_t level;
+			uint32_t node;
+			//! L'entrée, pour une feuille.
+			uint32_t entry;
+			//! Dit si le noeud est entièrement dans la zone cherchée.
+			bool inside;
+		};
+
+		struct CandidateGreater
+		{
+			bool operator()( Candidate const & lhs
+				, Candidate const & rhs )const
+			{
+				return lhs.star > rhs.star;
+			}
+		};
+		/**
+		*\brief
+		*	Un noeud, ou une entrée, à parcourir par distance croissante.
+		*/
+		struct Neighbour
+		{
+			//! La distance minimale des étoiles du noeud, ou celle de
+			//! l'étoile de l'entrée.
+			float distance;
+			uint32_t level;
+			uint32_t node;
+			//! L'entrée, ~0u pour un noeud.
+			uint32_t entry;
+		};
+
+		struct NeighbourGreater
+		{
+			bool operator()( Neighbour const & lhs
+				, Neighbour const & rhs )const
+			{
+				return lhs.distance > rhs.distance;
+			}
+		};
+		/**
+		*\brief
+		*	Calcule la calotte de centre la somme donnée, et de rayon nul.
+		*/
+		SkyCap doMakeCap( gl::Vec3 const & sum )
+		{
+			auto length = gl::length( sum );
+
+			// Des étoiles réparties sur toute la sphère n'ont pas de
+			// direction moyenne.
+			if ( length <= std::numeric_limits< float >::epsilon() )
+			{
+				return SkyCap{ gl::Vec3{ 0, 0, 1 }, Pi };
+			}
+
+			return SkyCap{ sum / length, 0.0f };
+		}
+	}
+
+	void SkyIndex::build( StarCatalogue const & catalogue )
+	{
+		clear();
+		auto & stars = catalogue.stars();
+
+		if ( stars.empty() )
+		{
+			return;
+		}
+
+		auto count = uint32_t( stars.size() );
+		m_level = MinLevel;
+
+		while ( m_level < MaxLevel
+			&& ( uint64_t( count ) >> ( 2u * m_level ) ) > LeafSize )
+		{
+			++m_level;
+		}
+
+		// Les étoiles sont rangées par feuille via un tri par comptage,
+		// stable : elles restent triées par magnitude dans chaque feuille.
+		auto leaves = tileCount( m_level );
+		std::vector< uint32_t > tiles( count );
+		m_firsts.assign( leaves + 1u, 0u );
+
+		for ( uint32_t i = 0u; i < count; ++i )
+		{
+			tiles[i] = tileIndex( stars[i].packed().position, m_level );
+			++m_firsts[tiles[i] + 1u];
+		}
+
+		for ( uint32_t leaf = 0u; leaf < leaves; ++leaf )
+		{
+			m_firsts[leaf + 1u] += m_firsts[leaf];
+		}
+
+		std::vector< uint32_t > cursors( m_firsts.begin(), m_firsts.end() - 1 );
+		m_stars.resize( count );
+		m_directions.resize( count );
+
+		for ( uint32_t i = 0u; i < count; ++i )
+		{
+			auto entry = cursors[tiles[i]]++;
+			m_stars[entry] = i;
+			m_directions[entry] = stars[i].packed().position;
+		}
+
+		doFitCaps();
+	}
+
+	bool SkyIndex::update( StarCatalogue const & catalogue )
+	{
+		auto & stars = catalogue.stars();
+		assert( stars.size() == m_stars.size() );
+		auto tiled = true;
+
+		if ( m_stars.empty() )
+		{
+			return tiled;
+		}
+
+		for ( uint32_t leaf = 0u; leaf < tileCount( m_level ); ++leaf )
+		{
+			for ( auto entry = m_firsts[leaf]; entry < m_firsts[leaf + 1u]; ++entry )
+			{
+				auto & direction = stars[m_stars[entry]].packed().position;
+				tiled = tiled && tileIndex( direction, m_level ) == leaf;
+				m_directions[entry] = direction;
+			}
+		}
+
+		doFitCaps();
+		return tiled;
+	}
+
+	void SkyIndex::clear()
+	{
+		m_level = 0u;
+		m_firsts.clear();
+		m_stars.clear();
+		m_directions.clear();
+		m_caps.clear();
+		m_brightest.clear();
+	}
+
+	void SkyIndex::cone( SkyCap const & cap
+		, RangeArray & result )const
+	{
+		doCollect( ConeRegion{ cap }, result );
+	}
+
+	void SkyIndex::frustum( render::Frustum const & frustum
+		, RangeArray & result )const
+	{
+		doCollect( FrustumRegion{ frustum }, result );
+	}
+
+	std::vector< uint32_t > SkyIndex::brightest( SkyCap const & cap
+		, uint32_t count
+		, uint32_t limit )const
+	{
+		return doFindBrightest( ConeRegion{ cap }, count, limit );
+	}
+
+	std::vector< uint32_t > SkyIndex::brightest( render::Frustum const & frustum
+		, uint32_t count
+		, uint32_t limit )const
+	{
+		return doFindBrightest( FrustumRegion{ frustum }, count, limit );
+	}
+
+	std::vector< uint32_t > SkyIndex::nearest( SkyCap const & cap
+		, uint32_t count
+		, uint32_t limit )const
+	{
+		std::vector< uint32_t > result;
+
+		if ( empty() || !count )
+		{
+			return result;
+		}
+
+		std::priority_queue< Neighbour
+			, std::vector< Neighbour >
+			, NeighbourGreater > queue;
+		auto push = [this, &cap, &queue, limit]( uint32_t level
+			, uint32_t node )
+		{
+			if ( m_brightest[level][node] >= limit )
+			{
+				return;
+			}
+
+			auto & bounds = m_caps[level][node];
+			auto distance = std::max( 0.0f
+				, angle( cap.centre, bounds.centre ) - bounds.radius );
+
+			if ( distance <= cap.radius )
+			{
+				queue.push( Neighbour{ distance, level, node, ~0u } );
+			}
+		};
+		push( 0u, 0u );
+
+		while ( !queue.empty()
+			&& result.size() < count )
+		{
+			auto neighbour = queue.top();
+			queue.pop();
+
+			if ( neighbour.entry != ~0u )
+			{
+				result.push_back( m_stars[neighbour.entry] );
+			}
+			else if ( neighbour.level < m_level )
+			{
+				for ( auto child = neighbour.node * 4u; child < neighbour.node * 4u + 4u; ++child )
+				{
+					push( neighbour.level + 1u, child );
+				}
+			}
+			else
+			{
+				// Les étoiles d'une feuille étant triées par magnitude, les
+				// suivantes sont aussi au-delà de la limite.
+				auto last = m_firsts[neighbour.node + 1u];
+
+				for ( auto entry = m_firsts[neighbour.node];
+					entry < last && m_stars[entry] < limit;
+					++entry )
+				{
+					auto distance = angle( cap.centre, gl::unpackOctahedral( m_directions[entry] ) );
+
+					if ( distance <= cap.radius )
+					{
+						queue.push( Neighbour{ distance, neighbour.level, neighbour.node, entry } );
+					}
+				}
+			}
+		}
+
+		return result;
+	}
+
+	SkyIndex::Range SkyIndex::node( uint32_t level
+		, uint32_t node )const
+	{
+		assert( level <= m_level );
+		auto shift = 2u * ( m_level - level );
+		return Range{ m_firsts[node << shift]
+			, m_firsts[( node + 1u ) << shift]
+			, false };
+	}
+
+	template< typename RegionT >
+	void SkyIndex::doCollect( RegionT const & region
+		, RangeArray & result )const
+	{
+		result.clear();
+
+		if ( !empty() )
+		{
+			doCollect( region, 0u, 0u, result );
+		}
+	}
+
+	template< typename RegionT >
+	void SkyIndex::doCollect( RegionT const & region
+		, uint32_t level
+		, uint32_t node
+		, RangeArray & result )const
+	{
+		if ( m_brightest[level][node] == ~0u )
+		{
+			return;
+		}
+
+		auto intersection = region.classify( m_caps[level][node] );
+
+		if ( intersection == render::Intersection::eOut )
+		{
+			return;
+		}
+
+		if ( intersection == render::Intersection::eIn
+			|| level == m_level )
+		{
+			auto range = this->node( level, node );
+			range.partial = intersection != render::Intersection::eIn;
+			doAdd( range, result );
+			return;
+		}
+
+		for ( auto child = node * 4u; child < node * 4u + 4u; ++child )
+		{
+			doCollect( region, level + 1u, child, result );
+		}
+	}
+
+	template< typename RegionT >
+	std::vector< uint32_t > SkyIndex::doFindBrightest( RegionT const & region
+		, uint32_t count
+		, uint32_t limit )const
+	{
+		std::vector< uint32_t > result;
+
+		if ( empty() || !count )
+		{
+			return result;
+		}
+
+		// Un noeud est candidat avec sa plus brillante étoile, une feuille
+		// l'est avec son entrée courante : les étoiles sortent de la file
+		// par index croissant, et une feuille n'est parcourue que tant
+		// qu'elle contient la prochaine plus brillante étoile.
+		std::priority_queue< Candidate
+			, std::vector< Candidate >
+			, CandidateGreater > queue;
+		auto push = [this, &region, &queue]( uint32_t level
+			, uint32_t node
+			, bool inside )
+		{
+			auto star = m_brightest[level][node];
+
+			if ( star == ~0u )
+			{
+				return;
+			}
+
+			if ( !inside )
+			{
+				auto intersection = region.classify( m_caps[level][node] );
+
+				if ( intersection == render::Intersection::eOut )
+				{
+					return;
+				}
+
+				inside = intersection == render::Intersection::eIn;
+			}
+
+			queue.push( Candidate{ star
+				, level
+				, node
+				, level == m_level ? m_firsts[node] : 0u
+				, inside } );
+		};
+		push( 0u, 0u, false );
+
+		while ( !queue.empty()
+			&& result.size() < count )
+		{
+			auto candidate = queue.top();
+			queue.pop();
+
+			if ( candidate.star >= limit )
+			{
+				break;
+			}
+
+			if ( candidate.level < m_level )
+			{
+				for ( auto child = candidate.node * 4u; child < candidate.node * 4u + 4u; ++child )
+				{
+					push( candidate.level + 1u, child, candidate.inside );
+				}
+			}
+			else
+			{
+				if ( candidate.inside
+					|| region.contains( gl::unpackOctahedral( m_directions[candidate.entry] ) ) )
+				{
+					result.push_back( candidate.star );
+				}
+
+				if ( ++candidate.entry < m_firsts[candidate.node + 1u] )
+				{
+					candidate.star = m_stars[candidate.entry];
+					queue.push( candidate );
+				}
+			}
+		}
+
+		return result;
+	}
+
+	void SkyIndex::doAdd( Range const & range
+		, RangeArray & result )const
+	{
+		if ( !result.empty()
+			&& result.back().last == range.first
+			&& result.back().partial == range.partial )
+		{
+			result.back().last = range.last;
+		}
+		else
+		{
+			result.push_back( range );
+		}
+	}
+
+	void SkyIndex::doFitCaps()
+	{
+		// Les calottes des feuilles sont ajustées à leurs étoiles, celles des
+		// autres noeuds à celles de leurs filles.
+		auto leaves = tileCount( m_level );
+		m_caps.resize( m_level + 1u );
+		m_brightest.resize( m_level + 1u );
+		std::vector< gl::Vec3 > sums( leaves );
+		m_caps[m_level].assign( leaves, SkyCap{ gl::Vec3{ 0, 0, 1 }, -1.0f } );
+		m_brightest[m_level].assign( leaves, ~0u );
+
+		for ( uint32_t leaf = 0u; leaf < leaves; ++leaf )
+		{
+			auto first = m_firsts[leaf];
+			auto last = m_firsts[leaf + 1u];
+
+			if ( first == last )
+			{
+				continue;
+			}
+
+			for ( auto entry = first; entry < last; ++entry )
+			{
+				sums[leaf] += gl::unpackOctahedral( m_directions[entry] );
+			}
+
+			auto cap = doMakeCap( sums[leaf] );
+
+			if ( cap.radius < Pi )
+			{
+				for ( auto entry = first; entry < last; ++entry )
+				{
+					cap.radius = std::max( cap.radius
+						, angle( cap.centre, gl::unpackOctahedral( m_directions[entry] ) ) );
+				}
+
+				cap.radius += CapMargin;
+			}
+
+			m_caps[m_level][leaf] = cap;
+			m_brightest[m_level][leaf] = m_stars[first];
+		}
+
+		for ( auto level = m_level; level > 0u; --level )
+		{
+			auto nodes = tileCount( level - 1u );
+			std::vector< gl::Vec3 > parents( nodes );
+			auto & children = m_caps[level];
+			auto & caps = m_caps[level - 1u];
+			auto & brightest = m_brightest[level - 1u];
+			caps.assign( nodes, SkyCap{ gl::Vec3{ 0, 0, 1 }, -1.0f } );
+			brightest.assign( nodes, ~0u );
+
+			for ( uint32_t node = 0u; node < nodes; ++node )
+			{
+				for ( auto child = node * 4u; child < node * 4u + 4u; ++child )
+				{
+					parents[node] += sums[child];
+					brightest[node] = std::min( brightest[node]
+						, m_brightest[level][child] );
+				}
+
+				if ( brightest[node] == ~0u )
+				{
+					continue;
+				}
+
+				auto cap = doMakeCap( parents[node] );
+
+				for ( auto child = node * 4u; child < node * 4u + 4u && cap.radius < Pi; ++child )
+				{
+					if ( m_brightest[level][child] != ~0u )
+					{
+						cap.radius = std::max( cap.radius
+							, angle( cap.centre, children[child].centre ) + children[child].radius );
+					}
+				}
+
+				cap.radius = std::min( cap.radius, Pi );
+				caps[node] = cap;
+			}
+
+			sums = std::move( parents );
+		}
+	}
+}
@@ -0,0 +1,269 @@
+/**
+*\file
+*	SkyIndex.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SkyIndex_HPP___
+#define ___StarMapLib_SkyIndex_HPP___
+#pragma once
+
+#include "SkyTiling.h"
+
+namespace render
+{
+	class Frustum;
+}
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Index spatial des étoiles d'un catalogue, sur la sphère céleste.
+	*\remarks
+	*	Les étoiles sont réparties dans les tuiles d'un niveau donné (voir
+	*	SkyTiling.h), puis rangées par tuile dans l'ordre de Morton : les
+	*	étoiles de chaque noeud du quadtree, à tout niveau, forment ainsi un
+	*	intervalle contigu d'entrées. Dans une tuile, les étoiles restent
+	*	triées par magnitude.\n
+	*	Chaque noeud garde une calotte englobant ses étoiles, ajustée à
+	*	celles-ci, et l'index de sa plus brillante étoile. Les requêtes
+	*	descendent le quadtree depuis la sphère entière, en ne testant les
+	*	étoiles une à une que dans les feuilles coupant la zone cherchée.
+	*/
+	class SkyIndex
+	{
+	public:
+		/**
+		*\brief
+		*	Un intervalle d'entrées de l'index.
+		*/
+		struct Range
+		{
+			//! La première entrée.
+			uint32_t first;
+			//! L'entrée suivant la dernière.
+			uint32_t last;
+			//! Dit si seule une partie des étoiles de l'intervalle est dans
+			//! la zone cherchée, elles doivent alors être testées une à une.
+			bool partial;
+		};
+		//! Un tableau d'intervalles.
+		using RangeArray = std::vector< Range >;
+
+	public:
+		/**
+		*\brief
+		*	Construit l'index depuis un catalogue trié.
+		*\param[in] catalogue
+		*	Le catalogue.
+		*/
+		void build( StarCatalogue const & catalogue );
+		/**
+		*\brief
+		*	Met à jour les directions des étoiles après leur déplacement,
+		*	en gardant la répartition des entrées.
+		*\remarks
+		*	Les calottes des noeuds sont ajustées aux nouvelles directions,
+		*	les requêtes restent donc exactes, même pour une étoile ayant
+		*	quitté la tuile de sa feuille.
+		*\param[in] catalogue
+		*	Le catalogue depuis lequel l'index a été construit.
+		*\return
+		*	\p false si une étoile a quitté la tuile de sa feuille, l'index
+		*	doit alors être reconstruit pour retrouver des calottes serrées.
+		*/
+		bool update( StarCatalogue const & catalogue );
+		/**
+		*\brief
+		*	Vide l'index.
+		*/
+		void clear();
+		/**
+		*\brief
+		*	Récupère les entrées des étoiles d'une calotte.
+		*\param[in] cap
+		*	La calotte.
+		*\param[out] result
+		*	Reçoit les intervalles d'entrées, par ordre croissant, les
+		*	intervalles voisins étant fusionnés.
+		*/
+		void cone( SkyCap const & cap
+			, RangeArray & result )const;
+		/**
+		*\brief
+		*	Récupère les entrées des étoiles d'un frustum.
+		*\remarks
+		*	Les étoiles sont supposées à leur distance de l'origine, celle
+		*	de Star::position.
+		*\param[in] frustum
+		*	Le frustum.
+		*\param[out] result
+		*	Reçoit les intervalles d'entrées, par ordre croissant, les
+		*	intervalles voisins étant fusionnés.
+		*/
+		void frustum( render::Frustum const & frustum
+			, RangeArray & result )const;
+		/**
+		*\brief
+		*	Récupère les étoiles les plus brillantes d'une calotte.
+		*\remarks
+		*	Les noeuds sont parcourus par index de plus brillante étoile
+		*	croissant : seules les feuilles pouvant contenir les étoiles
+		*	retournées sont parcourues.
+		*\param[in] cap
+		*	La calotte.
+		*\param[in] count
+		*	Le nombre maximal d'étoiles.
+		*\param[in] limit
+		*	Les étoiles d'index supérieur ou égal sont ignorées.
+		*\return
+		*	Les index des étoiles, dans le catalogue trié, par ordre
+		*	croissant.
+		*/
+		std::vector< uint32_t > brightest( SkyCap const & cap
+			, uint32_t count
+			, uint32_t limit = ~0u )const;
+		/**
+		*\brief
+		*	Récupère les étoiles les plus brillantes d'un frustum.
+		*\param[in] frustum
+		*	Le frustum.
+		*\param[in] count
+		*	Le nombre maximal d'étoiles.
+		*\param[in] limit
+		*	Les étoiles d'index supérieur ou égal sont ignorées.
+		*\return
+		*	Les index des étoiles, dans le catalogue trié, par ordre
+		*	croissant.
+		*/
+		std::vector< uint32_t > brightest( render::Frustum const & frustum
+			, uint32_t count
+			, uint32_t limit = ~0u )const;
+		/**
+		*\brief
+		*	Récupère les étoiles les plus proches d'une direction.
+		*\remarks
+		*	Les noeuds sont parcourus par distance angulaire minimale
+		*	croissante, ceux ne contenant que des étoiles d'index supérieur
+		*	ou égal à \p limit étant ignorés.
+		*\param[in] cap
+		*	La direction cherchée, au centre de la calotte, dont le rayon
+		*	est la distance maximale.
+		*\param[in] count
+		*	Le nombre maximal d'étoiles.
+		*\param[in] limit
+		*	Les étoiles d'index supérieur ou égal sont ignorées.
+		*\return
+		*	Les index des étoiles, dans le catalogue trié, par distance
+		*	croissante.
+		*/
+		std::vector< uint32_t > nearest( SkyCap const & cap
+			, uint32_t count
+			, uint32_t limit = ~0u )const;
+		/**
+		*\brief
+		*	Récupère les entrées des étoiles d'un noeud.
+		*\param[in] level
+		*	Le niveau du noeud, au plus level().
+		*\param[in] node
+		*	L'indice du noeud.
+		*\return
+		*	L'intervalle des entrées, complet.
+		*/
+		Range node( uint32_t level
+			, uint32_t node )const;
+		/**
+		*\brief
+		*	Récupère la calotte englobant les étoiles d'un noeud.
+		*\remarks
+		*	Le rayon de la calotte d'un noeud vide est négatif.
+		*\param[in] level
+		*	Le niveau du noeud, au plus level().
+		*\param[in] node
+		*	L'indice du noeud.
+		*/
+		inline SkyCap const & cap( uint32_t level
+			, uint32_t node )const
+		{
+			assert( level <= m_level );
+			return m_caps[level][node];
+		}
+		/**
+		*\return
+		*	Le niveau des feuilles.
+		*/
+		inline uint32_t level()const noexcept
+		{
+			return m_level;
+		}
+		/**
+		*\return
+		*	L'index de l'étoile de chaque entrée, dans le catalogue trié.
+		*/
+		inline std::vector< uint32_t > const & stars()const noexcept
+		{
+			return m_stars;
+		}
+		/**
+		*\return
+		*	La direction de l'étoile de chaque entrée, en coordonnées
+		*	octaédriques, rangée avec les entrées pour que les parcours
+		*	d'une zone restent contigus.
+		*/
+		inline std::vector< gl::U16Vec2 > const & directions()const noexcept
+		{
+			return m_directions;
+		}
+		/**
+		*\return
+		*	Le nombre d'étoiles indexées.
+		*/
+		inline size_t size()const noexcept
+		{
+			return m_stars.size();
+		}
+		/**
+		*\return
+		*	\p true si l'index est vide.
+		*/
+		inline bool empty()const noexcept
+		{
+			return m_stars.empty();
+		}
+
+	private:
+		template< typename RegionT >
+		void doCollect( RegionT const & region
+			, RangeArray & result )const;
+		template< typename RegionT >
+		void doCollect( RegionT const & region
+			, uint32_t level
+			, uint32_t node
+			, RangeArray & result )const;
+		template< typename RegionT >
+		std::vector< uint32_t > doFindBrightest( RegionT const & region
+			, uint32_t count
+			, uint32_t limit )const;
+		void doAdd( Range const & range
+			, RangeArray & result )const;
+		void doFitCaps();
+
+	private:
+		//! Le niveau des feuilles.
+		uint32_t m_level{ 0u };
+		//! La première entrée de chaque feuille, suivie du nombre d'entrées.
+		std::vector< uint32_t > m_firsts;
+		//! L'index de l'étoile de chaque entrée.
+		std::vector< uint32_t > m_stars;
+		//! La direction de l'étoile de chaque entrée, compactée.
+		std::vector< gl::U16Vec2 > m_directions;
+		//! Les calottes des noeuds, par niveau.
+		std::vector< std::vector< SkyCap > > m_caps;
+		//! L'index de la plus brillante étoile des noeuds, par niveau, ~0u
+		//! pour un noeud vide.
+		std::vector< std::vector< uint32_t > > m_brightest;
+	};
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include "SkyTiling.h"
+
+namespace starmap
+{
+	namespace
+	{
+		//! pi / 2, au-delà duquel une calotte ne contient plus forcément
+		//! l'enveloppe convexe de ses points.
+		static float constexpr HalfPi = 1.57079632679489f;
+		//! pi.
+		static float constexpr Pi = 3.14159265358979f;
+		//! La marge ajoutée aux calottes des tuiles, couvrant l'arrondi des
+		//! coordonnées compactées.
+		static float constexpr CapMargin = 1.0e-4f;
+
+		uint32_t doSpreadBits( uint32_t value )noexcept
+		{
+			value &= 0x0000FFFFu;
+			value = ( value | ( value << 8u ) ) & 0x00FF00FFu;
+			value = ( value | ( value << 4u ) ) & 0x0F0F0F0Fu;
+			value = ( value | ( value << 2u ) ) & 0x33333333u;
+			value = ( value | ( value << 1u ) ) & 0x55555555u;
+			return value;
+		}
+
+		uint32_t doCompactBits( uint32_t value )noexcept
+		{
+			value &= 0x55555555u;
+			value = ( value | ( value >> 1u ) ) & 0x33333333u;
+			value = ( value | ( value >> 2u ) ) & 0x0F0F0F0Fu;
+			value = ( value | ( value >> 4u ) ) & 0x00FF00FFu;
+			value = ( value | ( value >> 8u ) ) & 0x0000FFFFu;
+			return value;
+		}
+		/**
+		*\brief
+		*	Equivalent de gl::unpackOctahedral pour un point du carré des
+		*	coordonnées octaédriques, dans [-1, 1].
+		*/
+		gl::Vec3 doUnfold( gl::Vec2 const & point )noexcept
+		{
+			gl::Vec3 result{ point.x, point.y, 0.0f };
+			result.z = 1.0f - std::abs( result.x ) - std::abs( result.y );
+			auto const t = std::max( -result.z, 0.0f );
+			result.x += result.x >= 0.0f ? -t : t;
+			result.y += result.y >= 0.0f ? -t : t;
+			return gl::normalize( result );
+		}
+
+		void doFindTiles( SkyCap const & cap
+			, uint32_t level
+			, uint32_t index
+			, uint32_t target
+			, std::vector< uint32_t > & result )
+		{
+			if ( !intersects( cap, tileCap( level, index ) ) )
+			{
+				return;
+			}
+
+			if ( level == target )
+			{
+				result.push_back( index );
+				return;
+			}
+
+			for ( uint32_t child = 0u; child < 4u; ++child )
+			{
+				doFindTiles( cap, level + 1u, index * 4u + child, target, result );
+			}
+		}
+	}
+
+	bool contains( SkyCap const & cap
+		, gl::Vec3 const & direction )noexcept
+	{
+		return cap.radius >= Pi
+			|| gl::dot( cap.centre, direction ) >= std::cos( cap.radius );
+	}
+
+	bool intersects( SkyCap const & lhs
+		, SkyCap const & rhs )noexcept
+	{
+		auto radius = lhs.radius + rhs.radius;
+		return radius >= Pi
+			|| gl::dot( lhs.centre, rhs.centre ) >= std::cos( radius );
+	}
+
+	bool contains( SkyCap const & outer
+		, SkyCap const & inner )noexcept
+	{
+		return outer.radius >= Pi
+			|| angle( outer.centre, inner.centre ) + inner.radius <= outer.radius;
+	}
+
+	float angle( gl::Vec3 const & lhs
+		, gl::Vec3 const & rhs )noexcept
+	{
+		return std::atan2( gl::length( gl::cross( lhs, rhs ) )
+			, gl::dot( lhs, rhs ) );
+	}
+
+	SkySphere boundingSphere( SkyCap const & cap
+		, float distance )noexcept
+	{
+		// Au-delà d'un quart de tour, le cercle du bord de la calotte
+		// n'englobe plus la calotte : la sphère est alors celle des étoiles.
+		if ( cap.radius >= HalfPi )
+		{
+			return SkySphere{ gl::Vec3{}, distance };
+		}
+
+		return SkySphere{ cap.centre * ( distance * std::cos( cap.radius ) )
+			, distance * std::sin( cap.radius ) };
+	}
+
+	uint32_t tileIndex( gl::U16Vec2 const & direction
+		, uint32_t level )noexcept
+	{
+		assert( level < MaxTileLevel );
+		auto shift = MaxTileLevel - level;
+		return doSpreadBits( uint32_t( direction.x ) >> shift )
+			| ( doSpreadBits( uint32_t( direction.y ) >> shift ) << 1u );
+	}
+
+	SkyCap tileCap( uint32_t level
+		, uint32_t index )
+	{
+		if ( level == 0u )
+		{
+			return SkyCap{ gl::Vec3{ 0, 0, 1 }, Pi };
+		}
+
+		// Les bords de la tuile, dans le carré des coordonnées octaédriques.
+		auto size = 2.0f / float( 1u << level );
+		auto x = float( doCompactBits( index ) ) * size - 1.0f;
+		auto y = float( doCompactBits( index >> 1u ) ) * size - 1.0f;
+		std::array< gl::Vec2, 4u > corners
+		{
+			{
+				gl::Vec2{ x, y },
+				gl::Vec2{ x + size, y },
+				gl::Vec2{ x + size, y + size },
+				gl::Vec2{ x, y + size },
+			}
+		};
+
+		// Dès le niveau 1, une tuile est dans un seul quadrant, où le pliage
+		// de l'hémisphère sud est affine de part et d'autre de la diagonale
+		// |x| + |y| = 1 : la tuile est l'union de deux polygones sphériques
+		// convexes, dont les sommets sont ses coins et les points où ses
+		// côtés croisent la diagonale.
+		auto sx = x + size / 2.0f >= 0.0f ? 1.0f : -1.0f;
+		auto sy = y + size / 2.0f >= 0.0f ? 1.0f : -1.0f;
+		std::vector< gl::Vec3 > points;
+		points.reserve( 8u );
+
+		for ( size_t i = 0u; i < corners.size(); ++i )
+		{
+			auto & a = corners[i];
+			auto & b = corners[( i + 1u ) % corners.size()];
+			auto fa = sx * a.x + sy * a.y - 1.0f;
+			auto fb = sx * b.x + sy * b.y - 1.0f;
+			points.push_back( doUnfold( a ) );
+
+			if ( ( fa < 0.0f && fb > 0.0f )
+				|| ( fa > 0.0f && fb < 0.0f ) )
+			{
+				points.push_back( doUnfold( a + ( b - a ) * ( fa / ( fa - fb ) ) ) );
+			}
+		}
+
+		gl::Vec3 centre;
+
+		for ( auto & point : points )
+		{
+			centre += point;
+		}
+
+		SkyCap result{ gl::normalize( centre ), 0.0f };
+		auto cosine = 1.0f;
+
+		for ( auto & point : points )
+		{
+			cosine = std::min( cosine, gl::dot( result.centre, point ) );
+		}
+
+		result.radius = std::acos( std::max( -1.0f, std::min( 1.0f, cosine ) ) )
+			+ CapMargin;
+
+		if ( result.radius >= HalfPi )
+		{
+			result.radius = Pi;
+		}
+
+		return result;
+	}
+
+	void findTiles( SkyCap const & cap
+		, uint32_t level
+		, std::vector< uint32_t > & result )
+	{
+		assert( level < MaxTileLevel );
+		result.clear();
+		doFindTiles( cap, 0u, 0u, level, result );
+	}
+}
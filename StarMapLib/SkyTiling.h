@@ -0,0 +1,163 @@
+/**
+*\file
+*	SkyTiling.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SkyTiling_HPP___
+#define ___StarMapLib_SkyTiling_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+#include <GlLib/Packing.h>
+
+namespace starmap
+{
+	//! La distance des étoiles à l'origine, voir Star::position.
+	static float constexpr StarDistance = 100.0f;
+	/**
+	*\brief
+	*	Une calotte sphérique : les directions à moins d'un angle donné d'un
+	*	centre.
+	*/
+	struct SkyCap
+	{
+		//! Le centre de la calotte, normalisé.
+		gl::Vec3 centre;
+		//! Le rayon angulaire de la calotte, en radians.
+		float radius;
+	};
+	/**
+	*\brief
+	*	Une sphère englobant les points d'une calotte, placés à une distance
+	*	donnée de l'origine.
+	*/
+	struct SkySphere
+	{
+		//! Le centre de la sphère.
+		gl::Vec3 centre;
+		//! Le rayon de la sphère.
+		float radius;
+	};
+	/**
+	*\brief
+	*	Dit si une direction est dans une calotte.
+	*\param[in] cap
+	*	La calotte.
+	*\param[in] direction
+	*	La direction, normalisée.
+	*/
+	bool contains( SkyCap const & cap
+		, gl::Vec3 const & direction )noexcept;
+	/**
+	*\brief
+	*	Dit si deux calottes ont une partie commune.
+	*\param[in] lhs, rhs
+	*	Les calottes.
+	*/
+	bool intersects( SkyCap const & lhs
+		, SkyCap const & rhs )noexcept;
+	/**
+	*\brief
+	*	Dit si une calotte en contient entièrement une autre.
+	*\param[in] outer
+	*	La calotte englobante.
+	*\param[in] inner
+	*	La calotte englobée.
+	*/
+	bool contains( SkyCap const & outer
+		, SkyCap const & inner )noexcept;
+	/**
+	*\brief
+	*	Calcule l'angle entre deux directions.
+	*\remarks
+	*	Calculé via atan2, il reste précis pour les petits angles, au
+	*	contraire de acos.
+	*\param[in] lhs, rhs
+	*	Les directions, normalisées.
+	*\return
+	*	L'angle, en radians.
+	*/
+	float angle( gl::Vec3 const & lhs
+		, gl::Vec3 const & rhs )noexcept;
+	/**
+	*\brief
+	*	Calcule la sphère englobant les points d'une calotte placés à une
+	*	distance donnée de l'origine.
+	*\param[in] cap
+	*	La calotte.
+	*\param[in] distance
+	*	La distance des points à l'origine.
+	*\return
+	*	La sphère.
+	*/
+	SkySphere boundingSphere( SkyCap const & cap
+		, float distance )noexcept;
+	/**
+	*\brief
+	*	Le niveau maximal des tuiles, une tuile y correspondant à une seule
+	*	valeur des coordonnées octaédriques compactées.
+	*\remarks
+	*	Les tuiles découpent la sphère comme un quadtree sur le carré des
+	*	coordonnées octaédriques : le niveau 0 est la sphère entière, et
+	*	chaque tuile a 4 filles au niveau suivant. Les tuiles d'un niveau
+	*	sont numérotées dans l'ordre de Morton, les filles de la tuile i
+	*	sont donc les tuiles 4i à 4i + 3 du niveau suivant.
+	*/
+	static uint32_t constexpr MaxTileLevel = 16u;
+	/**
+	*\return
+	*	Le nombre de tuiles d'un niveau.
+	*/
+	inline uint32_t tileCount( uint32_t level )noexcept
+	{
+		assert( level < MaxTileLevel );
+		return 1u << ( 2u * level );
+	}
+	/**
+	*\brief
+	*	Récupère la tuile contenant une direction.
+	*\param[in] direction
+	*	La direction, en coordonnées octaédriques.
+	*\param[in] level
+	*	Le niveau des tuiles.
+	*\return
+	*	L'indice de la tuile.
+	*/
+	uint32_t tileIndex( gl::U16Vec2 const & direction
+		, uint32_t level )noexcept;
+	/**
+	*\brief
+	*	Calcule une calotte englobant une tuile.
+	*\param[in] level
+	*	Le niveau de la tuile.
+	*\param[in] index
+	*	L'indice de la tuile.
+	*\return
+	*	La calotte.
+	*/
+	SkyCap tileCap( uint32_t level
+		, uint32_t index );
+	/**
+	*\brief
+	*	Récupère les tuiles d'un niveau ayant une partie commune avec une
+	*	calotte.
+	*\remarks
+	*	Les tuiles sont parcourues depuis le niveau 0, seules les filles des
+	*	tuiles touchant la calotte étant testées.\n
+	*	Le test utilisant les calottes englobant les tuiles, quelques tuiles
+	*	proches du bord de la calotte peuvent être retournées à tort.
+	*\param[in] cap
+	*	La calotte.
+	*\param[in] level
+	*	Le niveau des tuiles.
+	*\param[out] result
+	*	Reçoit les indices des tuiles, par ordre croissant.
+	*/
+	void findTiles( SkyCap const & cap
+		, uint32_t level
+		, std::vector< uint32_t > & result );
+}
+
+#endif
@@ -0,0 +1,122 @@
+/**
+*\file
+*	SmcFormat.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SmcFormat_HPP___
+#define ___StarMapLib_SmcFormat_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Le format binaire de catalogue d'étoiles (.smc).
+	*\remarks
+	*	Le fichier commence par un SmcHeader, suivi des sections qu'il
+	*	référence, alignées sur 4 octets. Les valeurs sont stockées en
+	*	little endian.\n
+	*	Les étoiles sont stockées par colonnes, dans l'ordre trié par
+	*	magnitude : leur indice dans les colonnes est donc leur index.\n
+	*	Toutes les chaînes sont stockées dans un bloc commun, sans zéro
+	*	terminal.\n
+	*	Les positions sont celles de J2000 : les étoiles ayant un mouvement
+	*	propre sont déplacées par StarCatalogue::epoch une fois lues.
+	*/
+	struct SmcHeader
+	{
+		//! Le marqueur du format, SmcMagic.
+		uint32_t magic;
+		//! La version du format, SmcVersion.
+		uint32_t version;
+		//! Le nombre d'étoiles.
+		uint32_t starCount;
+		//! Le nombre de constellations.
+		uint32_t constellationCount;
+		//! Le nombre total d'étoiles des constellations.
+		uint32_t memberCount;
+		//! Le nombre total de liens des constellations.
+		uint32_t linkCount;
+		//! La taille du bloc de chaînes.
+		uint32_t stringsSize;
+		//! Le nombre de mouvements propres, 0 ou starCount.
+		uint32_t motionCount;
+		//! Positions des sections dans le fichier.
+		//!\{
+		//! float[3] par étoile, la position sur la sphère unité.
+		uint32_t positions;
+		//! float par étoile, la magnitude.
+		uint32_t magnitudes;
+		//! uint8_t par étoile, l'indice de la couleur dans la palette.
+		uint32_t colours;
+		//! uint32_t par étoile, plus un : les bornes des noms dans le bloc
+		//! de chaînes.
+		uint32_t names;
+		//! SmcConstellation par constellation.
+		uint32_t constellations;
+		//! SmcMember par étoile de constellation.
+		uint32_t members;
+		//! SmcLink par lien de constellation.
+		uint32_t links;
+		//! Le bloc de chaînes.
+		uint32_t strings;
+		//! float[3] par mouvement propre, la vitesse de l'étoile en radians
+		//! par an (voir StarMotion).
+		uint32_t motions;
+		//!\}
+	};
+	/**
+	*\brief
+	*	Une chaîne du bloc de chaînes.
+	*/
+	struct SmcString
+	{
+		uint32_t offset;
+		uint32_t size;
+	};
+	/**
+	*\brief
+	*	Une constellation, référençant ses étoiles et ses liens.
+	*/
+	struct SmcConstellation
+	{
+		SmcString name;
+		uint32_t firstMember;
+		uint32_t memberCount;
+		uint32_t firstLink;
+		uint32_t linkCount;
+	};
+	/**
+	*\brief
+	*	Une étoile de constellation.
+	*/
+	struct SmcMember
+	{
+		//! L'index de l'étoile dans le catalogue.
+		uint32_t star;
+		//! L'ID de l'étoile dans la constellation.
+		uint32_t id;
+		//! La lettre associée à l'étoile, dans la constellation.
+		SmcString letter;
+	};
+	/**
+	*\brief
+	*	Un lien de constellation, entre deux de ses étoiles.
+	*/
+	struct SmcLink
+	{
+		//! Les indices des étoiles, relatifs au premier membre de la
+		//! constellation.
+		uint32_t a;
+		uint32_t b;
+	};
+	//! Le marqueur du format : "SMC1".
+	static uint32_t constexpr SmcMagic = 0x31434d53u;
+	//! La version actuelle du format.
+	static uint32_t constexpr SmcVersion = 2u;
+}
+
+#endif
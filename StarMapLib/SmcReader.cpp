@@ -0,0 +1,245 @@
+#include "SmcReader.h"
+
+#include "ReadMonitor.h"
+#include "SmcFormat.h"
+#include "StarCatalogue.h"
+
+namespace starmap
+{
+	namespace
+	{
+		//! Le nombre d'étoiles lues entre deux consultations du suivi.
+		static uint32_t constexpr MonitorBatchSize = 4096u;
+		/**
+		*\brief
+		*	Vérifie qu'une section de \p count éléments de type \p T tient
+		*	dans le contenu.
+		*/
+		template< typename T >
+		bool doCheckSection( StringView const & content
+			, uint32_t offset
+			, uint64_t count )
+		{
+			return offset % alignof( uint32_t ) == 0u
+				&& offset <= content.size()
+				&& count * sizeof( T ) <= content.size() - offset;
+		}
+		/**
+		*\brief
+		*	Récupère un pointeur sur une section du contenu.
+		*\remarks
+		*	Les sections sont alignées sur 4 octets, le contenu doit l'être
+		*	aussi.
+		*/
+		template< typename T >
+		T const * doGetSection( StringView const & content
+			, uint32_t offset )
+		{
+			return reinterpret_cast< T const * >( content.data() + offset );
+		}
+
+		bool doCheckHeader( StringView const & content
+			, SmcHeader const & header )
+		{
+			if ( header.magic != SmcMagic )
+			{
+				std::cerr << "Not a star catalogue." << std::endl;
+				return false;
+			}
+
+			if ( header.version != SmcVersion )
+			{
+				std::cerr << "Unsupported star catalogue version: " << header.version << "." << std::endl;
+				return false;
+			}
+
+			if ( !doCheckSection< float >( content, header.positions, uint64_t( header.starCount ) * 3u )
+				|| !doCheckSection< float >( content, header.magnitudes, header.starCount )
+				|| !doCheckSection< uint8_t >( content, header.colours, header.starCount )
+				|| !doCheckSection< uint32_t >( content, header.names, uint64_t( header.starCount ) + 1u )
+				|| !doCheckSection< SmcConstellation >( content, header.constellations, header.constellationCount )
+				|| !doCheckSection< SmcMember >( content, header.members, header.memberCount )
+				|| !doCheckSection< SmcLink >( content, header.links, header.linkCount )
+				|| ( header.motionCount != 0u && header.motionCount != header.starCount )
+				|| !doCheckSection< float >( content, header.motions, uint64_t( header.motionCount ) * 3u )
+				|| !doCheckSection< char >( content, header.strings, header.stringsSize ) )
+			{
+				std::cerr << "Truncated star catalogue." << std::endl;
+				return false;
+			}
+
+			return true;
+		}
+
+		bool doCheckString( SmcHeader const & header
+			, SmcString const & string )
+		{
+			return string.offset <= header.stringsSize
+				&& string.size <= header.stringsSize - string.offset;
+		}
+	}
+
+	bool loadCatalogueFromSmc( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor )
+	{
+		assert( catalogue.stars().empty() );
+
+		if ( ( uintptr_t( content.data() ) % alignof( uint32_t ) ) != 0u )
+		{
+			// Une projection mémoire est alignée, mais un fichier extrait
+			// d'une archive peut ne pas l'être : on le recopie alors.
+			std::vector< uint32_t > aligned( ( content.size() + 3u ) / 4u );
+			memcpy( aligned.data(), content.data(), content.size() );
+			auto begin = reinterpret_cast< char const * >( aligned.data() );
+			return loadCatalogueFromSmc( catalogue
+				, { begin, begin + content.size() }
+				, monitor );
+		}
+
+		SmcHeader header;
+
+		if ( content.size() < sizeof( SmcHeader ) )
+		{
+			std::cerr << "Truncated star catalogue." << std::endl;
+			return false;
+		}
+
+		memcpy( &header, content.data(), sizeof( SmcHeader ) );
+
+		if ( !doCheckHeader( content, header ) )
+		{
+			return false;
+		}
+
+		auto positions = doGetSection< gl::Vec3 >( content, header.positions );
+		auto magnitudes = doGetSection< float >( content, header.magnitudes );
+		auto colours = doGetSection< uint8_t >( content, header.colours );
+		auto names = doGetSection< uint32_t >( content, header.names );
+		auto velocities = doGetSection< gl::Vec3 >( content, header.motions );
+		auto strings = content.data() + header.strings;
+		auto palette = paletteSize();
+
+		if ( names[header.starCount] > header.stringsSize )
+		{
+			std::cerr << "Corrupted star catalogue." << std::endl;
+			return false;
+		}
+
+		monitor.start( size_t( header.starCount ) + header.constellationCount );
+		StarArray stars;
+		stars.reserve( header.starCount );
+		StarMotionArray motions;
+		motions.reserve( header.motionCount );
+		// Tous les noms tiennent dans un seul bloc.
+		auto & pool = catalogue.namePool();
+		pool.reserve( size_t( names[header.starCount] ) + header.starCount );
+
+		for ( uint32_t i = 0u; i < header.starCount; ++i )
+		{
+			if ( names[i] > names[i + 1] || colours[i] >= palette )
+			{
+				std::cerr << "Corrupted star catalogue." << std::endl;
+				return false;
+			}
+
+			stars.emplace_back( pool.add( StringView{ strings + names[i], strings + names[i + 1] } )
+				, magnitudes[i]
+				, positions[i]
+				, colours[i] );
+
+			if ( header.motionCount )
+			{
+				motions.push_back( { stars.back().packed().position, velocities[i] } );
+			}
+
+			if ( ( i + 1u ) % MonitorBatchSize == 0u
+				&& !monitor.advance( MonitorBatchSize ) )
+			{
+				return false;
+			}
+		}
+
+		monitor.advance( header.starCount % MonitorBatchSize );
+
+		auto constellations = doGetSection< SmcConstellation >( content, header.constellations );
+		auto members = doGetSection< SmcMember >( content, header.members );
+		auto links = doGetSection< SmcLink >( content, header.links );
+		std::vector< ConstellationPtr > result;
+		result.reserve( header.constellationCount );
+
+		for ( uint32_t i = 0u; i < header.constellationCount; ++i )
+		{
+			auto & info = constellations[i];
+
+			if ( !doCheckString( header, info.name )
+				|| info.firstMember > header.memberCount
+				|| info.memberCount > header.memberCount - info.firstMember
+				|| info.firstLink > header.linkCount
+				|| info.linkCount > header.linkCount - info.firstLink )
+			{
+				std::cerr << "Corrupted star catalogue." << std::endl;
+				return false;
+			}
+
+			auto constellation = std::make_unique< Constellation >( std::string{ strings + info.name.offset
+				, strings + info.name.offset + info.name.size } );
+
+			for ( auto member = members + info.firstMember;
+				member != members + info.firstMember + info.memberCount;
+				++member )
+			{
+				if ( member->star >= header.starCount
+					|| !doCheckString( header, member->letter ) )
+				{
+					std::cerr << "Corrupted star catalogue." << std::endl;
+					return false;
+				}
+
+				constellation->addStar( member->id
+					, std::string{ strings + member->letter.offset
+						, strings + member->letter.offset + member->letter.size }
+					, stars[member->star]
+					, member->star
+					, pool.get( stars[member->star].name() ) );
+			}
+
+			for ( auto link = links + info.firstLink;
+				link != links + info.firstLink + info.linkCount;
+				++link )
+			{
+				if ( link->a >= info.memberCount
+					|| link->b >= info.memberCount )
+				{
+					std::cerr << "Corrupted star catalogue." << std::endl;
+					return false;
+				}
+
+				auto & cstars = constellation->stars();
+				constellation->addLink( cstars[link->a].letter()
+					, cstars[link->b].letter() );
+			}
+
+			result.push_back( std::move( constellation ) );
+
+			if ( !monitor.advance( 1u ) )
+			{
+				return false;
+			}
+		}
+
+		// Les étoiles sont déjà triées : le déplacement du tableau conserve
+		// les références des constellations.
+		catalogue.add( std::move( stars )
+			, StarIdentifierArray{}
+			, std::move( motions ) );
+		catalogue.sorted( true );
+
+		for ( auto & constellation : result )
+		{
+			catalogue.add( std::move( constellation ) );
+		}
+
+		return true;
+	}
+}
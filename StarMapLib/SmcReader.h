@@ -0,0 +1,47 @@
+/**
+*\file
+*	SmcReader.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SmcReader_HPP___
+#define ___StarMapLib_SmcReader_HPP___
+#pragma once
+
+#include "ReadMonitor.h"
+#include "StringView.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Charge un catalogue depuis un fichier binaire .smc.
+	*\remarks
+	*	Les colonnes sont lues directement depuis le contenu, aucun texte
+	*	n'est analysé : les étoiles sont déjà triées et indexées, et les
+	*	constellations référencent directement leurs étoiles. Les
+	*	positions lues sont celles de J2000, les mouvements propres
+	*	éventuels permettant de les déplacer (voir StarCatalogue::epoch).\n
+	*	Si le contenu n'est pas un fichier .smc valide, une erreur est
+	*	affichée et le catalogue n'est pas modifié. Il ne l'est pas non
+	*	plus si la lecture est annulée, le suivi étant consulté par lots
+	*	d'étoiles, puis à chaque constellation.
+	*\param[in,out] catalogue
+	*	Le catalogue recevant les étoiles et constellations, qui doit être
+	*	vide.
+	*\param[in] content
+	*	Le contenu du fichier, qui peut être une projection mémoire du
+	*	fichier.
+	*\param[in] monitor
+	*	Le suivi de la lecture, dont l'avancement est compté en étoiles et
+	*	constellations.
+	*\return
+	*	\p false si le contenu n'est pas un fichier .smc valide, ou si la
+	*	lecture a été annulée.
+	*/
+	bool loadCatalogueFromSmc( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor = ReadMonitor{} );
+}
+
+#endif
@@ -0,0 +1,180 @@
+#include "SmcWriter.h"
+
+#include "SmcFormat.h"
+#include "StarCatalogue.h"
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	Accumule les chaînes dans le bloc de chaînes.
+		*/
+		SmcString doAddString( std::string const & value
+			, std::string & strings )
+		{
+			SmcString result{ uint32_t( strings.size() ), uint32_t( value.size() ) };
+			strings += value;
+			return result;
+		}
+
+		uint32_t doAlign( uint32_t offset )
+		{
+			return ( offset + 3u ) & ~3u;
+		}
+
+		template< typename T >
+		void doWrite( render::ByteArray & content
+			, uint32_t offset
+			, std::vector< T > const & values )
+		{
+			if ( !values.empty() )
+			{
+				memcpy( content.data() + offset
+					, values.data()
+					, values.size() * sizeof( T ) );
+			}
+		}
+	}
+
+	void saveCatalogueToSmc( StarCatalogue const & catalogue
+		, render::ByteArray & content )
+	{
+		assert( catalogue.sorted() );
+		auto & stars = catalogue.stars();
+		auto & motions = catalogue.motions();
+		std::string strings;
+		std::vector< float > positions;
+		std::vector< float > velocities;
+		std::vector< float > magnitudes;
+		std::vector< uint8_t > colours;
+		std::vector< uint32_t > names;
+		positions.reserve( stars.size() * 3u );
+		magnitudes.reserve( stars.size() );
+		colours.reserve( stars.size() );
+		names.reserve( stars.size() + 1u );
+		velocities.reserve( motions.size() * 3u );
+
+		for ( auto & motion : motions )
+		{
+			velocities.push_back( motion.velocity.x );
+			velocities.push_back( motion.velocity.y );
+			velocities.push_back( motion.velocity.z );
+		}
+
+		for ( size_t i = 0u; i < stars.size(); ++i )
+		{
+			// Les étoiles en mouvement sont écrites à leur position de
+			// J2000, quelle que soit l'époque du catalogue.
+			auto & star = stars[i];
+			auto position = motions.empty()
+				? gl::normalize( star.position() )
+				: gl::unpackOctahedral( motions[i].origin );
+			positions.push_back( position.x );
+			positions.push_back( position.y );
+			positions.push_back( position.z );
+			magnitudes.push_back( star.magnitude() );
+			colours.push_back( star.paletteIndex() );
+			auto name = catalogue.name( star );
+			names.push_back( uint32_t( strings.size() ) );
+			strings.append( name.data(), name.size() );
+		}
+
+		names.push_back( uint32_t( strings.size() ) );
+
+		// Les constellations sont écrites triées par nom, afin que le
+		// fichier ne dépende pas de l'ordre de la table de hachage.
+		std::vector< Constellation const * > sorted;
+
+		for ( auto & constellation : catalogue.constellations() )
+		{
+			sorted.push_back( constellation.second.get() );
+		}
+
+		std::sort( sorted.begin()
+			, sorted.end()
+			, []( Constellation const * lhs, Constellation const * rhs )
+			{
+				return lhs->name() < rhs->name();
+			} );
+		std::vector< SmcConstellation > constellations;
+		std::vector< SmcMember > members;
+		std::vector< SmcLink > links;
+
+		for ( auto constellation : sorted )
+		{
+			SmcConstellation info
+			{
+				doAddString( constellation->name(), strings ),
+				uint32_t( members.size() ),
+				0u,
+				uint32_t( links.size() ),
+				0u,
+			};
+			auto & cstars = constellation->stars();
+			std::vector< uint32_t > locals( cstars.size(), ~0u );
+
+			for ( size_t i = 0u; i < cstars.size(); ++i )
+			{
+				auto & cstar = cstars[i];
+
+				if ( cstar.filled() )
+				{
+					locals[i] = info.memberCount++;
+					members.push_back( { cstar.index()
+						, cstar.id()
+						, doAddString( cstar.letter(), strings ) } );
+				}
+			}
+
+			for ( auto & link : constellation->links() )
+			{
+				auto a = locals[size_t( link.m_a - cstars.data() )];
+				auto b = locals[size_t( link.m_b - cstars.data() )];
+
+				if ( a != ~0u && b != ~0u )
+				{
+					links.push_back( { a, b } );
+					++info.linkCount;
+				}
+			}
+
+			constellations.push_back( info );
+		}
+
+		SmcHeader header{};
+		header.magic = SmcMagic;
+		header.version = SmcVersion;
+		header.starCount = uint32_t( stars.size() );
+		header.constellationCount = uint32_t( constellations.size() );
+		header.memberCount = uint32_t( members.size() );
+		header.linkCount = uint32_t( links.size() );
+		header.stringsSize = uint32_t( strings.size() );
+		header.motionCount = uint32_t( motions.size() );
+		header.positions = doAlign( uint32_t( sizeof( SmcHeader ) ) );
+		header.magnitudes = doAlign( header.positions + uint32_t( positions.size() * sizeof( float ) ) );
+		header.colours = doAlign( header.magnitudes + uint32_t( magnitudes.size() * sizeof( float ) ) );
+		header.names = doAlign( header.colours + uint32_t( colours.size() ) );
+		header.constellations = doAlign( header.names + uint32_t( names.size() * sizeof( uint32_t ) ) );
+		header.members = doAlign( header.constellations + uint32_t( constellations.size() * sizeof( SmcConstellation ) ) );
+		header.links = doAlign( header.members + uint32_t( members.size() * sizeof( SmcMember ) ) );
+		header.motions = doAlign( header.links + uint32_t( links.size() * sizeof( SmcLink ) ) );
+		header.strings = doAlign( header.motions + uint32_t( velocities.size() * sizeof( float ) ) );
+
+		content.clear();
+		content.resize( header.strings + strings.size(), 0u );
+		memcpy( content.data(), &header, sizeof( SmcHeader ) );
+		doWrite( content, header.positions, positions );
+		doWrite( content, header.magnitudes, magnitudes );
+		doWrite( content, header.colours, colours );
+		doWrite( content, header.names, names );
+		doWrite( content, header.constellations, constellations );
+		doWrite( content, header.members, members );
+		doWrite( content, header.links, links );
+		doWrite( content, header.motions, velocities );
+		memcpy( content.data() + header.strings
+			, strings.data()
+			, strings.size() );
+	}
+}
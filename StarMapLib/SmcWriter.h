@@ -0,0 +1,31 @@
+/**
+*\file
+*	SmcWriter.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SmcWriter_HPP___
+#define ___StarMapLib_SmcWriter_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Ecrit un catalogue au format binaire .smc.
+	*\remarks
+	*	Les couleurs des étoiles sont converties en indices dans la palette.
+	*	Les étoiles de constellation non trouvées dans le catalogue, et les
+	*	liens les utilisant, sont ignorés.
+	*\param[in] catalogue
+	*	Le catalogue, qui doit être trié.
+	*\param[out] content
+	*	Reçoit le contenu du fichier.
+	*/
+	void saveCatalogueToSmc( StarCatalogue const & catalogue
+		, render::ByteArray & content );
+}
+
+#endif
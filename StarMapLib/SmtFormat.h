@@ -0,0 +1,68 @@
+/**
+*\file
+*	SmtFormat.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SmtFormat_HPP___
+#define ___StarMapLib_SmtFormat_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	//! Le nombre de profondeurs de magnitude décrites par tuile.
+	static uint32_t constexpr SmtDepthCount = 24u;
+	/**
+	*\brief
+	*	Le format binaire de catalogue d'étoiles par tuiles (.smt), lu à la
+	*	demande par TileCache.
+	*\remarks
+	*	Le fichier commence par un SmtHeader, suivi des SmtTile de toutes
+	*	les tuiles du niveau choisi (voir SkyTiling.h), puis des blocs des
+	*	tuiles. Les valeurs sont stockées en little endian.\n
+	*	Le bloc d'une tuile contient ses étoiles triées par magnitude, par
+	*	colonnes : PackedStar par étoile, puis uint32_t par étoile, la fin
+	*	de son nom dans les chaînes de la tuile, puis ces chaînes. Les n
+	*	premières étoiles d'une tuile, les plus brillantes, sont ainsi lues
+	*	sans lire les suivantes.
+	*/
+	struct SmtHeader
+	{
+		//! Le marqueur du format, SmtMagic.
+		uint32_t magic;
+		//! La version du format, SmtVersion.
+		uint32_t version;
+		//! Le niveau des tuiles.
+		uint32_t level;
+		//! Le nombre de tuiles, tileCount( level ).
+		uint32_t tileCount;
+		//! Le nombre total d'étoiles.
+		uint32_t starCount;
+		//! La magnitude de l'étoile la plus faible.
+		float faintest;
+	};
+	/**
+	*\brief
+	*	Une tuile, référençant son bloc.
+	*/
+	struct SmtTile
+	{
+		//! La position du bloc de la tuile dans le fichier.
+		uint64_t offset;
+		//! Le nombre d'étoiles de la tuile.
+		uint32_t starCount;
+		//! La taille des chaînes de la tuile.
+		uint32_t stringsSize;
+		//! depths[i] est le nombre d'étoiles de la tuile de magnitude
+		//! inférieure ou égale à i.
+		uint32_t depths[SmtDepthCount];
+	};
+	//! Le marqueur du format : "SMT1".
+	static uint32_t constexpr SmtMagic = 0x31544d53u;
+	//! La version actuelle du format.
+	static uint32_t constexpr SmtVersion = 1u;
+}
+
+#endif
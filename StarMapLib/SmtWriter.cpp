@@ -0,0 +1,115 @@
+#include "SmtWriter.h"
+
+#include "SkyTiling.h"
+#include "SmtFormat.h"
+#include "StarCatalogue.h"
+
+#include <numeric>
+
+namespace starmap
+{
+	namespace
+	{
+		template< typename T >
+		void doWrite( std::ostream & stream
+			, T const * values
+			, size_t count )
+		{
+			if ( count )
+			{
+				stream.write( reinterpret_cast< char const * >( values )
+					, std::streamsize( count * sizeof( T ) ) );
+			}
+		}
+	}
+
+	void saveCatalogueToSmt( StarCatalogue const & catalogue
+		, uint32_t level
+		, std::ostream & stream )
+	{
+		assert( catalogue.sorted() );
+		auto & stars = catalogue.stars();
+		auto count = tileCount( level );
+
+		// Tri par tuile, stable : les étoiles de chaque tuile restent
+		// triées par magnitude.
+		std::vector< uint32_t > tiles( stars.size() );
+		std::vector< uint32_t > firsts( count + 1u, 0u );
+
+		for ( size_t i = 0u; i < stars.size(); ++i )
+		{
+			tiles[i] = tileIndex( stars[i].packed().position, level );
+			++firsts[tiles[i] + 1u];
+		}
+
+		std::partial_sum( firsts.begin(), firsts.end(), firsts.begin() );
+		std::vector< uint32_t > order( stars.size() );
+		auto next = firsts;
+
+		for ( size_t i = 0u; i < stars.size(); ++i )
+		{
+			order[next[tiles[i]]++] = uint32_t( i );
+		}
+
+		SmtHeader header{};
+		header.magic = SmtMagic;
+		header.version = SmtVersion;
+		header.level = level;
+		header.tileCount = count;
+		header.starCount = uint32_t( stars.size() );
+		header.faintest = stars.empty()
+			? 0.0f
+			: stars.back().magnitude();
+
+		std::vector< SmtTile > infos( count, SmtTile{} );
+		uint64_t offset = sizeof( SmtHeader ) + count * sizeof( SmtTile );
+
+		for ( uint32_t tile = 0u; tile < count; ++tile )
+		{
+			auto & info = infos[tile];
+			info.offset = offset;
+			info.starCount = firsts[tile + 1u] - firsts[tile];
+
+			for ( auto i = firsts[tile]; i < firsts[tile + 1u]; ++i )
+			{
+				auto & star = stars[order[i]];
+				info.stringsSize += uint32_t( catalogue.name( star ).size() );
+				auto magnitude = star.magnitude();
+
+				for ( uint32_t depth = 0u; depth < SmtDepthCount; ++depth )
+				{
+					info.depths[depth] += magnitude <= float( depth ) ? 1u : 0u;
+				}
+			}
+
+			offset += info.starCount * ( sizeof( PackedStar ) + sizeof( uint32_t ) )
+				+ info.stringsSize;
+		}
+
+		doWrite( stream, &header, 1u );
+		doWrite( stream, infos.data(), infos.size() );
+		std::vector< PackedStar > packed;
+		std::vector< uint32_t > names;
+		std::string strings;
+
+		for ( uint32_t tile = 0u; tile < count; ++tile )
+		{
+			packed.clear();
+			names.clear();
+			strings.clear();
+
+			for ( auto i = firsts[tile]; i < firsts[tile + 1u]; ++i )
+			{
+				auto & star = stars[order[i]];
+				auto name = catalogue.name( star );
+				packed.push_back( star.packed() );
+				strings.append( name.data(), name.size() );
+				names.push_back( uint32_t( strings.size() ) );
+			}
+
+			doWrite( stream, packed.data(), packed.size() );
+			doWrite( stream, names.data(), names.size() );
+			doWrite( stream, strings.data(), strings.size() );
+		}
+	}
+}
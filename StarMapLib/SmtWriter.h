@@ -0,0 +1,35 @@
+/**
+*\file
+*	SmtWriter.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_SmtWriter_HPP___
+#define ___StarMapLib_SmtWriter_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Ecrit les étoiles d'un catalogue au format binaire par tuiles .smt.
+	*\remarks
+	*	Seules les étoiles sont écrites, les constellations restent dans le
+	*	catalogue principal (.smc, .xml).\n
+	*	Le contenu est écrit au fur et à mesure, sans être construit en
+	*	mémoire.
+	*\param[in] catalogue
+	*	Le catalogue, qui doit être trié.
+	*\param[in] level
+	*	Le niveau des tuiles (voir SkyTiling.h), de 0 à MaxTileLevel - 1.
+	*\param[out] stream
+	*	Le flux, binaire, recevant le contenu du fichier.
+	*/
+	void saveCatalogueToSmt( StarCatalogue const & catalogue
+		, uint32_t level
+		, std::ostream & stream );
+}
+
+#endif
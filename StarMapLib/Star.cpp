@@ -1,48 +1,52 @@
 #include "Star.h"
 
+#include "StarKernels.h"
+
 namespace starmap
 {
-	namespace
+	Star::Star( uint32_t name
+		, float magnitude
+		, gl::Vec2 const & position
+		, gl::RgbColour const & colour )
+		: Star{ name, magnitude, position, rgbToPaletteIndex( colour ) }
 	{
-		gl::Vec3 doSphericalToCartesian( gl::Vec2 const & coord
-			, float distance = 100.0f )
-		{
-			auto const & ra = coord.x;
-			auto const & dec = coord.y;
-			auto const sinra = sin( ra );
-			auto const cosra = cos( ra );
-			auto const sindec = sin( dec );
-			auto const cosdec = cos( dec );
-			return gl::Vec3
-			{
-				distance * cosdec * cosra,
-				distance * cosdec * sinra,
-				distance * sindec
-			};
-		}
 	}
 
-	Star::Star( std::string const & name
+	Star::Star( uint32_t name
 		, float magnitude
-		, gl::Vec2 const & position
+		, gl::Vec3 const & position
 		, gl::RgbColour const & colour )
-		: m_id{ std::hash< std::string >()( name ) }
-		, m_name{ name }
-		, m_magnitude{ magnitude }
-		, m_position{ doSphericalToCartesian( position ) }
-		, m_colour{ colour }
+		: Star{ name, magnitude, position, rgbToPaletteIndex( colour ) }
 	{
 	}
 
-	Star::Star( std::string const & name
+	Star::Star( uint32_t name
+		, float magnitude
+		, gl::Vec2 const & position
+		, uint8_t colour )
+		: Star{ name, magnitude, gl::Vec3{}, colour }
+	{
+		// Même calcul que pour les lots d'étoiles, afin que les deux chemins
+		// donnent la même direction.
+		packDirections( &position.x, &position.y, 1u, &m_packed.position );
+	}
+
+	Star::Star( uint32_t name
 		, float magnitude
 		, gl::Vec3 const & position
-		, gl::RgbColour const & colour )
-		: m_id{ std::hash< std::string >()( name ) }
-		, m_name{ name }
-		, m_magnitude{ magnitude }
-		, m_position{ gl::normalize( position ) * 100.0f }
-		, m_colour{ colour }
+		, uint8_t colour )
+		: m_name{ name }
+		, m_packed{ gl::packOctahedral( position )
+			, gl::packHalf( magnitude )
+			, colour
+			, 0u }
+	{
+	}
+
+	Star::Star( uint32_t name
+		, PackedStar const & packed )
+		: m_name{ name }
+		, m_packed{ packed }
 	{
 	}
 }
@@ -8,13 +8,55 @@
 #define ___StarMapLib_Star_HPP___
 #pragma once
 
-#include "StarMapLibPrerequisites.h"
+#include "StringView.h"
+
+#include <GlLib/Packing.h>
 
 namespace starmap
 {
+	/**
+	*\brief
+	*	Les données numériques compactées d'une étoile.
+	*/
+	struct PackedStar
+	{
+		//! La direction de l'étoile, en coordonnées octaédriques.
+		gl::U16Vec2 position;
+		//! La magnitude de l'étoile, en demi-flottant.
+		uint16_t magnitude;
+		//! L'index de la couleur de l'étoile dans la palette.
+		uint8_t colour;
+		//! Inutilisé.
+		uint8_t padding;
+	};
+	static_assert( sizeof( PackedStar ) == 8u, "PackedStar must stay compact" );
+	/**
+	*\brief
+	*	Le mouvement propre d'une étoile.
+	*\remarks
+	*	La direction de l'étoile t années après J2000 est celle de
+	*	origin + t.velocity.
+	*/
+	struct StarMotion
+	{
+		//! La direction de l'étoile à l'époque J2000, en coordonnées
+		//! octaédriques.
+		gl::U16Vec2 origin;
+		//! La vitesse de l'étoile, tangente à la sphère unité, en radians
+		//! par an.
+		gl::Vec3 velocity;
+	};
+	//! Un tableau de mouvements propres.
+	using StarMotionArray = std::vector< StarMotion >;
 	/**
 	*\brief
 	*	Une étoile, avec tout le nécessaire permettant de l'afficher.
+	*\remarks
+	*	Les étoiles étant toutes sur la même sphère, seule leur direction
+	*	est conservée.\n
+	*	Le nom n'est pas possédé par l'étoile, il est conservé dans la
+	*	réserve de noms du catalogue (voir StarCatalogue::name), l'étoile
+	*	n'en gardant que la position.
 	*/
 	class Star
 	{
@@ -23,7 +65,8 @@ namespace starmap
 		*\brief
 		*	Constructeur.
 		*\param[in] name
-		*	Le nom de l'étoile.
+		*	La position du nom de l'étoile dans la réserve de noms de son
+		*	catalogue (voir NamePool::add).
 		*\param[in] magnitude
 		*	La magnitude de l'étoile, permettant de la cacher, en fonction
 		*	du zoom.
@@ -34,7 +77,7 @@ namespace starmap
 		*\param[in] colour
 		*	La couleur de l'étoile.
 		*/
-		Star( std::string const & name
+		Star( uint32_t name
 			, float magnitude
 			, gl::Vec2 const & position
 			, gl::RgbColour const & colour );
@@ -42,7 +85,8 @@ namespace starmap
 		*\brief
 		*	Constructeur.
 		*\param[in] name
-		*	Le nom de l'étoile.
+		*	La position du nom de l'étoile dans la réserve de noms de son
+		*	catalogue (voir NamePool::add).
 		*\param[in] magnitude
 		*	La magnitude de l'étoile, permettant de la cacher, en fonction
 		*	du zoom.
@@ -51,43 +95,77 @@ namespace starmap
 		*\param[in] colour
 		*	La couleur de l'étoile.
 		*/
-		Star( std::string const & name
+		Star( uint32_t name
 			, float magnitude
 			, gl::Vec3 const & position
 			, gl::RgbColour const & colour );
 		/**
-		*\return
-		*	L'identifiant de l'étoile.
+		*\brief
+		*	Constructeur.
+		*\param[in] name
+		*	La position du nom de l'étoile dans la réserve de noms de son
+		*	catalogue (voir NamePool::add).
+		*\param[in] magnitude
+		*	La magnitude de l'étoile, permettant de la cacher, en fonction
+		*	du zoom.
+		*\param[in] position
+		*	La position en coordonnées polaires.
+		*	x => ascencion.
+		*	y => déclinaison.
+		*\param[in] colour
+		*	L'index de la couleur de l'étoile dans la palette.
 		*/
-		inline size_t id()const noexcept
-		{
-			return m_id;
-		}
+		Star( uint32_t name
+			, float magnitude
+			, gl::Vec2 const & position
+			, uint8_t colour );
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] name
+		*	La position du nom de l'étoile dans la réserve de noms de son
+		*	catalogue (voir NamePool::add).
+		*\param[in] magnitude
+		*	La magnitude de l'étoile, permettant de la cacher, en fonction
+		*	du zoom.
+		*\param[in] position
+		*	La position en coordonnées cartésiennes.
+		*\param[in] colour
+		*	L'index de la couleur de l'étoile dans la palette.
+		*/
+		Star( uint32_t name
+			, float magnitude
+			, gl::Vec3 const & position
+			, uint8_t colour );
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] name
+		*	La position du nom de l'étoile dans la réserve de noms de son
+		*	catalogue (voir NamePool::add).
+		*\param[in] packed
+		*	Les données compactées de l'étoile (voir packStars).
+		*/
+		Star( uint32_t name
+			, PackedStar const & packed );
 		/**
 		*\return
-		*	L'index de l'étoile.
+		*	La position du nom de l'étoile dans la réserve de noms.
 		*/
-		inline uint32_t index()const noexcept
+		inline uint32_t name()const noexcept
 		{
-			return m_index;
+			return m_name;
 		}
 		/**
 		*\brief
-		*	Définit l'index de l'étoile.
+		*	Définit la position du nom de l'étoile, lorsque la réserve qui le
+		*	contient est fusionnée dans une autre (voir NamePool::merge).
 		*\param[in] value
 		*	La nouvelle valeur.
 		*/
-		inline void index( uint32_t value )noexcept
-		{
-			m_index = value;
-		}
-		/**
-		*\return
-		*	Le nom de l'étoile.
-		*/
-		inline std::string const & name()const noexcept
+		inline void name( uint32_t value )noexcept
 		{
-			return m_name;
+			m_name = value;
 		}
 		/**
 		*\return
@@ -95,15 +173,15 @@ namespace starmap
 		*/
 		inline float magnitude()const noexcept
 		{
-			return m_magnitude;
+			return gl::unpackHalf( m_packed.magnitude );
 		}
 		/**
 		*\return
 		*	La position de l'étoile, en coordonnées cartésiennes.
 		*/
-		inline gl::Vec3 const & position()const noexcept
+		inline gl::Vec3 position()const noexcept
 		{
-			return m_position;
+			return gl::unpackOctahedral( m_packed.position ) * 100.0f;
 		}
 		/**
 		*\return
@@ -111,23 +189,35 @@ namespace starmap
 		*/
 		inline gl::RgbColour const & colour()const noexcept
 		{
-			return m_colour;
+			return paletteColour( m_packed.colour );
+		}
+		/**
+		*\return
+		*	L'index de la couleur de l'étoile dans la palette.
+		*/
+		inline uint8_t paletteIndex()const noexcept
+		{
+			return m_packed.colour;
+		}
+		/**
+		*\return
+		*	Les données numériques compactées de l'étoile.
+		*/
+		inline PackedStar const & packed()const noexcept
+		{
+			return m_packed;
 		}
 
 	private:
-		//! L'identifiant de l'étoile.
-		size_t m_id;
-		//! L'index de l'étoile dans le tableau trié par magnitude.
-		uint32_t m_index;
-		//! Le nom de l'étoile.
-		std::string m_name;
-		//! La magnitude de l'étoile.
-		float m_magnitude;
-		//! La position de l'étoile.
-		gl::Vec3 m_position;
-		//! La couleur de l'étoile.
-		gl::RgbColour m_colour;
+		friend class StarCatalogue;
+
+	private:
+		//! La position du nom de l'étoile dans la réserve de noms.
+		uint32_t m_name;
+		//! La magnitude, la direction et la couleur de l'étoile.
+		PackedStar m_packed;
 	};
+	static_assert( sizeof( Star ) == 12u, "Star must stay compact" );
 	/**
 	*\brief
 	*	Opérateur de comparaison "inférieur à".
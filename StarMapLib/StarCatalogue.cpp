@@ -0,0 +1,690 @@
+#include "StarCatalogue.h"
+
+#include "StarKernels.h"
+
+#include <numeric>
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	L'index d'étoile indiquant une absence de correspondance.
+		*/
+		static uint32_t constexpr NoStar = ~0u;
+		/**
+		*\brief
+		*	La table de jointure, des clés d'identifiants vers les index des
+		*	étoiles.
+		*/
+		using KeyMap = std::unordered_map< uint64_t, uint32_t >;
+		/**
+		*\brief
+		*	La clé de jointure d'un identifiant, le catalogue de
+		*	l'identifiant occupant les 2 bits de poids fort.
+		*/
+		inline uint64_t doMakeKey( uint64_t catalogue
+			, uint64_t value )noexcept
+		{
+			return ( catalogue << 62u )
+				| ( value & ( ( uint64_t( 1u ) << 62u ) - 1u ) );
+		}
+
+		void doAddKeys( KeyMap & keys
+			, StarIdentifiers const & identifiers
+			, uint32_t index )
+		{
+			if ( identifiers.hip )
+			{
+				keys.emplace( doMakeKey( 1u, identifiers.hip ), index );
+			}
+
+			if ( identifiers.hd )
+			{
+				keys.emplace( doMakeKey( 2u, identifiers.hd ), index );
+			}
+
+			if ( identifiers.gl )
+			{
+				keys.emplace( doMakeKey( 3u, identifiers.gl ), index );
+			}
+		}
+
+		uint32_t doFindKey( KeyMap const & keys
+			, StarIdentifiers const & identifiers )
+		{
+			auto it = keys.end();
+
+			if ( identifiers.hip )
+			{
+				it = keys.find( doMakeKey( 1u, identifiers.hip ) );
+			}
+
+			if ( it == keys.end() && identifiers.hd )
+			{
+				it = keys.find( doMakeKey( 2u, identifiers.hd ) );
+			}
+
+			if ( it == keys.end() && identifiers.gl )
+			{
+				it = keys.find( doMakeKey( 3u, identifiers.gl ) );
+			}
+
+			return it == keys.end()
+				? NoStar
+				: it->second;
+		}
+		/**
+		*\brief
+		*	Complète les mouvements propres jusqu'à l'étoile d'index \p end,
+		*	les étoiles sans mouvement propre étant immobiles.
+		*/
+		void doAppendStill( StarArray const & stars
+			, size_t end
+			, StarMotionArray & motions )
+		{
+			motions.reserve( end );
+
+			for ( auto i = motions.size(); i < end; ++i )
+			{
+				motions.push_back( { stars[i].packed().position, gl::Vec3{} } );
+			}
+		}
+	}
+
+	void StarCatalogue::add( Star const & star )
+	{
+		m_stars.push_back( star );
+		doPadStarData();
+		m_sorted = false;
+		m_propagated = false;
+		m_indexed = false;
+		m_searchable = false;
+	}
+
+	void StarCatalogue::add( StarArray const & stars )
+	{
+		m_stars.insert( m_stars.end(), stars.begin(), stars.end() );
+		doPadStarData();
+		m_sorted = false;
+		m_propagated = false;
+		m_indexed = false;
+		m_searchable = false;
+	}
+
+	void StarCatalogue::add( StarArray && stars )
+	{
+		if ( m_stars.empty() )
+		{
+			m_stars = std::move( stars );
+		}
+		else
+		{
+			m_stars.reserve( m_stars.size() + stars.size() );
+			std::move( stars.begin(), stars.end(), std::back_inserter( m_stars ) );
+		}
+
+		stars.clear();
+		doPadStarData();
+		m_sorted = false;
+		m_propagated = false;
+		m_indexed = false;
+		m_searchable = false;
+	}
+
+	void StarCatalogue::add( StarArray && stars
+		, StarIdentifierArray && identifiers
+		, StarMotionArray && motions )
+	{
+		assert( identifiers.empty() || stars.size() == identifiers.size() );
+		assert( motions.empty() || stars.size() == motions.size() );
+		auto first = m_stars.size();
+		add( std::move( stars ) );
+
+		// Les étoiles présentes reçoivent, au besoin, des identifiants vides
+		// et des mouvements propres nuls, les données des nouvelles
+		// remplacent celles complétées pour elles par l'ajout.
+		if ( !identifiers.empty() )
+		{
+			m_identifiers.resize( first );
+			m_identifiers.insert( m_identifiers.end()
+				, identifiers.begin()
+				, identifiers.end() );
+		}
+
+		if ( !motions.empty() )
+		{
+			m_motions.resize( std::min( m_motions.size(), first ) );
+			doAppendStill( m_stars, first, m_motions );
+			m_motions.insert( m_motions.end()
+				, motions.begin()
+				, motions.end() );
+		}
+
+		identifiers.clear();
+		motions.clear();
+	}
+
+	MergeStatistics StarCatalogue::merge( StarArray && stars
+		, StarIdentifierArray && identifiers
+		, StarMotionArray && motions
+		, std::vector< StarFields > const & fields
+		, MergeMode mode )
+	{
+		assert( stars.size() == identifiers.size()
+			&& stars.size() == fields.size() );
+		assert( motions.empty() || stars.size() == motions.size() );
+		MergeStatistics result;
+		result.rows = stars.size();
+
+		if ( mode == MergeMode::eAppend
+			|| stars.empty() )
+		{
+			result.added = stars.size();
+			add( std::move( stars )
+				, std::move( identifiers )
+				, std::move( motions ) );
+			return result;
+		}
+
+		// Jointure par hachage : la table est construite sur les
+		// identifiants du catalogue, puis chaque étoile y est cherchée.
+		// Les étoiles ajoutées y sont insérées, pour que leurs doublons
+		// éventuels les mettent à jour.
+		// Un catalogue chargé sans identifiants (XML, SMC) en reçoit des
+		// vides, comme les mouvements propres via doAppendStill.
+		m_identifiers.resize( m_stars.size() );
+		doPadStarData();
+
+		if ( !motions.empty() )
+		{
+			doAppendStill( m_stars, m_stars.size(), m_motions );
+		}
+
+		KeyMap keys;
+		keys.reserve( 2u * ( m_stars.size() + stars.size() ) );
+		uint32_t index{ 0u };
+
+		for ( auto & star : m_identifiers )
+		{
+			doAddKeys( keys, star, index++ );
+		}
+
+		std::vector< bool > updated( m_stars.size(), false );
+
+		if ( mode == MergeMode::eUpdate )
+		{
+			m_stars.reserve( m_stars.size() + stars.size() );
+			m_identifiers.reserve( m_stars.size() + stars.size() );
+			m_motions.reserve( m_motions.empty() ? 0u : m_stars.size() + stars.size() );
+		}
+
+		for ( size_t i = 0u; i < stars.size(); ++i )
+		{
+			auto found = doFindKey( keys, identifiers[i] );
+
+			if ( found != NoStar )
+			{
+				doUpdate( found
+					, stars[i]
+					, identifiers[i]
+					, motions.empty() ? nullptr : &motions[i]
+					, fields[i] );
+				doAddKeys( keys, m_identifiers[found], found );
+				++result.matched;
+
+				if ( found < updated.size() )
+				{
+					result.duplicates += updated[found] ? 1u : 0u;
+					updated[found] = true;
+				}
+				else
+				{
+					++result.duplicates;
+				}
+			}
+			else if ( mode == MergeMode::eUpdate
+				&& checkFlag( fields[i], StarField::eMagnitude )
+				&& checkFlag( fields[i], StarField::ePosition ) )
+			{
+				doAddKeys( keys, identifiers[i], uint32_t( m_stars.size() ) );
+				m_stars.push_back( std::move( stars[i] ) );
+				m_identifiers.push_back( identifiers[i] );
+
+				if ( !m_motions.empty() )
+				{
+					m_motions.push_back( motions.empty()
+						? StarMotion{ m_stars.back().packed().position, gl::Vec3{} }
+						: motions[i] );
+				}
+
+				++result.added;
+			}
+			else
+			{
+				++result.ignored;
+			}
+		}
+
+		assert( m_identifiers.size() == m_stars.size() );
+		assert( m_motions.empty() || m_motions.size() == m_stars.size() );
+		stars.clear();
+		identifiers.clear();
+		motions.clear();
+		m_sorted = false;
+		m_propagated = false;
+		m_indexed = false;
+		m_searchable = false;
+		return result;
+	}
+
+	void StarCatalogue::add( Constellation const & constellation )
+	{
+		sort();
+		auto it = m_constellations.find( constellation.name() );
+
+		if ( it == m_constellations.end() )
+		{
+			auto it = m_constellations.emplace( constellation.name()
+				, std::make_unique< Constellation >( constellation.name() ) ).first;
+
+			for ( auto & star : constellation.stars() )
+			{
+				it->second->addStar( star.id(), star.letter(), star.name() );
+			}
+
+			it->second->fill( *this );
+			doIndexMembers( *it->second );
+			m_searchable = false;
+		}
+	}
+
+	void StarCatalogue::add( ConstellationPtr constellation )
+	{
+		assert( m_sorted );
+		auto name = constellation->name();
+		auto it = m_constellations.emplace( name, std::move( constellation ) );
+
+		if ( it.second )
+		{
+			doIndexMembers( *it.first->second );
+			m_searchable = false;
+		}
+	}
+
+	void StarCatalogue::add( DeepSkyObjectArray && objects )
+	{
+		auto first = m_deepSkyObjects.size();
+
+		if ( m_deepSkyObjects.empty() )
+		{
+			m_deepSkyObjects = std::move( objects );
+		}
+		else
+		{
+			m_deepSkyObjects.reserve( m_deepSkyObjects.size() + objects.size() );
+			std::move( objects.begin(), objects.end(), std::back_inserter( m_deepSkyObjects ) );
+		}
+
+		for ( auto it = m_deepSkyObjects.begin() + ptrdiff_t( first ); it != m_deepSkyObjects.end(); ++it )
+		{
+			if ( !m_namePool.owns( it->name() ) )
+			{
+				it->name( m_namePool.intern( it->name() ) );
+			}
+		}
+
+		objects.clear();
+		std::stable_sort( std::begin( m_deepSkyObjects )
+			, std::end( m_deepSkyObjects ) );
+	}
+
+	Constellation * StarCatalogue::findConstellation( std::string const & name )
+	{
+		auto it = m_constellations.find( name );
+		Constellation * result{ nullptr };
+
+		if ( it != m_constellations.end() )
+		{
+			result = &( *it->second );
+		}
+		else
+		{
+			std::cerr << "Constellation [" << name << "] not found." << std::endl;
+		}
+
+		return result;
+	}
+
+	Star const * StarCatalogue::findStar( StringView const & name )
+	{
+		sort();
+		auto range = m_names.equal_range( hash( name ) );
+		Star const * result{ nullptr };
+
+		for ( auto it = range.first; it != range.second; ++it )
+		{
+			auto star = &m_stars[it->second];
+
+			if ( this->name( *star ) == name
+				&& ( !result || star < result ) )
+			{
+				result = star;
+			}
+		}
+
+		return result;
+	}
+
+	ConstellationStar const * StarCatalogue::findMembership( Star const & star )const
+	{
+		auto index = size_t( &star - m_stars.data() );
+		ConstellationStar const * result{ nullptr };
+
+		if ( index < m_memberships.size()
+			&& m_memberships[index].constellation )
+		{
+			auto & membership = m_memberships[index];
+			result = &membership.constellation->stars()[membership.member];
+		}
+
+		return result;
+	}
+
+	void StarCatalogue::sort()
+	{
+		auto resorted = false;
+
+		if ( !m_sorted && !m_stars.empty() )
+		{
+			// Des étoiles ajoutées après les constellations entraînent un
+			// nouveau tri : la permutation du tri permet alors de
+			// retrouver les étoiles des constellations, et de réordonner
+			// les identifiants et mouvements propres.
+			resorted = !m_constellations.empty();
+			auto remap = resorted
+				|| !m_identifiers.empty()
+				|| !m_motions.empty();
+			std::vector< uint32_t > indices;
+
+			if ( remap )
+			{
+				std::vector< uint32_t > order( m_stars.size() );
+				std::iota( order.begin(), order.end(), 0u );
+				std::sort( std::begin( order )
+					, std::end( order )
+					, [this]( uint32_t lhs, uint32_t rhs )
+					{
+						auto lmag = m_stars[lhs].magnitude();
+						auto rmag = m_stars[rhs].magnitude();
+						return lmag < rmag
+							|| ( lmag == rmag && lhs < rhs );
+					} );
+				StarArray stars;
+				stars.reserve( m_stars.size() );
+				indices.resize( m_stars.size() );
+
+				for ( auto index : order )
+				{
+					indices[index] = uint32_t( stars.size() );
+					stars.push_back( m_stars[index] );
+				}
+
+				m_stars = std::move( stars );
+			}
+			else
+			{
+				std::sort( std::begin( m_stars )
+					, std::end( m_stars )
+					, []( Star const & lhs, Star const & rhs )
+					{
+						return lhs.magnitude() < rhs.magnitude();
+					} );
+			}
+
+			for ( auto & constellation : m_constellations )
+			{
+				constellation.second->remap( m_stars, indices );
+			}
+
+			if ( !m_identifiers.empty() )
+			{
+				StarIdentifierArray identifiers( m_identifiers.size() );
+
+				for ( size_t i = 0u; i < indices.size(); ++i )
+				{
+					identifiers[indices[i]] = m_identifiers[i];
+				}
+
+				m_identifiers = std::move( identifiers );
+			}
+
+			if ( !m_motions.empty() )
+			{
+				StarMotionArray motions( m_motions.size() );
+
+				for ( size_t i = 0u; i < indices.size(); ++i )
+				{
+					motions[indices[i]] = m_motions[i];
+				}
+
+				m_motions = std::move( motions );
+			}
+
+			// Les étoiles ont bougé, l'index inverse, les colonnes et
+			// l'index spatial ne sont plus valides.
+			m_memberships.clear();
+			m_columns.clear();
+			m_sky.clear();
+
+			std::cout << "Most shiny star: " << name( m_stars.front() ) << "\n"
+				<< "Magnitude : " << m_stars.front().magnitude() << std::endl;
+			std::cout << "Least shiny star: " << name( m_stars.back() ) << "\n"
+				<< "Magnitude : " << m_stars.back().magnitude() << std::endl;
+		}
+
+		m_sorted = true;
+		doIndexNames();
+		doIndexColumns();
+		doIndexSky();
+
+		if ( resorted )
+		{
+			for ( auto & constellation : m_constellations )
+			{
+				doIndexMembers( *constellation.second );
+			}
+		}
+	}
+
+	void StarCatalogue::finalise()
+	{
+		sort();
+
+		if ( !m_searchable )
+		{
+			m_search.build( *this );
+			m_searchable = true;
+		}
+	}
+
+	void StarCatalogue::epoch( float year )
+	{
+		sort();
+
+		// Les positions étant calculées depuis J2000, elles sont déjà
+		// celles voulues si aucune étoile n'a été ajoutée depuis.
+		if ( m_propagated && year == m_epoch )
+		{
+			return;
+		}
+
+		m_epoch = year;
+		m_propagated = true;
+
+		if ( m_motions.empty() )
+		{
+			return;
+		}
+
+		std::vector< gl::U16Vec2 > directions( m_motions.size() );
+		propagateDirections( m_motions.data()
+			, m_motions.size()
+			, year - 2000.0f
+			, directions.data() );
+
+		for ( size_t i = 0u; i < directions.size(); ++i )
+		{
+			m_stars[i].m_packed.position = directions[i];
+		}
+
+		// L'index garde sa répartition, les étoiles ne se déplaçant que peu
+		// d'une époque à l'autre.
+		m_skyTiled = m_sky.update( *this );
+
+		for ( auto & constellation : m_constellations )
+		{
+			constellation.second->updatePosition();
+		}
+	}
+
+	void StarCatalogue::reindex()
+	{
+		sort();
+
+		if ( !m_skyTiled )
+		{
+			m_sky.build( *this );
+			m_skyTiled = true;
+		}
+	}
+
+	std::vector< uint32_t > StarCatalogue::search( StringView const & text
+		, uint32_t limit )
+	{
+		finalise();
+		return m_search.search( text, limit );
+	}
+
+	void StarCatalogue::doPadStarData()
+	{
+		// Les identifiants et mouvements propres ne sont conservés que si au
+		// moins une étoile en a, les étoiles ajoutées sans en reçoivent
+		// alors des vides.
+		if ( !m_identifiers.empty() )
+		{
+			m_identifiers.resize( m_stars.size() );
+		}
+
+		if ( !m_motions.empty() )
+		{
+			doAppendStill( m_stars, m_stars.size(), m_motions );
+		}
+	}
+
+	void StarCatalogue::doUpdate( size_t index
+		, Star & star
+		, StarIdentifiers const & identifiers
+		, StarMotion const * motion
+		, StarFields fields )
+	{
+		auto & target = m_stars[index];
+
+		if ( checkFlag( fields, StarField::eName ) )
+		{
+			target.m_name = star.m_name;
+		}
+
+		if ( checkFlag( fields, StarField::eMagnitude ) )
+		{
+			target.m_packed.magnitude = star.m_packed.magnitude;
+		}
+
+		if ( checkFlag( fields, StarField::ePosition ) )
+		{
+			target.m_packed.position = star.m_packed.position;
+
+			if ( !m_motions.empty() )
+			{
+				m_motions[index].origin = star.m_packed.position;
+			}
+		}
+
+		if ( checkFlag( fields, StarField::eColour ) )
+		{
+			target.m_packed.colour = star.m_packed.colour;
+		}
+
+		if ( checkFlag( fields, StarField::eMotion )
+			&& motion
+			&& !m_motions.empty() )
+		{
+			m_motions[index].velocity = motion->velocity;
+		}
+
+		auto & known = m_identifiers[index];
+		known.hip = known.hip ? known.hip : identifiers.hip;
+		known.hd = known.hd ? known.hd : identifiers.hd;
+		known.gl = known.gl ? known.gl : identifiers.gl;
+	}
+
+	void StarCatalogue::doIndexNames()
+	{
+		if ( !m_indexed )
+		{
+			// L'index ne contient que les hash des noms, pas les chaînes.
+			m_names.clear();
+			m_names.reserve( m_stars.size() );
+			uint32_t index{ 0u };
+
+			for ( auto & star : m_stars )
+			{
+				m_names.emplace( hash( name( star ) ), index++ );
+			}
+
+			m_indexed = true;
+		}
+	}
+
+	void StarCatalogue::doIndexColumns()
+	{
+		if ( m_columns.size() != m_stars.size() )
+		{
+			m_columns.build( m_stars );
+		}
+	}
+
+	void StarCatalogue::doIndexSky()
+	{
+		if ( m_sky.size() != m_stars.size() )
+		{
+			m_sky.build( *this );
+			m_skyTiled = true;
+		}
+	}
+
+	void StarCatalogue::doIndexMembers( Constellation const & constellation )
+	{
+		doIndexColumns();
+		m_memberships.resize( m_stars.size(), Membership{ nullptr, 0u } );
+		uint32_t member{ 0u };
+
+		for ( auto & star : constellation.stars() )
+		{
+			if ( star.filled() )
+			{
+				auto index = size_t( &star.star() - m_stars.data() );
+				assert( index < m_stars.size() );
+
+				if ( !m_memberships[index].constellation )
+				{
+					m_memberships[index] = { &constellation, member };
+					m_columns.addFlag( index, StarFlag::eMember );
+				}
+			}
+
+			++member;
+		}
+	}
+}
@@ -0,0 +1,441 @@
+/**
+*\file
+*	StarCatalogue.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_StarCatalogue_HPP___
+#define ___StarMapLib_StarCatalogue_HPP___
+#pragma once
+
+#include "CatalogueMerge.h"
+#include "Constellation.h"
+#include "DeepSkyObject.h"
+#include "NamePool.h"
+#include "SearchIndex.h"
+#include "SkyIndex.h"
+#include "StarTable.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Le catalogue des étoiles et des constellations.
+	*\remarks
+	*	Ne dépend d'aucune ressource GPU, il peut donc être rempli sur un
+	*	autre thread que celui du rendu.\n
+	*	Les constellations référencent les étoiles du catalogue : déplacer
+	*	le catalogue conserve ces références, pas le copier.\n
+	*	Les noms des étoiles sont conservés dans la réserve de noms du
+	*	catalogue, les étoiles n'en gardant que la position : les noms des
+	*	étoiles ajoutées doivent donc y avoir été copiés (voir namePool).
+	*/
+	class StarCatalogue
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*/
+		StarCatalogue() = default;
+		StarCatalogue( StarCatalogue const & ) = delete;
+		StarCatalogue & operator=( StarCatalogue const & ) = delete;
+		StarCatalogue( StarCatalogue && ) = default;
+		StarCatalogue & operator=( StarCatalogue && ) = default;
+		/**
+		*\brief
+		*	Ajoute une étoile au catalogue.
+		*\param[in] star
+		*	L'étoile.
+		*/
+		void add( Star const & star );
+		/**
+		*\brief
+		*	Ajoute une liste d'étoiles au catalogue.
+		*\param[in] stars
+		*	La liste d'étoiles.
+		*/
+		void add( StarArray const & stars );
+		/**
+		*\brief
+		*	Ajoute une liste d'étoiles au catalogue, en une fois.
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*/
+		void add( StarArray && stars );
+		/**
+		*\brief
+		*	Ajoute une liste d'étoiles au catalogue, en une fois, avec leurs
+		*	identifiants dans les catalogues de référence et leurs
+		*	mouvements propres.
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*\param[in] identifiers
+		*	Les identifiants, un par étoile, dont le contenu est déplacé.
+		*\param[in] motions
+		*	Les mouvements propres, un par étoile, dont le contenu est
+		*	déplacé.
+		*/
+		void add( StarArray && stars
+			, StarIdentifierArray && identifiers
+			, StarMotionArray && motions );
+		/**
+		*\brief
+		*	Fusionne une liste d'étoiles avec celles du catalogue.
+		*\remarks
+		*	Chaque étoile est jointe aux étoiles du catalogue par ses
+		*	identifiants Hipparcos, puis Henry Draper, puis Gliese, via une
+		*	table de hachage construite une fois sur les identifiants du
+		*	catalogue.\n
+		*	Une étoile jointe met à jour sur place les attributs qu'elle
+		*	renseigne, ainsi que les identifiants manquants. Selon le mode,
+		*	les autres sont ajoutées, si elles renseignent leur magnitude et
+		*	leur position, ou ignorées.\n
+		*	Les étoiles sont triées à nouveau lors du prochain tri.
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*\param[in] identifiers
+		*	Les identifiants, un par étoile, dont le contenu est déplacé.
+		*\param[in] motions
+		*	Les mouvements propres, un par étoile, dont le contenu est
+		*	déplacé.
+		*\param[in] fields
+		*	Les attributs renseignés, un par étoile.
+		*\param[in] mode
+		*	Le mode de fusion.
+		*\return
+		*	Le bilan de la fusion.
+		*/
+		MergeStatistics merge( StarArray && stars
+			, StarIdentifierArray && identifiers
+			, StarMotionArray && motions
+			, std::vector< StarFields > const & fields
+			, MergeMode mode );
+		/**
+		*\brief
+		*	Ajoute une constellation au catalogue.
+		*\remarks
+		*	Trie les étoiles, puis finalise la constellation avec celles-ci.
+		*	Les étoiles ajoutées ensuite entraînent un nouveau tri, lors
+		*	duquel les constellations sont mises à jour.\n
+		*	Pour un grand nombre d'étoiles et de constellations, préférer
+		*	CatalogueBuilder, qui ne trie qu'une fois.
+		*\param[in] constellation
+		*	La constellation.
+		*/
+		void add( Constellation const & constellation );
+		/**
+		*\brief
+		*	Ajoute une constellation déjà finalisée au catalogue.
+		*\remarks
+		*	Les étoiles de la constellation doivent être celles du catalogue,
+		*	qui doit donc être trié.
+		*\param[in] constellation
+		*	La constellation.
+		*/
+		void add( ConstellationPtr constellation );
+		/**
+		*\brief
+		*	Ajoute des objets du ciel profond au catalogue.
+		*\remarks
+		*	Les objets sont gardés à part des étoiles, triés par magnitude,
+		*	afin que leurs billboards puissent être coupés au seuil de
+		*	magnitude de la scène.
+		*\param[in] objects
+		*	Les objets, dont le contenu est déplacé.
+		*/
+		void add( DeepSkyObjectArray && objects );
+		/**
+		*\brief
+		*	Recherche une constellation dans le catalogue.
+		*\param[in] name
+		*	Le nom de la constellation.
+		*\return
+		*	La constellation, \p nullptr si non trouvée.
+		*/
+		Constellation * findConstellation( std::string const & name );
+		/**
+		*\brief
+		*	Recherche une étoile dans le catalogue, par son nom.
+		*\remarks
+		*	Trie les étoiles si nécessaire. La recherche utilise l'index des
+		*	noms, construit lors de la finalisation du catalogue.\n
+		*	Si plusieurs étoiles ont le même nom, la plus brillante est
+		*	retournée.
+		*\param[in] name
+		*	Le nom de l'étoile.
+		*\return
+		*	L'étoile, \p nullptr si non trouvée.
+		*/
+		Star const * findStar( StringView const & name );
+		/**
+		*\brief
+		*	Recherche la constellation à laquelle appartient une étoile.
+		*\remarks
+		*	Utilise l'index inverse des membres des constellations, mis à jour
+		*	lors de l'ajout de chaque constellation.\n
+		*	Si l'étoile appartient à plusieurs constellations, la première
+		*	ajoutée est retenue.
+		*\param[in] star
+		*	L'étoile, qui doit appartenir au catalogue.
+		*\return
+		*	L'étoile dans sa constellation (qui donne la constellation, la
+		*	lettre de Bayer et le numéro de Flamsteed), \p nullptr si elle
+		*	n'appartient à aucune constellation.
+		*/
+		ConstellationStar const * findMembership( Star const & star )const;
+		/**
+		*\brief
+		*	Trie les étoiles par magnitude, leur attribue leur index, puis
+		*	indexe leurs noms et leurs positions, et remplit les colonnes.
+		*/
+		void sort();
+		/**
+		*\brief
+		*	Finalise le catalogue : trie les étoiles, puis construit l'index
+		*	de recherche.
+		*\remarks
+		*	Peut être appelé sur un thread de travail.
+		*/
+		void finalise();
+		/**
+		*\brief
+		*	Déplace les étoiles à leurs positions à l'époque donnée, selon
+		*	leurs mouvements propres.
+		*\remarks
+		*	Trie les étoiles si nécessaire. Les positions sont toujours
+		*	calculées depuis celles de J2000, par propagateDirections, puis
+		*	l'index spatial (voir SkyIndex::update) et les positions des
+		*	constellations sont mis à jour.\n
+		*	Les étoiles ajoutées ou fusionnées ensuite le sont à leur
+		*	position de J2000, jusqu'au prochain appel. Sans ajout depuis,
+		*	un appel pour la même époque ne fait rien.
+		*\param[in] year
+		*	L'année de l'époque, 2000 pour J2000.
+		*/
+		void epoch( float year );
+		/**
+		*\brief
+		*	Reconstruit l'index spatial si des étoiles ont quitté la tuile
+		*	de leur feuille depuis sa construction.
+		*/
+		void reindex();
+		/**
+		*\brief
+		*	Recherche les étoiles dont un des noms commence par le texte donné.
+		*\remarks
+		*	Finalise le catalogue si nécessaire.
+		*\param[in] text
+		*	Le texte recherché.
+		*\param[in] limit
+		*	Le nombre maximal de résultats.
+		*\return
+		*	Les index des étoiles trouvées.
+		*\see
+		*	SearchIndex::search
+		*/
+		std::vector< uint32_t > search( StringView const & text
+			, uint32_t limit );
+		/**
+		*\return
+		*	Les étoiles.
+		*/
+		inline StarArray const & stars()const noexcept
+		{
+			return m_stars;
+		}
+		/**
+		*\remarks
+		*	Les étoiles ne doivent pas être ajoutées ni renommées par ce
+		*	biais une fois le catalogue trié : les index ne seraient pas
+		*	mis à jour.
+		*\return
+		*	Les étoiles.
+		*/
+		inline StarArray & stars()noexcept
+		{
+			return m_stars;
+		}
+		/**
+		*\return
+		*	Les identifiants des étoiles dans les catalogues de référence,
+		*	vide si aucun n'est connu, une entrée par étoile sinon.
+		*/
+		inline StarIdentifierArray const & identifiers()const noexcept
+		{
+			return m_identifiers;
+		}
+		/**
+		*\return
+		*	Les mouvements propres des étoiles, vide si aucun n'est connu,
+		*	une entrée par étoile sinon.
+		*/
+		inline StarMotionArray const & motions()const noexcept
+		{
+			return m_motions;
+		}
+		/**
+		*\return
+		*	L'année de l'époque des positions des étoiles.
+		*/
+		inline float epoch()const noexcept
+		{
+			return m_epoch;
+		}
+		/**
+		*\remarks
+		*	Remplies lors du tri.
+		*\return
+		*	Les données dérivées des étoiles triées, par colonnes.
+		*/
+		inline StarTable const & columns()const noexcept
+		{
+			return m_columns;
+		}
+		/**
+		*\remarks
+		*	Rempli lors du tri, mis à jour en place lors d'un changement
+		*	d'époque.
+		*\return
+		*	L'index spatial des étoiles triées.
+		*/
+		inline SkyIndex const & skyIndex()const noexcept
+		{
+			return m_sky;
+		}
+		/**
+		*\return
+		*	\p false si des étoiles ont quitté la tuile de leur feuille
+		*	de l'index spatial, voir reindex.
+		*/
+		inline bool skyTiled()const noexcept
+		{
+			return m_skyTiled;
+		}
+		/**
+		*\remarks
+		*	Les chargeurs y copient les noms des étoiles avant de les ajouter,
+		*	directement ou en y fusionnant leurs propres réserves.
+		*\return
+		*	La réserve des noms des étoiles.
+		*/
+		inline NamePool & namePool()noexcept
+		{
+			return m_namePool;
+		}
+		/**
+		*\return
+		*	La réserve des noms des étoiles.
+		*/
+		inline NamePool const & namePool()const noexcept
+		{
+			return m_namePool;
+		}
+		/**
+		*\param[in] star
+		*	Une étoile du catalogue.
+		*\return
+		*	Le nom de l'étoile.
+		*/
+		inline StringView name( Star const & star )const noexcept
+		{
+			return m_namePool.get( star.name() );
+		}
+		/**
+		*\return
+		*	Les objets du ciel profond, triés par magnitude.
+		*/
+		inline DeepSkyObjectArray const & deepSkyObjects()const noexcept
+		{
+			return m_deepSkyObjects;
+		}
+		/**
+		*\return
+		*	Les constellations.
+		*/
+		inline ConstellationMap const & constellations()const noexcept
+		{
+			return m_constellations;
+		}
+		/**
+		*\return
+		*	\p true si les étoiles sont triées.
+		*/
+		inline bool sorted()const noexcept
+		{
+			return m_sorted;
+		}
+		/**
+		*\brief
+		*	Indique que les étoiles sont déjà triées, et indexées.
+		*/
+		inline void sorted( bool value )noexcept
+		{
+			m_sorted = value;
+		}
+
+	private:
+		/**
+		*\brief
+		*	L'appartenance d'une étoile à une constellation.
+		*/
+		struct Membership
+		{
+			//! La constellation, \p nullptr si aucune.
+			Constellation const * constellation;
+			//! L'index de l'étoile dans la constellation.
+			uint32_t member;
+		};
+
+	private:
+		void doPadStarData();
+		void doUpdate( size_t index
+			, Star & star
+			, StarIdentifiers const & identifiers
+			, StarMotion const * motion
+			, StarFields fields );
+		void doIndexNames();
+		void doIndexColumns();
+		void doIndexSky();
+		void doIndexMembers( Constellation const & constellation );
+
+	private:
+		//! Les noms des étoiles.
+		NamePool m_namePool;
+		//! Les étoiles.
+		StarArray m_stars;
+		//! Les identifiants des étoiles, vide si aucun n'est connu.
+		StarIdentifierArray m_identifiers;
+		//! Les mouvements propres des étoiles, vide si aucun n'est connu.
+		StarMotionArray m_motions;
+		//! L'année de l'époque des positions des étoiles.
+		float m_epoch{ 2000.0f };
+		//! Dit si toutes les étoiles sont à leur position de m_epoch.
+		bool m_propagated{ true };
+		//! Dit si les étoiles sont triées.
+		bool m_sorted{ false };
+		//! Les constellations.
+		ConstellationMap m_constellations;
+		//! Les objets du ciel profond, triés par magnitude.
+		DeepSkyObjectArray m_deepSkyObjects;
+		//! L'index des étoiles, par hash de leur nom, seul endroit où ce
+		//! hash est conservé.
+		std::unordered_multimap< size_t, uint32_t > m_names;
+		//! Dit si l'index des noms est à jour.
+		bool m_indexed{ false };
+		//! Les données dérivées des étoiles triées, par colonnes.
+		StarTable m_columns;
+		//! L'index inverse des membres des constellations, par index d'étoile.
+		std::vector< Membership > m_memberships;
+		//! L'index de recherche par nom.
+		SearchIndex m_search;
+		//! Dit si l'index de recherche est à jour.
+		bool m_searchable{ false };
+		//! L'index spatial des étoiles triées.
+		SkyIndex m_sky;
+		//! Dit si chaque étoile est dans la tuile de sa feuille de m_sky.
+		bool m_skyTiled{ true };
+	};
+}
+
+#endif
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Constellation.h"
+#include "DeepSkyObject.h"
 #include "Star.h"
 
 #include <RenderLib/CameraState.h>
@@ -30,11 +31,49 @@ namespace starmap
 
 		gl::RgbColour m_colour;
 		render::BillboardBufferPtr m_buffer;
+		render::BillboardPtr m_billboard;
 		bool m_initialised{ false };
 		StarPtrArray m_stars;
 	};
 	//! Un tableau de StarHolder.
 	using StarHolderArray = std::vector< StarHolder >;
+	/**
+	*\brief
+	*	L'emplacement d'une étoile dans les conteneurs de billboards.
+	*/
+	struct StarSlot
+	{
+		//! L'indice du conteneur, ~0u si l'étoile n'est pas affichée.
+		uint32_t m_holder{ ~0u };
+		//! L'indice de l'étoile dans le conteneur, et donc du billboard.
+		uint32_t m_index{ 0u };
+	};
+	//! Un tableau de StarSlot.
+	using StarSlotArray = std::vector< StarSlot >;
+	/**
+	*\brief
+	*	Structure contenant les billboards pour une famille et une taille
+	*	d'objets du ciel profond.
+	*/
+	struct DeepSkyHolder
+	{
+		DeepSkyHolder( DeepSkyType type
+			, DeepSkyTier tier
+			, render::BillboardBufferPtr buffer )
+			: m_type{ type }
+			, m_tier{ tier }
+			, m_buffer{ buffer }
+		{
+		}
+
+		DeepSkyType m_type;
+		DeepSkyTier m_tier;
+		render::BillboardBufferPtr m_buffer;
+		bool m_initialised{ false };
+		DeepSkyObjectPtrArray m_objects;
+	};
+	//! Un tableau de DeepSkyHolder.
+	using DeepSkyHolderArray = std::vector< DeepSkyHolder >;
 }
 
 #endif
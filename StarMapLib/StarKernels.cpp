@@ -0,0 +1,387 @@
+#include "StarKernels.h"
+
+namespace starmap
+{
+	namespace
+	{
+		/**
+		*\brief
+		*	La taille des tranches traitées par packStars.
+		*/
+		static size_t constexpr TileSize = 256u;
+		//! 4 / pi.
+		static float constexpr FourOverPi = 1.27323954473516f;
+		//! pi / 4, en trois parties pour une réduction d'argument exacte.
+		static float constexpr QuarterPi1 = 0.78515625f;
+		static float constexpr QuarterPi2 = 2.4187564849853515625e-4f;
+		static float constexpr QuarterPi3 = 3.77489497744594108e-8f;
+
+		inline float doSignNotZero( float value )noexcept
+		{
+			return value >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		inline uint16_t doPackSnorm16( float value )noexcept
+		{
+			// ( value * 0.5 + 0.5 ) * 65535, arrondi, la saturation étant
+			// faite après la mise à l'échelle pour rester vectorisable.
+			value = value * 32767.5f + 32768.0f;
+			value = std::min( 65535.0f, std::max( 0.0f, value ) );
+			return uint16_t( int32_t( value ) );
+		}
+		/**
+		*\brief
+		*	Equivalent de gl::packOctahedral pour des directions non nulles
+		*	rangées par composantes, sans appel à lround, afin d'être
+		*	vectorisé.
+		*/
+		void doPackOctahedral( float const * xs
+			, float const * ys
+			, float const * zs
+			, size_t count
+			, uint16_t * us
+			, uint16_t * vs )noexcept
+		{
+			for ( size_t i = 0u; i < count; ++i )
+			{
+				auto norm = 1.0f / ( std::abs( xs[i] )
+					+ std::abs( ys[i] )
+					+ std::abs( zs[i] ) );
+				auto x = xs[i] * norm;
+				auto y = ys[i] * norm;
+				auto fx = ( 1.0f - std::abs( y ) ) * doSignNotZero( x );
+				auto fy = ( 1.0f - std::abs( x ) ) * doSignNotZero( y );
+				auto fold = zs[i] < 0.0f;
+				us[i] = doPackSnorm16( fold ? fx : x );
+				vs[i] = doPackSnorm16( fold ? fy : y );
+			}
+		}
+		/**
+		*\brief
+		*	Equivalent de gl::unpackOctahedral pour les origines d'une suite
+		*	de mouvements propres, avec un résultat rangé par composantes.
+		*/
+		void doUnpackOrigins( StarMotion const * motions
+			, size_t count
+			, float * xs
+			, float * ys
+			, float * zs )noexcept
+		{
+			for ( size_t i = 0u; i < count; ++i )
+			{
+				auto x = float( motions[i].origin.x ) / 65535.0f * 2.0f - 1.0f;
+				auto y = float( motions[i].origin.y ) / 65535.0f * 2.0f - 1.0f;
+				auto z = 1.0f - std::abs( x ) - std::abs( y );
+				auto t = std::max( -z, 0.0f );
+				x += x >= 0.0f ? -t : t;
+				y += y >= 0.0f ? -t : t;
+				auto norm = 1.0f / std::sqrt( x * x + y * y + z * z );
+				xs[i] = x * norm;
+				ys[i] = y * norm;
+				zs[i] = z * norm;
+			}
+		}
+	}
+
+	void StarBatch::reserve( size_t count )
+	{
+		names.reserve( count );
+		magnitudes.reserve( count );
+		ascensions.reserve( count );
+		declinations.reserve( count );
+		colourIndices.reserve( count );
+		ascensionMotions.reserve( count );
+		declinationMotions.reserve( count );
+	}
+
+	void StarBatch::clear()noexcept
+	{
+		names.clear();
+		magnitudes.clear();
+		ascensions.clear();
+		declinations.clear();
+		colourIndices.clear();
+		ascensionMotions.clear();
+		declinationMotions.clear();
+	}
+
+	void sinCos( float const * angles
+		, size_t count
+		, float * sines
+		, float * cosines )noexcept
+	{
+		for ( size_t i = 0u; i < count; ++i )
+		{
+			auto x = std::abs( angles[i] );
+			auto sign = std::copysign( 1.0f, angles[i] );
+
+			// Réduction dans [-pi/4, pi/4], j étant l'octant pair le plus proche.
+			auto j = ( int32_t( x * FourOverPi ) + 1 ) & ~1;
+			auto y = float( j );
+			auto z = ( ( x - y * QuarterPi1 ) - y * QuarterPi2 ) - y * QuarterPi3;
+			auto zz = z * z;
+			auto s = ( ( -1.9515295891e-4f * zz
+				+ 8.3321608736e-3f ) * zz
+				- 1.6666654611e-1f ) * zz * z + z;
+			auto c = ( ( 2.443315711809948e-5f * zz
+				- 1.388731625493765e-3f ) * zz
+				+ 4.166664568298827e-2f ) * zz * zz
+				- 0.5f * zz + 1.0f;
+
+			// Le quadrant choisit entre les deux polynômes, et leurs signes.
+			// Les choix sont faits par calcul plutôt que par condition, pour
+			// que la boucle reste vectorisable.
+			auto quadrant = ( j >> 1 ) & 3;
+			auto swap = float( quadrant & 1 );
+			auto sinSign = sign * ( 1.0f - float( quadrant & 2 ) );
+			auto cosSign = 1.0f - float( ( quadrant + 1 ) & 2 );
+			sines[i] = sinSign * ( s * ( 1.0f - swap ) + c * swap );
+			cosines[i] = cosSign * ( c * ( 1.0f - swap ) + s * swap );
+		}
+	}
+
+	void sphericalToCartesian( float const * ra
+		, float const * dec
+		, size_t count
+		, gl::Vec3 * directions )noexcept
+	{
+		std::array< float, TileSize > sinra;
+		std::array< float, TileSize > cosra;
+		std::array< float, TileSize > sindec;
+		std::array< float, TileSize > cosdec;
+
+		for ( size_t first = 0u; first < count; first += TileSize )
+		{
+			auto size = std::min( TileSize, count - first );
+			sinCos( ra + first, size, sinra.data(), cosra.data() );
+			sinCos( dec + first, size, sindec.data(), cosdec.data() );
+
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				directions[first + i] = gl::Vec3
+				{
+					cosdec[i] * cosra[i],
+					cosdec[i] * sinra[i],
+					sindec[i]
+				};
+			}
+		}
+	}
+
+	void packDirections( float const * ra
+		, float const * dec
+		, size_t count
+		, gl::U16Vec2 * result )noexcept
+	{
+		std::array< float, TileSize > sinra;
+		std::array< float, TileSize > cosra;
+		std::array< float, TileSize > sindec;
+		std::array< float, TileSize > cosdec;
+		std::array< uint16_t, TileSize > us;
+		std::array< uint16_t, TileSize > vs;
+
+		for ( size_t first = 0u; first < count; first += TileSize )
+		{
+			auto size = std::min( TileSize, count - first );
+			sinCos( ra + first, size, sinra.data(), cosra.data() );
+			sinCos( dec + first, size, sindec.data(), cosdec.data() );
+
+			// Les composantes x et y remplacent les cosinus et sinus de
+			// l'ascension droite.
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				cosra[i] *= cosdec[i];
+				sinra[i] *= cosdec[i];
+			}
+
+			doPackOctahedral( cosra.data()
+				, sinra.data()
+				, sindec.data()
+				, size
+				, us.data()
+				, vs.data() );
+
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				result[first + i] = gl::U16Vec2{ us[i], vs[i] };
+			}
+		}
+	}
+
+	void packStars( StarBatch const & batch
+		, PackedStar * result )
+	{
+		std::array< gl::U16Vec2, TileSize > directions;
+		std::array< uint8_t, TileSize > colours;
+		auto count = batch.size();
+
+		for ( size_t first = 0u; first < count; first += TileSize )
+		{
+			auto size = std::min( TileSize, count - first );
+			packDirections( batch.ascensions.data() + first
+				, batch.declinations.data() + first
+				, size
+				, directions.data() );
+			bvToPaletteIndices( batch.colourIndices.data() + first
+				, size
+				, colours.data() );
+
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				result[first + i] = PackedStar
+				{
+					directions[i],
+					gl::packHalf( batch.magnitudes[first + i] ),
+					colours[i],
+					0u
+				};
+			}
+		}
+	}
+
+	void appendStars( StarBatch const & batch
+		, StarArray & stars )
+	{
+		std::vector< PackedStar > packed( batch.size() );
+		packStars( batch, packed.data() );
+		stars.reserve( stars.size() + batch.size() );
+
+		for ( size_t i = 0u; i < batch.size(); ++i )
+		{
+			stars.emplace_back( batch.names[i], packed[i] );
+		}
+	}
+
+	void motionVelocities( float const * ra
+		, float const * dec
+		, float const * pmra
+		, float const * pmdec
+		, size_t count
+		, gl::Vec3 * velocities )noexcept
+	{
+		std::array< float, TileSize > sinra;
+		std::array< float, TileSize > cosra;
+		std::array< float, TileSize > sindec;
+		std::array< float, TileSize > cosdec;
+
+		for ( size_t first = 0u; first < count; first += TileSize )
+		{
+			auto size = std::min( TileSize, count - first );
+			sinCos( ra + first, size, sinra.data(), cosra.data() );
+			sinCos( dec + first, size, sindec.data(), cosdec.data() );
+
+			// Combinaison des vecteurs unitaires locaux, vers l'est
+			// (-sin ra, cos ra, 0) et vers le nord
+			// (-sin dec cos ra, -sin dec sin ra, cos dec).
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				auto east = pmra[first + i];
+				auto north = pmdec[first + i];
+				velocities[first + i] = gl::Vec3
+				{
+					-east * sinra[i] - north * sindec[i] * cosra[i],
+					east * cosra[i] - north * sindec[i] * sinra[i],
+					north * cosdec[i]
+				};
+			}
+		}
+	}
+
+	void appendMotions( StarBatch const & batch
+		, StarArray const & stars
+		, StarMotionArray & motions )
+	{
+		assert( stars.size() >= batch.size() );
+		auto count = batch.size();
+		auto first = stars.size() - count;
+		std::vector< gl::Vec3 > velocities( count );
+		motionVelocities( batch.ascensions.data()
+			, batch.declinations.data()
+			, batch.ascensionMotions.data()
+			, batch.declinationMotions.data()
+			, count
+			, velocities.data() );
+		motions.reserve( motions.size() + count );
+
+		for ( size_t i = 0u; i < count; ++i )
+		{
+			motions.push_back( { stars[first + i].packed().position
+				, velocities[i] } );
+		}
+	}
+
+	void propagateDirections( StarMotion const * motions
+		, size_t count
+		, float years
+		, gl::U16Vec2 * result )noexcept
+	{
+		std::array< float, TileSize > xs;
+		std::array< float, TileSize > ys;
+		std::array< float, TileSize > zs;
+		std::array< uint16_t, TileSize > us;
+		std::array< uint16_t, TileSize > vs;
+
+		for ( size_t first = 0u; first < count; first += TileSize )
+		{
+			auto size = std::min( TileSize, count - first );
+			doUnpackOrigins( motions + first
+				, size
+				, xs.data()
+				, ys.data()
+				, zs.data() );
+
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				auto & velocity = motions[first + i].velocity;
+				xs[i] += years * velocity.x;
+				ys[i] += years * velocity.y;
+				zs[i] += years * velocity.z;
+			}
+
+			doPackOctahedral( xs.data()
+				, ys.data()
+				, zs.data()
+				, size
+				, us.data()
+				, vs.data() );
+
+			for ( size_t i = 0u; i < size; ++i )
+			{
+				result[first + i] = gl::U16Vec2{ us[i], vs[i] };
+			}
+		}
+	}
+
+	void magnitudeScales( float const * magnitudes
+		, size_t count
+		, render::Range< float > const & range
+		, float * scales )noexcept
+	{
+		// 0.1 + range.invpercent( magnitude ), sans branchement.
+		auto lower = range.lower();
+		auto upper = range.upper();
+		auto factor = 1.0f / ( lower - upper );
+
+		for ( size_t i = 0u; i < count; ++i )
+		{
+			auto magnitude = std::min( std::max( magnitudes[i], lower ), upper );
+			scales[i] = 1.1f - ( lower - magnitude ) * factor;
+		}
+	}
+
+	void magnitudeScales( Star const * stars
+		, size_t count
+		, render::Range< float > const & range
+		, float * scales )noexcept
+	{
+		auto lower = range.lower();
+		auto upper = range.upper();
+		auto factor = 1.0f / ( lower - upper );
+
+		for ( size_t i = 0u; i < count; ++i )
+		{
+			auto magnitude = std::min( std::max( stars[i].magnitude(), lower ), upper );
+			scales[i] = 1.1f - ( lower - magnitude ) * factor;
+		}
+	}
+}
@@ -0,0 +1,244 @@
+/**
+*\file
+*	StarKernels.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_StarKernels_HPP___
+#define ___StarMapLib_StarKernels_HPP___
+#pragma once
+
+#include "Star.h"
+
+#include <RenderLib/Range.h>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les données brutes d'un lot d'étoiles, telles que lues dans un
+	*	catalogue, rangées par colonnes.
+	*/
+	struct StarBatch
+	{
+		/**
+		*\brief
+		*	Réserve la place pour le nombre d'étoiles donné.
+		*/
+		void reserve( size_t count );
+		/**
+		*\brief
+		*	Vide le lot.
+		*/
+		void clear()noexcept;
+		/**
+		*\return
+		*	Le nombre d'étoiles du lot.
+		*/
+		inline size_t size()const noexcept
+		{
+			return magnitudes.size();
+		}
+		/**
+		*\brief
+		*	Ajoute une étoile au lot.
+		*/
+		inline void push( uint32_t name
+			, float magnitude
+			, float ra
+			, float dec
+			, float bv
+			, float pmra = 0.0f
+			, float pmdec = 0.0f )
+		{
+			names.push_back( name );
+			magnitudes.push_back( magnitude );
+			ascensions.push_back( ra );
+			declinations.push_back( dec );
+			colourIndices.push_back( bv );
+			ascensionMotions.push_back( pmra );
+			declinationMotions.push_back( pmdec );
+		}
+
+		//! Les positions des noms des étoiles dans leur réserve.
+		std::vector< uint32_t > names;
+		//! Les magnitudes.
+		std::vector< float > magnitudes;
+		//! Les ascensions droites, en radians.
+		std::vector< float > ascensions;
+		//! Les déclinaisons, en radians.
+		std::vector< float > declinations;
+		//! Les index de couleur B-V.
+		std::vector< float > colourIndices;
+		//! Les mouvements propres en ascension droite (multipliés par le
+		//! cosinus de la déclinaison), en radians par an.
+		std::vector< float > ascensionMotions;
+		//! Les mouvements propres en déclinaison, en radians par an.
+		std::vector< float > declinationMotions;
+	};
+	/**
+	*\brief
+	*	Calcule les sinus et cosinus d'une suite d'angles.
+	*\remarks
+	*	Approximation polynomiale sans branchement, que le compilateur peut
+	*	vectoriser. L'erreur est de l'ordre de la précision d'un float pour
+	*	les angles de quelques tours.
+	*\param[in] angles
+	*	Les angles, en radians.
+	*\param[in] count
+	*	Le nombre d'angles.
+	*\param[out] sines, cosines
+	*	Reçoivent les sinus et cosinus.
+	*/
+	void sinCos( float const * angles
+		, size_t count
+		, float * sines
+		, float * cosines )noexcept;
+	/**
+	*\brief
+	*	Convertit des coordonnées équatoriales en directions cartésiennes.
+	*\param[in] ra, dec
+	*	Les ascensions droites et déclinaisons, en radians.
+	*\param[in] count
+	*	Le nombre de coordonnées.
+	*\param[out] directions
+	*	Reçoit les directions, normalisées.
+	*/
+	void sphericalToCartesian( float const * ra
+		, float const * dec
+		, size_t count
+		, gl::Vec3 * directions )noexcept;
+	/**
+	*\brief
+	*	Convertit des coordonnées équatoriales en directions octaédriques.
+	*\remarks
+	*	Equivalent à sphericalToCartesian suivi de gl::packOctahedral, à un
+	*	arrondi près.
+	*\param[in] ra, dec
+	*	Les ascensions droites et déclinaisons, en radians.
+	*\param[in] count
+	*	Le nombre de coordonnées.
+	*\param[out] result
+	*	Reçoit les directions compactées.
+	*/
+	void packDirections( float const * ra
+		, float const * dec
+		, size_t count
+		, gl::U16Vec2 * result )noexcept;
+	/**
+	*\brief
+	*	Calcule les données compactées d'un lot d'étoiles : direction
+	*	octaédrique, magnitude en demi-flottant et indice de couleur.
+	*\remarks
+	*	Les étoiles sont traitées par tranches tenant dans le cache, chaque
+	*	étape parcourant une tranche entière avant de passer à la suivante.
+	*\param[in] batch
+	*	Le lot.
+	*\param[out] result
+	*	Reçoit les données, batch.size() au total.
+	*/
+	void packStars( StarBatch const & batch
+		, PackedStar * result );
+	/**
+	*\brief
+	*	Ajoute les étoiles d'un lot à un tableau d'étoiles.
+	*\param[in] batch
+	*	Le lot.
+	*\param[in,out] stars
+	*	Le tableau.
+	*/
+	void appendStars( StarBatch const & batch
+		, StarArray & stars );
+	/**
+	*\brief
+	*	Calcule les vitesses tangentielles d'une suite d'étoiles, depuis
+	*	leurs mouvements propres.
+	*\param[in] ra, dec
+	*	Les ascensions droites et déclinaisons, en radians.
+	*\param[in] pmra, pmdec
+	*	Les mouvements propres en ascension droite (multipliés par le
+	*	cosinus de la déclinaison, comme dans Hipparcos) et en
+	*	déclinaison, en radians par an.
+	*\param[in] count
+	*	Le nombre d'étoiles.
+	*\param[out] velocities
+	*	Reçoit les vitesses, en radians par an.
+	*/
+	void motionVelocities( float const * ra
+		, float const * dec
+		, float const * pmra
+		, float const * pmdec
+		, size_t count
+		, gl::Vec3 * velocities )noexcept;
+	/**
+	*\brief
+	*	Ajoute les mouvements propres d'un lot d'étoiles à un tableau.
+	*\param[in] batch
+	*	Le lot.
+	*\param[in] stars
+	*	Les étoiles, dont les batch.size() dernières sont celles du lot
+	*	(voir appendStars).
+	*\param[in,out] motions
+	*	Le tableau.
+	*/
+	void appendMotions( StarBatch const & batch
+		, StarArray const & stars
+		, StarMotionArray & motions );
+	/**
+	*\brief
+	*	Calcule les directions d'une suite d'étoiles à une époque donnée.
+	*\remarks
+	*	La direction de chaque étoile est celle de origin + t.velocity,
+	*	compactée en coordonnées octaédriques, le compactage se chargeant
+	*	de la normalisation.
+	*\param[in] motions
+	*	Les mouvements propres.
+	*\param[in] count
+	*	Le nombre d'étoiles.
+	*\param[in] years
+	*	Le nombre d'années depuis J2000.
+	*\param[out] result
+	*	Reçoit les directions compactées.
+	*/
+	void propagateDirections( StarMotion const * motions
+		, size_t count
+		, float years
+		, gl::U16Vec2 * result )noexcept;
+	/**
+	*\brief
+	*	Calcule les échelles des billboards d'une suite de magnitudes.
+	*\param[in] magnitudes
+	*	Les magnitudes.
+	*\param[in] count
+	*	Le nombre de magnitudes.
+	*\param[in] range
+	*	L'intervalle des magnitudes, la plus brillante ayant la plus grande
+	*	échelle.
+	*\param[out] scales
+	*	Reçoit les échelles.
+	*/
+	void magnitudeScales( float const * magnitudes
+		, size_t count
+		, render::Range< float > const & range
+		, float * scales )noexcept;
+	/**
+	*\brief
+	*	Calcule les échelles des billboards d'une suite d'étoiles, depuis
+	*	leurs magnitudes compactées.
+	*\param[in] stars
+	*	Les étoiles.
+	*\param[in] count
+	*	Le nombre d'étoiles.
+	*\param[in] range
+	*	L'intervalle des magnitudes, la plus brillante ayant la plus grande
+	*	échelle.
+	*\param[out] scales
+	*	Reçoit les échelles.
+	*/
+	void magnitudeScales( Star const * stars
+		, size_t count
+		, render::Range< float > const & range
+		, float * scales )noexcept;
+}
+
+#endif
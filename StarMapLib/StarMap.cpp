@@ -2,6 +2,8 @@
 
 #include "ConstellationStar.h"
 #include "ScreenEvents.h"
+#include "SkyTiling.h"
+#include "StarKernels.h"
 #include "StarMapState.h"
 
 #include <RenderLib/Billboard.h>
@@ -10,6 +12,7 @@
 #include <RenderLib/FontLoader.h>
 #include <RenderLib/Object.h>
 #include <RenderLib/PolyLine.h>
+#include <RenderLib/Texture.h>
 
 #include <GlLib/Transform.h>
 
@@ -27,8 +30,55 @@ namespace starmap
 		static const gl::IVec4 PickDescriptionHolderBorderSize{ 3, 3, 3, 3 };
 		static const gl::IVec2 StarNameOffset{ 10, 10 };
 		static const gl::IVec2 ConstellationNameOffset{};
+		//! Le nombre maximal d'étoiles transférées au GPU par image.
+		static const size_t StarUploadBatchSize{ 8192u };
+		//! Le nombre maximal d'étoiles des tuiles affichées.
+		static const size_t MaxStreamedStars{ 262144u };
+		//! Le nombre moyen d'étoiles visé par groupe de billboards.
+		static const size_t StarClusterSize{ 1024u };
+		//! Le nombre d'images sans changement d'époque avant que les étoiles
+		//! ayant quitté leur groupe ne soient rangées à nouveau.
+		static const uint32_t RelayoutDelay{ 30u };
+		//! Le rayon de la zone de sélection d'une étoile, en pixels.
+		static const float PickRadius{ 24.0f };
+		//! Le poids de la magnitude dans le choix de l'étoile sélectionnée,
+		//! en part du rayon de sélection par magnitude.
+		static const float PickMagnitudeWeight{ 0.05f };
+		//! La part du transfert GPU dans l'avancement du chargement.
+		static const float UploadProgressShare{ 0.1f };
+		//! Les couleurs des familles d'objets du ciel profond.
+		static const std::array< gl::RgbColour, size_t( DeepSkyType::eCount ) > DeepSkyColours
+		{
+			{
+				gl::RgbColour{ 1.0, 0.8, 0.6 },
+				gl::RgbColour{ 0.7, 0.8, 1.0 },
+				gl::RgbColour{ 1.0, 0.9, 0.6 },
+				gl::RgbColour{ 1.0, 0.5, 0.6 },
+				gl::RgbColour{ 0.5, 1.0, 0.8 },
+				gl::RgbColour{ 0.9, 0.6, 1.0 },
+				gl::RgbColour{ 0.7, 0.7, 0.7 },
+			}
+		};
+		//! Les noms des familles d'objets du ciel profond.
+		static char const * const DeepSkyTypeNames[size_t( DeepSkyType::eCount )]
+		{
+			"Galaxy",
+			"Open cluster",
+			"Globular cluster",
+			"Nebula",
+			"Planetary nebula",
+			"Supernova remnant",
+			"Deep-sky object",
+		};
+		//! Les dimensions des billboards, par taille d'objet du ciel profond.
+		static const std::array< int, size_t( DeepSkyTier::eCount ) > DeepSkyDimensions
+		{
+			{ 1, 2, 4 }
+		};
+		//! La taille des sprites des objets du ciel profond.
+		static const int DeepSkySpriteSize{ 32 };
 
-		String doConvertStdString( std::string const & str )
+		String doConvertStdString( StringView const & str )
 		{
 			String result{ { 0 } };
 			assert( str.size() < result.size() - 1 );
@@ -40,13 +90,139 @@ namespace starmap
 		{
 			return std::string{ str.data(), strlen( str.data() ) };
 		}
+		/**
+		*\brief
+		*	Copie un tableau dans une sauvegarde, à une position qui peut ne
+		*	pas être alignée pour ses éléments.
+		*/
+		template< typename T >
+		uint8_t * doWriteArray( std::vector< T > const & values
+			, uint8_t * buffer )
+		{
+			std::memcpy( buffer, values.data(), values.size() * sizeof( T ) );
+			return buffer + values.size() * sizeof( T );
+		}
+		/**
+		*\brief
+		*	Lit un tableau depuis une sauvegarde, à une position qui peut ne
+		*	pas être alignée pour ses éléments.
+		*/
+		template< typename T >
+		uint8_t const * doReadArray( uint8_t const * buffer
+			, uint32_t count
+			, std::vector< T > & values )
+		{
+			values.resize( count );
+			std::memcpy( values.data(), buffer, count * sizeof( T ) );
+			return buffer + count * sizeof( T );
+		}
+		/**
+		*\brief
+		*	Le niveau de l'index spatial dont les noeuds forment les groupes
+		*	de billboards.
+		*/
+		uint32_t doGetClusterLevel( SkyIndex const & sky )
+		{
+			auto level = 1u;
+
+			while ( level < sky.level()
+				&& ( sky.size() >> ( 2u * level ) ) > StarClusterSize )
+			{
+				++level;
+			}
+
+			return level;
+		}
 
-		std::ostream & operator <<( std::ostream & stream, Star const & star )
+		std::ostream & operator <<( std::ostream & stream, DeepSkyObject const & object )
 		{
-			stream << star.name() << "\n"
-				<< "Magnitude : " << star.magnitude();
+			stream << object.name() << "\n"
+				<< DeepSkyTypeNames[size_t( object.type() )] << "\n"
+				<< "Magnitude : " << object.magnitude();
+
+			if ( object.radius() > 0.0f )
+			{
+				stream << "\n" << "Radius : " << object.radius() << "'";
+			}
+
 			return stream;
 		}
+		/**
+		*\brief
+		*	Dessine le sprite d'une famille d'objets du ciel profond, en
+		*	niveaux de gris, l'opacité étant lue dans la composante rouge.
+		*/
+		render::ByteArray doMakeDeepSkySprite( DeepSkyType type )
+		{
+			render::ByteArray result( size_t( DeepSkySpriteSize * DeepSkySpriteSize ) );
+			auto it = result.begin();
+
+			for ( int j = 0; j < DeepSkySpriteSize; ++j )
+			{
+				for ( int i = 0; i < DeepSkySpriteSize; ++i )
+				{
+					// Coordonnées du centre du pixel, dans [-1, 1].
+					auto x = ( float( i ) + 0.5f ) * 2.0f / DeepSkySpriteSize - 1.0f;
+					auto y = ( float( j ) + 0.5f ) * 2.0f / DeepSkySpriteSize - 1.0f;
+					auto r = std::sqrt( x * x + y * y );
+					float value{ 0.0f };
+
+					switch ( type )
+					{
+					case DeepSkyType::eGalaxy:
+						// Ellipse inclinée.
+						value = std::exp( -3.0f * ( std::pow( ( x + y ) / 1.2f, 2.0f )
+							+ std::pow( ( x - y ) / 0.5f, 2.0f ) ) );
+						break;
+
+					case DeepSkyType::eOpenCluster:
+						// Etoiles éparses sur un cercle.
+						for ( int k = 0; k < 6; ++k )
+						{
+							auto angle = float( k ) * 1.0471976f;
+							auto dx = x - 0.6f * std::cos( angle );
+							auto dy = y - 0.6f * std::sin( angle );
+							value += std::exp( -( dx * dx + dy * dy ) / 0.01f );
+						}
+						value += std::exp( -r * r / 0.01f );
+						break;
+
+					case DeepSkyType::eGlobularCluster:
+						// Disque au coeur brillant.
+						value = std::exp( -4.0f * r * r ) + ( r < 0.8f ? 0.3f : 0.0f );
+						break;
+
+					case DeepSkyType::eNebula:
+						// Nuage diffus.
+						value = 0.8f * std::exp( -2.0f * r * r );
+						break;
+
+					case DeepSkyType::ePlanetaryNebula:
+						// Anneau.
+						value = std::exp( -std::pow( ( r - 0.55f ) / 0.15f, 2.0f ) );
+						break;
+
+					case DeepSkyType::eSupernovaRemnant:
+						// Anneau filamenteux.
+						value = std::exp( -std::pow( ( r - 0.75f ) / 0.08f, 2.0f ) )
+							* ( 0.6f + 0.4f * std::cos( 6.0f * std::atan2( y, x ) ) );
+						break;
+
+					default:
+						// Croix.
+						value = std::min( std::abs( x ), std::abs( y ) ) < 0.08f
+							? 1.0f - r
+							: 0.0f;
+						break;
+					}
+
+					value = r < 1.0f ? value : 0.0f;
+					*it++ = uint8_t( std::min( 1.0f, std::max( 0.0f, value ) ) * 255.0f );
+				}
+			}
+
+			return result;
+		}
 	}
 
 	StarMap::StarMap( ScreenEvents & events
@@ -56,13 +232,14 @@ namespace starmap
 		, render::ByteArray const & opacityMap )
 		: m_onPick{ events.onPick.connect( [this]( gl::IVec2 const & coord )
 			{
-				if ( m_pickedStar )
+				if ( m_pickedStar || m_pickedDeepSky )
 				{
 					onUnpick();
 				}
 				else
 				{
-					m_window.pick( coord );
+					m_pickPosition = coord;
+					m_pick = true;
 				}
 			} ) }
 		, m_onReset{ events.onReset.connect( [this]()
@@ -77,6 +254,11 @@ namespace starmap
 			{
 				m_window.state().zoomVelocity( value );
 			} ) }
+		, m_onHover{ events.onHover.connect( [this]( gl::IVec2 const & coord )
+			{
+				m_hoverPosition = coord;
+				m_hovered = true;
+			} ) }
 		, m_maxDisplayedStarNames{ maxDisplayedStarNames }
 #if 1 || !defined( NDEBUG )
 		, m_window{ size, loader, true }
@@ -93,79 +275,148 @@ namespace starmap
 	{
 		auto & state = *reinterpret_cast< StarMapState const *  >( save.data() );
 		auto * stars = reinterpret_cast< StarInfo const *  >( save.data()
-			+ sizeof( starmap::ConstellationInfoArray )
-			+ sizeof( uint32_t )
-			+ sizeof( render::CameraState ) );
+			+ sizeof( StarMapState ) );
+		StarIdentifierArray identifiers;
+		StarMotionArray motions;
+		std::vector< DeepSkyInfo > deepSkyInfos;
+		auto * arrays = doReadArray( reinterpret_cast< uint8_t const * >( stars + state.m_count )
+			, state.m_identifierCount
+			, identifiers );
+		arrays = doReadArray( arrays
+			, state.m_motionCount
+			, motions );
+		doReadArray( arrays
+			, state.m_deepSkyCount
+			, deepSkyInfos );
+
+		Builder builder;
+		builder.reserve( state.m_count, state.m_constellations.size() );
+		StarArray catalogueStars;
+		catalogueStars.reserve( state.m_count );
 
 		std::for_each( stars
 			, stars + state.m_count
-			, [this]( StarInfo const & star )
+			, [&builder, &catalogueStars]( StarInfo const & star )
 			{
-				m_stars.emplace_back( doConvertString( star.m_name )
+				catalogueStars.emplace_back( builder.namePool().add( StringView{ star.m_name.data() } )
 					, star.m_magnitude
 					, gl::Vec3{ star.m_position[0], star.m_position[1], star.m_position[2] }
 					, gl::RgbColour{ star.m_colour[0], star.m_colour[1], star.m_colour[2] } );
-				m_stars.back().index( star.m_index );
 			} );
 
 		for ( auto & info : state.m_constellations )
 		{
-			Constellation constellation{ doConvertString( info.m_name ) };
+			auto name = doConvertString( info.m_name );
 
 			for ( auto & star : info.m_stars )
 			{
 				if ( star.m_index )
 				{
-					constellation.addStar( star.m_id
+					builder.addConstellationStar( name
+						, star.m_id
 						, doConvertString( star.m_letter )
-						, m_stars[star.m_index].name() );
+						, builder.namePool().get( catalogueStars[star.m_index].name() ) );
 				}
 			}
 
-			add( constellation );
-			auto constell = findConstellation( constellation.name() );
-
 			for ( auto & link : info.m_links )
 			{
 				if ( link.m_a != link.m_b )
 				{
-					constell->addLink( doConvertString( link.m_a )
+					builder.addConstellationLink( name
+						, doConvertString( link.m_a )
 						, doConvertString( link.m_b ) );
 				}
 			}
 		}
 
+		builder.add( std::move( catalogueStars )
+			, std::move( identifiers )
+			, std::move( motions ) );
 		m_window.state() = state.m_state;
-		m_sorted = true;
+		doClearUploaded();
+		m_catalogue = builder.finalise();
+
+		// Les noms des objets, qui référencent la sauvegarde, sont copiés
+		// dans la réserve du catalogue à l'ajout.
+		DeepSkyObjectArray objects;
+		objects.reserve( deepSkyInfos.size() );
+
+		for ( auto & info : deepSkyInfos )
+		{
+			objects.emplace_back( StringView{ info.m_name.data() }
+				, info.m_type
+				, info.m_magnitude
+				, info.m_radius
+				, gl::U16Vec2{ info.m_direction[0], info.m_direction[1] } );
+		}
+
+		m_catalogue.add( std::move( objects ) );
+
+		// Les positions sauvegardées sont celles de l'époque affichée, celles
+		// des étoiles en mouvement sont recalculées depuis J2000.
+		m_epoch = state.m_epoch;
+		m_catalogue.epoch( m_epoch );
 	}
 
 	void StarMap::save( render::ByteArray & save )
 	{
-		save.resize( m_stars.size() * sizeof( starmap::StarInfo )
-			+ sizeof( starmap::ConstellationInfoArray )
-			+ sizeof( uint32_t )
-			+ sizeof( render::CameraState ) );
+		if ( m_loader )
+		{
+			// Le catalogue n'est pas encore chargé, il le sera à nouveau
+			// lors de la restauration.
+			save.clear();
+			return;
+		}
+
+		auto & stars = m_catalogue.stars();
+		auto & identifiers = m_catalogue.identifiers();
+		auto & motions = m_catalogue.motions();
+		std::vector< DeepSkyInfo > deepSkyInfos;
+		deepSkyInfos.reserve( m_catalogue.deepSkyObjects().size() );
+
+		for ( auto & object : m_catalogue.deepSkyObjects() )
+		{
+			deepSkyInfos.push_back( { doConvertStdString( object.name() )
+				, object.type()
+				, object.magnitude()
+				, object.radius()
+				, { object.direction().x, object.direction().y } } );
+		}
+
+		save.resize( sizeof( StarMapState )
+			+ stars.size() * sizeof( StarInfo )
+			+ identifiers.size() * sizeof( StarIdentifiers )
+			+ motions.size() * sizeof( StarMotion )
+			+ deepSkyInfos.size() * sizeof( DeepSkyInfo ) );
 		auto & state = *reinterpret_cast< StarMapState *  >( save.data() );
-		state.m_count = uint32_t( m_stars.size() );
-		auto * stars = reinterpret_cast< StarInfo *  >( save.data()
-			+ sizeof( starmap::ConstellationInfoArray )
-			+ sizeof( uint32_t )
-			+ sizeof( render::CameraState ) );
-		auto itst = stars;
+		state.m_count = uint32_t( stars.size() );
+		state.m_identifierCount = uint32_t( identifiers.size() );
+		state.m_motionCount = uint32_t( motions.size() );
+		state.m_deepSkyCount = uint32_t( deepSkyInfos.size() );
+		state.m_epoch = m_epoch;
+		auto * infos = reinterpret_cast< StarInfo *  >( save.data()
+			+ sizeof( StarMapState ) );
+		auto itst = infos;
+		uint32_t index{ 0u };
 
-		for ( auto & star : m_stars )
+		for ( auto & star : stars )
 		{
-			*itst = StarInfo{ star.index()
-				, doConvertStdString( star.name() )
+			*itst = StarInfo{ index++
+				, doConvertStdString( m_catalogue.name( star ) )
 				, star.magnitude()
 				, { star.position().x, star.position().y, star.position().z }
 				, { star.colour().x, star.colour().y, star.colour().z } };
 			++itst;
 		}
 
+		auto * arrays = doWriteArray( identifiers, reinterpret_cast< uint8_t * >( itst ) );
+		arrays = doWriteArray( motions, arrays );
+		doWriteArray( deepSkyInfos, arrays );
+
 		auto itc = state.m_constellations.begin();
 
-		for ( auto & it : m_constellations )
+		for ( auto & it : m_catalogue.constellations() )
 		{
 			auto & constellation = it.second;
 			ConstellationInfo info{ doConvertStdString( it.first ) };
@@ -174,7 +425,7 @@ namespace starmap
 
 			for ( auto & star : constellation->stars() )
 			{
-				*its = { star.star().index()
+				*its = { star.index()
 					, star.id()
 					, doConvertStdString( star.letter() ) };
 				++its;
@@ -206,28 +457,21 @@ namespace starmap
 
 		doInitialisePickObjects();
 		doInitialiseLines();
+		doInitialiseStarNames();
+		m_window.scene().thresholdBounds( 4.0f, 21.0f );
+		m_initialised = true;
+		m_uploaded = 0u;
 
-		if ( !m_stars.empty() )
-		{
-			doSortStars();
-			//auto range = render::makeRange( m_stars.begin()->magnitude()
-			//	, m_stars.rbegin()->magnitude() );
-			auto range = render::makeRange( 0.0f
-				, m_stars.rbegin()->magnitude() / 2.0f );
-			m_window.scene().thresholdBounds( 4.0f, 21.0f );
-
-			for ( auto & star : m_stars )
-			{
-				doAddStar( star, range );
-			}
+		m_deepSkyUploaded = 0u;
 
-			for ( auto & constellation : m_constellations )
-			{
-				doAddConstellation( *constellation.second );
-			}
+		if ( !m_loader && !m_catalogue.stars().empty() )
+		{
+			doUploadStars( m_catalogue.stars().size() );
+		}
 
-			doInitialiseStarNames();
-			doInitialiseConstellationNames();
+		if ( !m_loader && !m_catalogue.deepSkyObjects().empty() )
+		{
+			doUploadDeepSky( m_catalogue.deepSkyObjects().size() );
 		}
 
 		auto & picking = m_window.picking();
@@ -245,17 +489,43 @@ namespace starmap
 				, this ) );
 	}
 
+	void StarMap::load( CatalogueLoaderPtr loader )
+	{
+		m_loader = std::move( loader );
+		m_progress = -1.0f;
+		m_loader->start();
+	}
+
+	void StarMap::cancelLoading()
+	{
+		if ( m_loader )
+		{
+			m_loader.reset();
+			doNotifyProgress( 1.0f );
+		}
+	}
+
 	void StarMap::cleanup()
 	{
+		cancelLoading();
+		m_initialised = false;
 		onUnpick();
 		m_pickDescription.reset();
 		m_pickDescriptionHolder.reset();
+		m_hoverDescription.reset();
+		m_hovered = false;
 		m_pickBillboard.reset();
 		m_onObjectPicked.disconnect();
 		m_onBillboardPicked.disconnect();
 		m_onUnpick.disconnect();
 		m_holders.clear();
-		m_lines.reset();
+		m_deepSkyHolders.clear();
+		m_tileRequests.clear();
+		m_streamedTiles.clear();
+		m_streamedSlots.clear();
+		m_starSlots.clear();
+		m_starNames.clear();
+		m_constellationNames.clear();
 	}
 
 	void StarMap::resize( gl::IVec2 const & size )
@@ -270,8 +540,13 @@ namespace starmap
 
 	void StarMap::drawFrame()
 	{
+		doUpdateLoading();
+		doUpdateLayout();
 		m_window.update();
+		doUpdateTiles();
+		doPick();
 		doUpdatePickDescription();
+		doUpdateHover();
 		doUpdateStarNames();
 		doUpdateConstellationNames();
 		m_window.updateOverlays();
@@ -285,51 +560,117 @@ namespace starmap
 
 	void StarMap::add( Star const & star )
 	{
-		m_stars.push_back( star );
+		m_catalogue.add( star );
 	}
 
 	void StarMap::add( StarArray const & stars )
 	{
-		for ( auto & star : stars )
-		{
-			add( star );
-		}
+		m_catalogue.add( stars );
+	}
+
+	void StarMap::add( StarArray && stars )
+	{
+		m_catalogue.add( std::move( stars ) );
 	}
 
 	void StarMap::add( Constellation const & constellation )
 	{
-		doSortStars();
-		auto it = m_constellations.find( constellation.name() );
+		m_catalogue.add( constellation );
+	}
+
+	void StarMap::build( Builder && builder )
+	{
+		cancelLoading();
+		doClearUploaded();
+		m_catalogue = builder.finalise();
+		m_catalogue.epoch( m_epoch );
+	}
+
+	void StarMap::stream( TileCachePtr tiles )
+	{
+		assert( tiles && tiles->valid() );
+		m_tiles = std::move( tiles );
+		m_tileRequests.clear();
 
-		if ( it == m_constellations.end() )
+		// Les étoiles déjà affichées, du catalogue ou d'un autre cache,
+		// seront remplacées par celles des tuiles.
+		for ( auto & holder : m_holders )
 		{
-			auto it = m_constellations.emplace( constellation.name()
-				, std::make_unique< Constellation >( constellation.name() ) ).first;
+			holder.m_stars.clear();
+			holder.m_buffer->clear();
 
-			for ( auto & star : constellation.stars() )
+			if ( m_initialised )
 			{
-				it->second->addStar( star.id(), star.letter(), star.name() );
+				m_window.scene().updateBillboardBuffer( holder.m_buffer );
 			}
-
-			it->second->fill( m_stars );
 		}
+
+		m_streamedTiles.clear();
+		m_streamedSlots.clear();
+		m_starSlots.clear();
 	}
 
-	Constellation * StarMap::findConstellation( std::string const & name )
+	void StarMap::epoch( float year )
 	{
-		auto it = m_constellations.find( name );
-		Constellation * result{ nullptr };
+		m_epoch = year;
 
-		if ( it != m_constellations.end() )
+		if ( !m_loader )
 		{
-			result = &( *it->second );
+			doApplyEpoch();
 		}
-		else
+	}
+
+	Constellation * StarMap::findConstellation( std::string const & name )
+	{
+		return m_catalogue.findConstellation( name );
+	}
+
+	Star const * StarMap::findStar( std::string const & name )
+	{
+		return m_catalogue.findStar( name );
+	}
+
+	std::vector< uint32_t > StarMap::search( std::string const & prefix
+		, uint32_t limit )
+	{
+		return m_catalogue.search( prefix, limit );
+	}
+
+	std::vector< uint32_t > StarMap::findStars( SkyCap const & cap
+		, uint32_t count )const
+	{
+		return m_catalogue.skyIndex().brightest( cap
+			, count
+			, uint32_t( m_uploaded ) );
+	}
+
+	std::vector< uint32_t > StarMap::nearestStars( SkyCap const & cap
+		, uint32_t count )const
+	{
+		// Les étoiles étant triées par magnitude, celles sous le seuil
+		// forment un préfixe du catalogue.
+		auto & stars = m_catalogue.stars();
+		auto visible = size_t( std::distance( stars.begin()
+			, std::upper_bound( stars.begin()
+				, stars.end()
+				, m_window.scene().threshold()
+				, []( float threshold, Star const & star )
+				{
+					return threshold < star.magnitude();
+				} ) ) );
+		return m_catalogue.skyIndex().nearest( cap
+			, count
+			, uint32_t( std::min( m_uploaded, visible ) ) );
+	}
+
+	void StarMap::hovering( bool enable )
+	{
+		m_hovering = enable;
+
+		if ( !enable && m_hoverDescription )
 		{
-			std::cerr << "Constellation [" << name << "] not found." << std::endl;
+			m_hoverDescription->show( false );
 		}
-
-		return result;
 	}
 
 	void StarMap::filter( ElementType type, bool show )
@@ -343,6 +684,10 @@ namespace starmap
 		case ElementType::eStar:
 			doFilterStars( show );
 			break;
+
+		case ElementType::eDeepSky:
+			doFilterDeepSky( show );
+			break;
 		}
 	}
 
@@ -365,6 +710,8 @@ namespace starmap
 		m_pickDescription->show( false );
 		m_pickDescriptionHolder->show( false );
 		m_pickedStar = nullptr;
+		m_pickedTile.reset();
+		m_pickedDeepSky = nullptr;
 	}
 
 	void StarMap::doUpdatePicked( render::Movable const & movable )
@@ -405,47 +752,291 @@ namespace starmap
 	void StarMap::doUpdatePicked( render::Billboard const & billboard
 		, uint32_t index )
 	{
-		auto & holder = doFindHolder( billboard.material().ambient() );
+		// Les objets du ciel profond ont leurs propres tampons, les étoiles
+		// sont retrouvées par la couleur de leur matériau.
+		auto deepSky = std::find_if( std::begin( m_deepSkyHolders )
+			, std::end( m_deepSkyHolders )
+			, [&billboard]( DeepSkyHolder const & holder )
+			{
+				return holder.m_buffer.get() == &billboard.buffer();
+			} );
+		std::stringstream stream;
+
+		if ( deepSky != std::end( m_deepSkyHolders ) )
+		{
+			if ( deepSky->m_objects.size() <= index )
+			{
+				return;
+			}
 
-		if ( holder.m_stars.size() > index )
+			m_pickedDeepSky = deepSky->m_objects[index];
+			m_pickedStar = nullptr;
+			stream << *m_pickedDeepSky;
+		}
+		else
 		{
+			auto & holder = doFindHolder( billboard.material().ambient() );
+
+			if ( holder.m_stars.size() <= index )
+			{
+				return;
+			}
+
 			auto & star = *holder.m_stars[index];
 			m_pickedStar = &star;
-			auto it = std::find_if( std::begin( m_constellations )
-				, std::end( m_constellations )
-				, [&star]( auto const & pair )
-				{
-					return pair.second->findStar( star.name() );
-				} );
-
-			std::stringstream stream;
-			stream << star;
+			m_pickedTile = doFindStreamedTile( star );
+			m_pickedDeepSky = nullptr;
+			auto csStar = m_pickedTile
+				? nullptr
+				: m_catalogue.findMembership( star );
+			stream << doGetName( star ) << "\n"
+				<< "Magnitude : " << star.magnitude();
 
-			if ( it != std::end( m_constellations ) )
+			if ( csStar )
 			{
-				auto csStar = it->second->findStar( star.name() );
 				stream << "\n"
 					<< "Constellation : " << csStar->constellation().name() << "\n"
 					<< "Bayer : " << csStar->letter() << "\n"
 					<< "ID : " << csStar->id();
-				m_pickDescription->caption( stream.str() );
 			}
-			else
+		}
+
+		m_pickDescription->caption( stream.str() );
+		doUpdatePickDescription();
+		m_pickBillboard->moveTo( billboard.position() - gl::Vec3{ 0, 0, 0.02 } );
+		doUpdatePicked( static_cast< render::Movable const & >( billboard ) );
+		auto data = billboard.buffer()[index];
+		auto percent = m_window.state().zoomBounds().percent( m_window.state().zoom() );
+		m_pickBillboard->buffer().at( 0u
+			, { -1000.0f, data.center, gl::Vec2{ 1.0, 1.0 } } );
+		m_pickBillboard->cull( m_window.scene().camera(), 2.0f * percent );
+	}
+
+	void StarMap::doPick()
+	{
+		if ( !m_pick )
+		{
+			return;
+		}
+
+		m_pick = false;
+
+		// Les étoiles sont sélectionnées sans passe GPU, le picking FBO ne
+		// sert plus qu'aux autres objets, si aucune étoile n'est trouvée.
+		if ( !doPickStar( m_pickPosition ) )
+		{
+			m_window.pick( m_pickPosition );
+		}
+	}
+
+	bool StarMap::doPickStar( gl::IVec2 const & position )
+	{
+		auto cap = doGetScreenCap( position );
+		auto cosine = std::cos( cap.radius );
+		auto threshold = m_window.scene().threshold();
+		StarSlot picked;
+		auto best = std::numeric_limits< float >::max();
+
+		// Plus proche du centre est le mieux, une étoile plus brillante
+		// l'emportant sur une plus faible un peu plus proche.
+		auto consider = [&]( Star const & star
+			, gl::Vec3 const & direction
+			, StarSlot const & slot )
+		{
+			if ( star.magnitude() <= threshold
+				&& gl::dot( cap.centre, direction ) >= cosine
+				&& doIsShown( slot ) )
+			{
+				auto score = angle( cap.centre, direction ) / cap.radius
+					+ PickMagnitudeWeight * star.magnitude();
+
+				if ( score < best )
+				{
+					best = score;
+					picked = slot;
+				}
+			}
+		};
+
+		if ( m_tiles )
+		{
+			doForEachStreamedStar( cap, consider );
+		}
+		else
+		{
+			auto & sky = m_catalogue.skyIndex();
+			auto & stars = m_catalogue.stars();
+			SkyIndex::RangeArray ranges;
+			sky.cone( cap, ranges );
+
+			for ( auto & range : ranges )
+			{
+				for ( auto entry = range.first; entry < range.last; ++entry )
+				{
+					auto index = sky.stars()[entry];
+
+					if ( index < m_starSlots.size() )
+					{
+						consider( stars[index]
+							, gl::unpackOctahedral( sky.directions()[entry] )
+							, m_starSlots[index] );
+					}
+				}
+			}
+		}
+
+		if ( !doIsShown( picked ) )
+		{
+			return false;
+		}
+
+		// Le billboard et l'index sont ceux que donnerait le picking GPU.
+		m_window.picking().onUnpick();
+		m_window.picking().onBillboardPicked( *m_holders[picked.m_holder].m_billboard
+			, picked.m_index );
+		return true;
+	}
+
+	void StarMap::doUpdateHover()
+	{
+		if ( !m_hovering
+			|| !m_hovered
+			|| !m_hoverDescription )
+		{
+			return;
+		}
+
+		// Recalculé à chaque image, la caméra pouvant bouger sous le
+		// curseur immobile.
+		auto star = doFindHovered( m_hoverPosition );
+		auto name = star
+			? doGetName( *star )
+			: StringView{};
+
+		if ( name.empty() )
+		{
+			m_hoverDescription->show( false );
+			return;
+		}
+
+		m_hoverDescription->caption( name.str() );
+		m_hoverDescription->show( true );
+		doUpdateOverlay( *m_hoverDescription
+			, star->position()
+			, StarNameOffset );
+	}
+
+	Star const * StarMap::doFindHovered( gl::IVec2 const & position )const
+	{
+		auto cap = doGetScreenCap( position );
+		auto & camera = m_window.scene().camera();
+		Star const * result{ nullptr };
+		StarSlot slot;
+
+		if ( m_tiles )
+		{
+			auto threshold = m_window.scene().threshold();
+			auto cosine = std::cos( cap.radius );
+			auto best = -1.0f;
+			doForEachStreamedStar( cap
+				, [&]( Star const & star
+					, gl::Vec3 const & direction
+					, StarSlot const & starSlot )
+				{
+					auto dot = gl::dot( cap.centre, direction );
+
+					if ( star.magnitude() <= threshold
+						&& dot >= cosine
+						&& dot > best )
+					{
+						best = dot;
+						result = &star;
+						slot = starSlot;
+					}
+				} );
+		}
+		else
+		{
+			auto nearest = nearestStars( cap, 1u );
+
+			if ( !nearest.empty() )
+			{
+				result = &m_catalogue.stars()[nearest.front()];
+				slot = nearest.front() < m_starSlots.size()
+					? m_starSlots[nearest.front()]
+					: StarSlot{};
+			}
+		}
+
+		// Les étoiles filtrées ne sont pas survolées.
+		if ( !result
+			|| !camera.visible( result->position() )
+			|| !doIsShown( slot ) )
+		{
+			return nullptr;
+		}
+
+		return result;
+	}
+
+	SkyCap StarMap::doGetScreenCap( gl::IVec2 const & position )const
+	{
+		auto & camera = m_window.scene().camera();
+		auto & viewport = camera.viewport();
+		auto tan = float( gl::tan( gl::Radians{ viewport.fovY() / 2 } ) );
+		return SkyCap
+		{
+			camera.ray( position ),
+			std::atan( 2.0f * tan * PickRadius / float( viewport.size().y ) ),
+		};
+	}
+
+	SkyCap StarMap::doGetViewCap()const
+	{
+		auto & camera = m_window.scene().camera();
+		auto & viewport = camera.viewport();
+		auto ratio = float( viewport.size().x ) / float( viewport.size().y );
+		auto tan = float( gl::tan( gl::Radians{ viewport.fovY() / 2 } ) );
+		return SkyCap
+		{
+			gl::normalize( camera.front() ),
+			std::atan( tan * std::sqrt( 1.0f + ratio * ratio ) )
+		};
+	}
+
+	void StarMap::doForEachStreamedStar( SkyCap const & cap
+		, std::function< void( Star const &, gl::Vec3 const &, StarSlot const & ) > const & function )const
+	{
+		auto level = m_tiles->level();
+
+		for ( size_t t = 0u; t < m_streamedTiles.size(); ++t )
+		{
+			auto & tile = *m_streamedTiles[t];
+
+			if ( !intersects( cap, tileCap( level, tile.index ) ) )
 			{
-				m_pickDescription->caption( stream.str() );
+				continue;
 			}
 
-			doUpdatePickDescription();
-			m_pickBillboard->moveTo( billboard.position() - gl::Vec3{ 0, 0, 0.02 } );
-			doUpdatePicked( static_cast< render::Movable const & >( billboard ) );
-			auto & data = billboard.buffer()[index];
-			auto percent = m_window.state().zoomBounds().percent( m_window.state().zoom() );
-			m_pickBillboard->buffer().at( 0u
-				, { -1000.0f, data.center, gl::Vec2{ 1.0, 1.0 } } );
-			m_pickBillboard->cull( m_window.scene().camera(), 2.0f * percent );
+			// Seules les étoiles ajoutées aux conteneurs ont un emplacement.
+			auto & slots = m_streamedSlots[t];
+
+			for ( size_t i = 0u; i < slots.size(); ++i )
+			{
+				function( tile.stars[i]
+					, gl::unpackOctahedral( tile.stars[i].packed().position )
+					, slots[i] );
+			}
 		}
 	}
 
+	bool StarMap::doIsShown( StarSlot const & slot )const
+	{
+		return slot.m_holder < m_holders.size()
+			&& m_holders[slot.m_holder].m_billboard
+			&& m_holders[slot.m_holder].m_billboard->visible();
+	}
+
 	StarHolder & StarMap::doFindHolder( gl::RgbColour const & colour )
 	{
 		auto it = std::find_if( std::begin( m_holders )
@@ -495,6 +1086,7 @@ namespace starmap
 			stars->dimensions( gl::IVec2{ 1, 1 } );
 			stars->material( starsMat );
 			scene.add( stars );
+			holder.m_billboard = stars;
 
 			//auto halos = std::make_shared< render::Billboard >( shalos
 			//	, *holder.m_buffer );
@@ -508,11 +1100,19 @@ namespace starmap
 		}
 	}
 
-	void StarMap::doAddStar( Star const & star
-		, render::Range< float > const & range )
+	void StarMap::doAddStar( size_t index
+		, float scale )
 	{
-		auto scale = 0.1f + range.invpercent( star.magnitude() );
+		auto & star = m_catalogue.stars()[index];
 		auto & holder = doFindHolder( star.colour() );
+
+		if ( m_starSlots.size() <= index )
+		{
+			m_starSlots.resize( m_catalogue.stars().size() );
+		}
+
+		m_starSlots[index] = { uint32_t( &holder - m_holders.data() )
+			, uint32_t( holder.m_stars.size() ) };
 		holder.m_stars.push_back( &star );
 		holder.m_buffer->add( { star.magnitude()
 			, star.position()
@@ -520,11 +1120,85 @@ namespace starmap
 		doInitialiseHolder( holder );
 	}
 
-	void StarMap::doAddConstellation( Constellation & constellation )
+	DeepSkyHolder & StarMap::doFindDeepSkyHolder( DeepSkyType type
+		, DeepSkyTier tier )
+	{
+		auto it = std::find_if( std::begin( m_deepSkyHolders )
+			, std::end( m_deepSkyHolders )
+			, [type, tier]( DeepSkyHolder const & holder )
+			{
+				return holder.m_type == type
+					&& holder.m_tier == tier;
+			} );
+
+		if ( it == std::end( m_deepSkyHolders ) )
+		{
+			// Les objets sont coupés au seuil de magnitude de la scène,
+			// comme le permet leur tri.
+			m_deepSkyHolders.emplace_back( type
+				, tier
+				, std::make_shared< render::BillboardBuffer >( true, true ) );
+			it = m_deepSkyHolders.begin() + m_deepSkyHolders.size() - 1;
+		}
+
+		return *it;
+	}
+
+	void StarMap::doInitialiseDeepSkyHolder( DeepSkyHolder & holder )
+	{
+		if ( !holder.m_initialised )
+		{
+			std::stringstream name;
+			name << "deepsky_" << uint32_t( holder.m_type ) << "_" << uint32_t( holder.m_tier );
+			auto & scene = m_window.scene();
+			auto & colour = DeepSkyColours[size_t( holder.m_type )];
+			auto material = std::make_shared< render::Material >();
+			material->opacityMap( doGetDeepSkySprite( holder.m_type ) );
+			material->ambient( colour );
+			material->diffuse( colour );
+			material->emissive( colour );
+			scene.materials().addElement( name.str(), material );
+
+			auto dimension = DeepSkyDimensions[size_t( holder.m_tier )];
+			auto objects = std::make_shared< render::Billboard >( name.str()
+				, *holder.m_buffer );
+			objects->dimensions( gl::IVec2{ dimension, dimension } );
+			objects->material( material );
+			scene.add( objects );
+
+			scene.addBillboardBuffer( name.str(), holder.m_buffer );
+
+			holder.m_initialised = true;
+		}
+	}
+
+	render::TexturePtr StarMap::doGetDeepSkySprite( DeepSkyType type )
+	{
+		auto & scene = m_window.scene();
+		std::stringstream name;
+		name << "deepsky_" << uint32_t( type ) << ".sprite";
+		auto result = scene.textures().findElement( name.str() );
+
+		if ( !result )
+		{
+			result = std::make_shared< render::Texture >();
+			result->image( gl::PixelFormat::eL8
+				, gl::IVec2{ DeepSkySpriteSize, DeepSkySpriteSize }
+				, doMakeDeepSkySprite( type ) );
+			scene.textures().addElement( name.str(), result );
+		}
+
+		return result;
+	}
+
+	void StarMap::doAddConstellation( Constellation const & constellation
+		, render::PolyLine & lines )
 	{
+		lines.clear();
+
 		for ( auto & link : constellation.links() )
 		{
-			m_lines->add( { link.m_a->star().position()
+			lines.add( { link.m_a->star().position()
 				, link.m_b->star().position() } );
 		}
 	}
@@ -607,6 +1281,13 @@ namespace starmap
 		m_pickDescription->lineSpacingMode( render::TextLineSpacingMode::eMaxFontHeight );
 		m_pickDescription->index( 3u );
 		scene.overlays().addElement( "picked", m_pickDescription );
+
+		m_hoverDescription = std::make_shared< render::TextOverlay >();
+		m_hoverDescription->fontTexture( *m_fontTextureNames );
+		m_hoverDescription->show( false );
+		m_hoverDescription->material( pickedDescriptionMat );
+		m_hoverDescription->index( 3u );
+		scene.overlays().addElement( "hovered", m_hoverDescription );
 	}
 
 	void StarMap::doInitialiseLines()
@@ -617,10 +1298,6 @@ namespace starmap
 		linesMat->diffuse( gl::toVec3( ConstellationColour ) );
 		linesMat->emissive( gl::toVec3( ConstellationColour ) );
 		scene.materials().addElement( "lines", linesMat );
-
-		m_lines = std::make_shared< render::PolyLine >( "lines", 0.06f, 1.0f );
-		m_lines->material( linesMat );
-		scene.add( m_lines );
 	}
 
 	void StarMap::doInitialiseStarNames()
@@ -647,7 +1324,8 @@ namespace starmap
 	void StarMap::doInitialiseConstellationNames()
 	{
 		auto & scene = m_window.scene();
-		m_constellationNames.resize( m_constellations.size() );
+		auto & constellations = m_catalogue.constellations();
+		m_constellationNames.resize( constellations.size() );
 		uint32_t index{ 0u };
 
 		auto constellationMat = std::make_shared< render::Material >();
@@ -655,28 +1333,44 @@ namespace starmap
 		constellationMat->diffuse( ConstellationTextColour );
 		scene.materials().addElement( "ConstellationName"
 			, constellationMat );
+		auto linesMat = scene.materials().findElement( "lines" );
 
-		for ( auto const & constellation : m_constellations )
+		for ( auto const & constellation : constellations )
 		{
 			auto overlay = std::make_shared< render::TextOverlay >();
 			overlay->caption( constellation.first );
 			overlay->material( constellationMat );
 			overlay->fontTexture( *m_fontTextureNames );
 			overlay->index( 0u );
+			overlay->show( m_showConstellations );
 			scene.overlays().addElement( constellation.first, overlay );
 
+			// Une polyligne par constellation, afin que les liens des
+			// constellations hors de la vue ne soient pas dessinés.
+			auto lines = std::make_shared< render::PolyLine >( "lines_" + constellation.first
+				, 0.06f
+				, 1.0f );
+			lines->material( linesMat );
+			lines->show( m_showConstellations );
+			doAddConstellation( *constellation.second, *lines );
+			scene.add( lines );
+
 			m_constellationNames[index].m_element = &( *constellation.second );
 			m_constellationNames[index].m_overlay = overlay;
+			m_constellationNames[index].m_lines = lines;
+			++index;
 		}
 	}
 
 	void StarMap::doUpdatePickDescription()
 	{
-		if ( m_pickedStar )
+		if ( m_pickedStar || m_pickedDeepSky )
 		{
 			doUpdateOverlay( *m_pickDescriptionHolder
 				, m_window.scene().camera()
-				, m_pickedStar->position()
+				, m_pickedStar
+					? m_pickedStar->position()
+					: m_pickedDeepSky->position()
 				, StarNameOffset );
 
 			auto const & camera = m_window.scene().camera();
@@ -712,22 +1406,25 @@ namespace starmap
 	{
 		uint32_t index = 0;
 
-		for ( auto it = m_stars.begin();
-			it != m_stars.end() && index < m_maxDisplayedStarNames;
-			++it )
-		{
-			auto & star = *it;
+		// Seules les étoiles déjà transférées au GPU sont nommées.
+		// L'index spatial ne parcourt que les feuilles visibles pouvant
+		// contenir les plus brillantes.
+		auto & camera = m_window.scene().camera();
+		auto & stars = m_catalogue.stars();
+		auto visible = m_catalogue.skyIndex().brightest( camera.frustum()
+			, m_maxDisplayedStarNames
+			, uint32_t( std::min( m_uploaded, stars.size() ) ) );
 
-			if ( m_window.scene().camera().visible( star.position() ) )
-			{
-				m_starNames[index].m_element = &star;
-				m_starNames[index].m_overlay->caption( star.name() );
-				m_starNames[index].m_overlay->show( true );
-				doUpdateOverlay( *m_starNames[index].m_overlay
-					, star.position()
-					, StarNameOffset );
-				++index;
-			}
+		for ( auto i : visible )
+		{
+			auto & star = stars[i];
+			m_starNames[index].m_element = &star;
+			m_starNames[index].m_overlay->caption( m_catalogue.name( star ).str() );
+			m_starNames[index].m_overlay->show( true );
+			doUpdateOverlay( *m_starNames[index].m_overlay
+				, star.position()
+				, StarNameOffset );
+			++index;
 		}
 
 		for ( auto it = m_starNames.begin() + index;
@@ -741,16 +1438,32 @@ namespace starmap
 
 	void StarMap::doUpdateConstellationNames()
 	{
-		auto & scene = m_window.scene();
+		if ( !m_showConstellations )
+		{
+			return;
+		}
+
+		// Le nom et les liens d'une constellation dont la calotte ne coupe
+		// pas celle de la vue sont cachés, sans projection.
 		auto & camera = m_window.scene().camera();
+		auto view = doGetViewCap();
 
-		for ( auto const & constellation : m_constellations )
+		for ( auto const & name : m_constellationNames )
 		{
-			auto overlay = scene.overlays().findElement( constellation.first );
-			doUpdateOverlay( *overlay
-				, camera
-				, constellation.second->position()
-				, ConstellationNameOffset );
+			auto visible = intersects( view, name.m_element->cap() );
+			name.m_lines->show( visible );
+
+			if ( visible )
+			{
+				doUpdateOverlay( *name.m_overlay
+					, camera
+					, name.m_element->position()
+					, ConstellationNameOffset );
+			}
+			else
+			{
+				name.m_overlay->show( false );
+			}
 		}
 	}
 
@@ -789,13 +1502,12 @@ namespace starmap
 
 	void StarMap::doFilterConstellations( bool show )
 	{
-		auto & scene = m_window.scene();
-		m_lines->show( show );
+		m_showConstellations = show;
 
-		for ( auto const & constellation : m_constellations )
+		for ( auto const & name : m_constellationNames )
 		{
-			auto overlay = scene.overlays().findElement( constellation.first );
-			overlay->show( show );
+			name.m_overlay->show( show );
+			name.m_lines->show( show );
 		}
 	}
 
@@ -803,47 +1515,627 @@ namespace starmap
 	{
 		for ( auto & holder : m_holders )
 		{
-			auto it = std::find_if( m_window.scene().billboards().begin()
-				, m_window.scene().billboards().end()
-				, [&holder]( render::BillboardPtr & billboard )
+			doFilterBuffer( *holder.m_buffer, show );
+		}
+	}
+
+	void StarMap::doFilterDeepSky( bool show )
+	{
+		for ( auto & holder : m_deepSkyHolders )
+		{
+			doFilterBuffer( *holder.m_buffer, show );
+		}
+	}
+
+	void StarMap::doFilterBuffer( render::BillboardBuffer const & buffer
+		, bool show )
+	{
+		for ( auto & billboard : m_window.scene().billboards() )
+		{
+			if ( &billboard->buffer() == &buffer )
 			{
-				return &billboard->buffer() == holder.m_buffer.get();
-			} );
-			while ( it != m_window.scene().billboards().end() )
+				billboard->show( show );
+			}
+		}
+	}
+
+	void StarMap::doUpdateLoading()
+	{
+		if ( !m_initialised )
+		{
+			return;
+		}
+
+		if ( m_loader )
+		{
+			if ( !m_loader->ready() )
+			{
+				doNotifyProgress( m_loader->progress() * ( 1.0f - UploadProgressShare ) );
+				return;
+			}
+
+			doClearUploaded();
+
+			try
+			{
+				m_catalogue = m_loader->take();
+			}
+			catch ( std::exception & exc )
+			{
+				std::cerr << "Catalogue loading failed: " << exc.what() << std::endl;
+				m_catalogue = StarCatalogue{};
+			}
+
+			m_loader.reset();
+
+			// Rien n'est encore transféré, seul le catalogue est concerné.
+			m_catalogue.epoch( m_epoch );
+		}
+
+		auto & stars = m_catalogue.stars();
+		auto & objects = m_catalogue.deepSkyObjects();
+
+		// Les objets du ciel profond sont transférés après les étoiles, par
+		// lots de même taille.
+		if ( m_uploaded < stars.size() )
+		{
+			doUploadStars( StarUploadBatchSize );
+		}
+		else if ( m_deepSkyUploaded < objects.size() )
+		{
+			doUploadDeepSky( StarUploadBatchSize );
+		}
+		else
+		{
+			doNotifyProgress( 1.0f );
+			return;
+		}
+
+		doNotifyProgress( ( 1.0f - UploadProgressShare )
+			+ UploadProgressShare * float( m_uploaded + m_deepSkyUploaded )
+				/ float( stars.size() + objects.size() ) );
+	}
+
+	void StarMap::doUploadStars( size_t count )
+	{
+		auto & stars = m_catalogue.stars();
+
+		if ( m_tiles )
+		{
+			// Les étoiles affichées sont celles des tuiles, le catalogue ne
+			// sert qu'aux noms et aux constellations.
+			m_catalogue.sort();
+			m_uploaded = stars.size();
+			doFinishUpload();
+			return;
+		}
+
+		if ( !m_uploaded )
+		{
+			m_catalogue.sort();
+			m_range = render::makeRange( 0.0f
+				, stars.back().magnitude() / 2.0f );
+		}
+
+		// Les étoiles étant triées, chaque lot prolonge les tampons en
+		// conservant leur tri par magnitude.
+		std::vector< bool > grown( m_holders.size(), false );
+		auto end = std::min( stars.size(), m_uploaded + count );
+		std::vector< float > scales( end - m_uploaded );
+		magnitudeScales( stars.data() + m_uploaded
+			, scales.size()
+			, m_range
+			, scales.data() );
+
+		for ( auto i = m_uploaded; i < end; ++i )
+		{
+			auto & holder = doFindHolder( stars[i].colour() );
+			auto index = size_t( &holder - m_holders.data() );
+			doAddStar( i, scales[i - m_uploaded] );
+
+			if ( index < grown.size() )
+			{
+				grown[index] = true;
+			}
+		}
+
+		// Les tampons déjà initialisés doivent voir leur stockage GPU
+		// recréé à la nouvelle taille.
+		for ( size_t i = 0u; i < grown.size(); ++i )
+		{
+			if ( grown[i] )
+			{
+				m_window.scene().updateBillboardBuffer( m_holders[i].m_buffer );
+			}
+		}
+
+		m_uploaded = end;
+
+		if ( m_uploaded == stars.size() )
+		{
+			doFinishUpload();
+		}
+	}
+
+	void StarMap::doUploadDeepSky( size_t count )
+	{
+		auto & objects = m_catalogue.deepSkyObjects();
+
+		if ( !m_deepSkyUploaded )
+		{
+			m_deepSkyRange = render::makeRange( 0.0f
+				, objects.back().magnitude() / 2.0f );
+		}
+
+		// Les objets étant triés, chaque lot prolonge les tampons en
+		// conservant leur tri par magnitude, nécessaire à leur seuil.
+		std::vector< bool > grown( m_deepSkyHolders.size(), false );
+		auto end = std::min( objects.size(), m_deepSkyUploaded + count );
+		std::vector< float > magnitudes;
+		magnitudes.reserve( end - m_deepSkyUploaded );
+
+		for ( auto i = m_deepSkyUploaded; i < end; ++i )
+		{
+			magnitudes.push_back( objects[i].magnitude() );
+		}
+
+		std::vector< float > scales( magnitudes.size() );
+		magnitudeScales( magnitudes.data()
+			, magnitudes.size()
+			, m_deepSkyRange
+			, scales.data() );
+
+		for ( auto i = m_deepSkyUploaded; i < end; ++i )
+		{
+			auto & object = objects[i];
+			auto & holder = doFindDeepSkyHolder( object.type(), object.tier() );
+			auto index = size_t( &holder - m_deepSkyHolders.data() );
+			auto scale = scales[i - m_deepSkyUploaded];
+			holder.m_objects.push_back( &object );
+			holder.m_buffer->add( { object.magnitude()
+				, object.position()
+				, gl::Vec2{ scale, scale } } );
+			doInitialiseDeepSkyHolder( holder );
+
+			if ( index < grown.size() )
+			{
+				grown[index] = true;
+			}
+		}
+
+		// Les tampons déjà initialisés doivent voir leur stockage GPU
+		// recréé à la nouvelle taille.
+		for ( size_t i = 0u; i < grown.size(); ++i )
+		{
+			if ( grown[i] )
+			{
+				m_window.scene().updateBillboardBuffer( m_deepSkyHolders[i].m_buffer );
+			}
+		}
+
+		m_deepSkyUploaded = end;
+	}
+
+	void StarMap::doUpdateTiles()
+	{
+		if ( !m_tiles || !m_initialised )
+		{
+			return;
+		}
+
+		auto changed = m_tiles->update();
+
+		auto view = doGetViewCap();
+		std::vector< uint32_t > tiles;
+		findTiles( view, m_tiles->level(), tiles );
+
+		// Les tuiles sont lues jusqu'au seuil de magnitude du zoom, le
+		// nombre d'étoiles affichées étant réparti entre les tuiles
+		// visibles.
+		auto threshold = m_window.scene().threshold();
+		auto limit = uint32_t( std::min( m_tiles->capacity(), MaxStreamedStars )
+			/ std::max( size_t( 1u ), tiles.size() ) );
+		TileCache::RequestArray requests;
+		requests.reserve( tiles.size() );
+
+		for ( auto tile : tiles )
+		{
+			requests.push_back( { tile
+				, std::min( m_tiles->depth( tile, threshold ), limit ) } );
+		}
+
+		if ( requests != m_tileRequests )
+		{
+			// Les tuiles les plus proches de l'axe de visée sont lues en
+			// premier.
+			auto level = m_tiles->level();
+			std::vector< std::pair< float, TileCache::Request > > sorted;
+			sorted.reserve( requests.size() );
+
+			for ( auto & request : requests )
 			{
-				( *it )->show( show );
-				++it;
-				it = std::find_if( it
-					, m_window.scene().billboards().end()
-					, [&holder]( render::BillboardPtr & billboard )
+				sorted.emplace_back( -gl::dot( view.centre, tileCap( level, request.tile ).centre )
+					, request );
+			}
+
+			std::sort( sorted.begin()
+				, sorted.end()
+				, []( std::pair< float, TileCache::Request > const & lhs
+					, std::pair< float, TileCache::Request > const & rhs )
 				{
-					return &billboard->buffer() == holder.m_buffer.get();
+					return lhs.first < rhs.first;
 				} );
+			TileCache::RequestArray prioritised;
+			prioritised.reserve( sorted.size() );
+
+			for ( auto & request : sorted )
+			{
+				prioritised.push_back( request.second );
+			}
+
+			m_tiles->request( prioritised );
+			m_tileRequests = std::move( requests );
+			changed = true;
+		}
+
+		if ( changed )
+		{
+			doStreamStars();
+		}
+	}
+
+	void StarMap::doStreamStars()
+	{
+		for ( auto & holder : m_holders )
+		{
+			holder.m_stars.clear();
+			holder.m_buffer->clear();
+		}
+
+		// Les tuiles sont gardées jusqu'au prochain remplissage, les
+		// conteneurs référençant leurs étoiles.
+		m_streamedTiles.clear();
+		m_streamedSlots.clear();
+		m_range = render::makeRange( 0.0f, m_tiles->faintest() / 2.0f );
+		std::vector< float > scales;
+		std::vector< render::BillboardBuffer::ClusterArray > clusters;
+		std::vector< uint32_t > firsts;
+
+		for ( auto & request : m_tileRequests )
+		{
+			auto tile = m_tiles->find( request.tile );
+
+			if ( !tile )
+			{
+				continue;
+			}
+
+			firsts.clear();
+
+			for ( auto & holder : m_holders )
+			{
+				firsts.push_back( uint32_t( holder.m_stars.size() ) );
+			}
+
+			// Une tuile lue plus profondément, pour un zoom précédent, n'est
+			// affichée que jusqu'à la profondeur voulue.
+			auto count = std::min( size_t( request.depth ), tile->stars.size() );
+			scales.resize( count );
+			magnitudeScales( tile->stars.data()
+				, count
+				, m_range
+				, scales.data() );
+			StarSlotArray slots( count );
+
+			for ( size_t i = 0u; i < count; ++i )
+			{
+				auto & star = tile->stars[i];
+				auto & holder = doFindHolder( star.colour() );
+				slots[i] = { uint32_t( &holder - m_holders.data() )
+					, uint32_t( holder.m_stars.size() ) };
+				holder.m_stars.push_back( &star );
+				holder.m_buffer->add( { star.magnitude()
+					, star.position()
+					, gl::Vec2{ scales[i], scales[i] } } );
+				doInitialiseHolder( holder );
+			}
+
+			doAddClusters( boundingSphere( tileCap( m_tiles->level(), request.tile )
+					, StarDistance )
+				, firsts
+				, clusters );
+			m_streamedTiles.push_back( std::move( tile ) );
+			m_streamedSlots.push_back( std::move( slots ) );
+		}
+
+		doSetClusters( clusters );
+	}
+
+	StarTilePtr StarMap::doFindStreamedTile( Star const & star )const
+	{
+		auto it = std::find_if( m_streamedTiles.begin()
+			, m_streamedTiles.end()
+			, [&star]( StarTilePtr const & tile )
+			{
+				return !tile->stars.empty()
+					&& std::less_equal< Star const * >{}( tile->stars.data(), &star )
+					&& std::less< Star const * >{}( &star, tile->stars.data() + tile->stars.size() );
+			} );
+
+		return it == m_streamedTiles.end()
+			? nullptr
+			: *it;
+	}
+
+	StringView StarMap::doGetName( Star const & star )const
+	{
+		auto tile = doFindStreamedTile( star );
+		return tile
+			? tile->name( star )
+			: m_catalogue.name( star );
+	}
+
+	void StarMap::doLayoutStars()
+	{
+		m_catalogue.reindex();
+		m_relayoutDelay = 0u;
+
+		for ( auto & holder : m_holders )
+		{
+			holder.m_stars.clear();
+			holder.m_buffer->clear();
+		}
+
+		m_starSlots.assign( m_catalogue.stars().size(), StarSlot{} );
+
+		auto & sky = m_catalogue.skyIndex();
+		auto & stars = m_catalogue.stars();
+		std::vector< float > scales( stars.size() );
+		magnitudeScales( stars.data()
+			, scales.size()
+			, m_range
+			, scales.data() );
+
+		// Les groupes sont les noeuds d'un niveau de l'index, dont les
+		// étoiles sont contiguës, découpés par conteneur.
+		auto level = doGetClusterLevel( sky );
+		std::vector< render::BillboardBuffer::ClusterArray > clusters;
+		std::vector< uint32_t > firsts;
+
+		for ( uint32_t node = 0u; !sky.empty() && node < tileCount( level ); ++node )
+		{
+			auto range = sky.node( level, node );
+
+			if ( range.first == range.last )
+			{
+				continue;
+			}
+
+			firsts.clear();
+
+			for ( auto & holder : m_holders )
+			{
+				firsts.push_back( uint32_t( holder.m_stars.size() ) );
 			}
+
+			for ( auto entry = range.first; entry < range.last; ++entry )
+			{
+				auto index = sky.stars()[entry];
+				doAddStar( index, scales[index] );
+			}
+
+			doAddClusters( boundingSphere( sky.cap( level, node ), StarDistance )
+				, firsts
+				, clusters );
 		}
+
+		doSetClusters( clusters );
 	}
 
-	void StarMap::doSortStars()
+	void StarMap::doRefitClusters()
 	{
-		if ( !m_sorted )
+		// L'index a gardé la répartition de doLayoutStars : ses noeuds
+		// donnent toujours les étoiles de chaque groupe, dans l'ordre des
+		// conteneurs, et leurs calottes ont été ajustées aux étoiles.
+		auto & sky = m_catalogue.skyIndex();
+		auto level = doGetClusterLevel( sky );
+		std::vector< render::BillboardBuffer::ClusterArray > clusters( m_holders.size() );
+		std::vector< uint32_t > firsts( m_holders.size(), 0u );
+		std::vector< uint32_t > counts;
+
+		for ( uint32_t node = 0u; !sky.empty() && node < tileCount( level ); ++node )
 		{
-			std::sort( std::begin( m_stars )
-				, std::end( m_stars )
-				, []( Star const & lhs, Star const & rhs )
+			auto range = sky.node( level, node );
+
+			if ( range.first == range.last )
+			{
+				continue;
+			}
+
+			counts.assign( m_holders.size(), 0u );
+
+			for ( auto entry = range.first; entry < range.last; ++entry )
+			{
+				auto & slot = m_starSlots[sky.stars()[entry]];
+				assert( slot.m_holder < counts.size() );
+				++counts[slot.m_holder];
+			}
+
+			auto sphere = boundingSphere( sky.cap( level, node ), StarDistance );
+
+			for ( size_t i = 0u; i < m_holders.size(); ++i )
+			{
+				if ( counts[i] )
 				{
-					return lhs.magnitude() < rhs.magnitude();
-				} );
+					clusters[i].push_back( { firsts[i], counts[i], sphere.centre, sphere.radius } );
+					firsts[i] += counts[i];
+				}
+			}
+		}
+
+		doSetClusters( clusters );
+	}
+
+	void StarMap::doAddClusters( SkySphere const & sphere
+		, std::vector< uint32_t > const & firsts
+		, std::vector< render::BillboardBuffer::ClusterArray > & clusters )
+	{
+		clusters.resize( m_holders.size() );
+
+		for ( size_t i = 0u; i < m_holders.size(); ++i )
+		{
+			// Les conteneurs créés depuis n'avaient aucune étoile.
+			auto first = i < firsts.size()
+				? firsts[i]
+				: 0u;
+			auto count = uint32_t( m_holders[i].m_stars.size() ) - first;
 
+			if ( count )
+			{
+				clusters[i].push_back( { first, count, sphere.centre, sphere.radius } );
+			}
+		}
+	}
+
+	void StarMap::doSetClusters( std::vector< render::BillboardBuffer::ClusterArray > & clusters )
+	{
+		clusters.resize( m_holders.size() );
+
+		for ( size_t i = 0u; i < m_holders.size(); ++i )
+		{
+			m_holders[i].m_buffer->clusters( std::move( clusters[i] ) );
+
+			if ( m_initialised )
+			{
+				m_window.scene().updateBillboardBuffer( m_holders[i].m_buffer );
+			}
+		}
+	}
+
+	void StarMap::doClearUploaded()
+	{
+		m_uploaded = 0u;
+		m_deepSkyUploaded = 0u;
+		m_relayoutDelay = 0u;
+
+		if ( !m_initialised )
+		{
+			return;
+		}
+
+		// Les conteneurs et les noms référencent les éléments du catalogue
+		// qui va être remplacé.
+		onUnpick();
+		m_hovered = false;
+		auto & scene = m_window.scene();
+
+		for ( auto & holder : m_holders )
+		{
+			holder.m_stars.clear();
+			holder.m_buffer->clear();
+			scene.updateBillboardBuffer( holder.m_buffer );
+		}
+
+		m_starSlots.clear();
+
+		for ( auto & holder : m_deepSkyHolders )
+		{
+			holder.m_objects.clear();
+			holder.m_buffer->clear();
+			scene.updateBillboardBuffer( holder.m_buffer );
+		}
+
+		for ( auto & name : m_starNames )
+		{
+			name.m_element = nullptr;
+			name.m_overlay->show( false );
+		}
+
+		// Les noms et lignes des constellations sont recréés par
+		// doFinishUpload().
+		for ( auto & name : m_constellationNames )
+		{
+			scene.overlays().removeElement( name.m_element->name() );
+			scene.remove( name.m_lines );
+		}
+
+		m_constellationNames.clear();
+	}
+
+	void StarMap::doFinishUpload()
+	{
+		// Les étoiles, transférées par magnitude, sont rangées par zone du
+		// ciel une fois toutes présentes.
+		if ( !m_tiles )
+		{
+			doLayoutStars();
+		}
+
+		doInitialiseConstellationNames();
+	}
+
+	void StarMap::doApplyEpoch()
+	{
+		if ( m_catalogue.epoch() == m_epoch )
+		{
+			return;
+		}
+
+		m_catalogue.epoch( m_epoch );
+		auto uploaded = m_initialised
+			&& !m_catalogue.stars().empty()
+			&& m_uploaded == m_catalogue.stars().size();
+
+		// Les étoiles sont mises à jour en place, les billboards pointant
+		// vers elles n'ont qu'à recopier leur direction : les sommets
+		// visibles sont de toute façon recalculés à chaque image.
+		for ( auto & holder : m_holders )
+		{
 			uint32_t index{ 0u };
 
-			for ( auto & star : m_stars )
+			for ( auto star : holder.m_stars )
 			{
-				star.index( index++ );
+				holder.m_buffer->direction( index++, star->packed().position );
 			}
+		}
 
-			std::cout << "Most shiny star: " << m_stars.front() << std::endl;
-			std::cout << "Least shiny star: " << m_stars.back() << std::endl;
-			m_sorted = true;
+		if ( uploaded && !m_tiles )
+		{
+			// Les étoiles restent dans leur groupe, dont la sphère suit leurs
+			// déplacements. Celles ayant quitté leur tuile élargissent ainsi
+			// leur groupe : elles sont rangées à nouveau une fois l'époque
+			// stable, pas à chaque pas d'un défilement.
+			doRefitClusters();
+			m_relayoutDelay = m_catalogue.skyTiled()
+				? 0u
+				: RelayoutDelay;
+		}
+
+		if ( uploaded )
+		{
+			for ( auto & name : m_constellationNames )
+			{
+				doAddConstellation( *name.m_element, *name.m_lines );
+			}
+		}
+	}
+
+	void StarMap::doUpdateLayout()
+	{
+		if ( m_relayoutDelay
+			&& !--m_relayoutDelay
+			&& !m_tiles )
+		{
+			doLayoutStars();
+		}
+	}
+
+	void StarMap::doNotifyProgress( float progress )
+	{
+		if ( progress != m_progress )
+		{
+			m_progress = progress;
+			onLoadProgress( progress );
 		}
 	}
 }
@@ -8,8 +8,13 @@
 #define ___StarMapLib_StarMap_HPP___
 #pragma once
 
+#include "CatalogueBuilder.h"
+#include "CatalogueLoader.h"
+#include "StarCatalogue.h"
 #include "StarHolder.h"
+#include "TileCache.h"
 
+#include <RenderLib/BillboardBuffer.h>
 #include <RenderLib/Debug.h>
 #include <RenderLib/RenderWindow.h>
 #include <RenderLib/RenderSignal.h>
@@ -22,6 +27,10 @@ namespace starmap
 	*/
 	class StarMap
 	{
+	public:
+		//! Le constructeur d'un catalogue complet, finalisé en une fois.
+		using Builder = CatalogueBuilder;
+
 	public:
 		/**
 		*\brief
@@ -64,6 +73,26 @@ namespace starmap
 		void initialise();
 		/**
 		*\brief
+		*	Démarre le chargement asynchrone du catalogue.
+		*\remarks
+		*	Le chargement est démarré sur un thread de travail, la carte peut
+		*	donc être affichée avant qu'il ne soit terminé. Une fois le
+		*	catalogue chargé, ses étoiles sont transférées au GPU par lots,
+		*	des plus brillantes aux plus faibles, lors des images suivantes.
+		*	L'avancement est notifié par onLoadProgress.
+		*\param[in] loader
+		*	Le loader, dont les étapes ont été ajoutées.
+		*/
+		void load( CatalogueLoaderPtr loader );
+		/**
+		*\brief
+		*	Annule le chargement asynchrone en cours, s'il y en a un.
+		*\remarks
+		*	Attend la fin de l'étape en cours sur le thread de travail.
+		*/
+		void cancelLoading();
+		/**
+		*\brief
 		*	Nettoie les données GPU.
 		*/
 		void cleanup();
@@ -92,6 +121,10 @@ namespace starmap
 		/**
 		*\brief
 		*	Ajoute une étoile à la carte du ciel.
+		*\remarks
+		*	Le nom de l'étoile doit avoir été copié dans la réserve de noms
+		*	du catalogue (voir StarCatalogue::namePool), comme pour les
+		*	listes d'étoiles ci-dessous.
 		*\param[in] star
 		*	L'étoile.
 		*/
@@ -105,6 +138,13 @@ namespace starmap
 		void add( StarArray const & stars );
 		/**
 		*\brief
+		*	Ajoute une liste d'étoiles à la carte du ciel, en une fois.
+		*\param[in] stars
+		*	La liste d'étoiles, dont le contenu est déplacé.
+		*/
+		void add( StarArray && stars );
+		/**
+		*\brief
 		*	Ajoute une constellation à la carte du ciel.
 		*\remarks
 		*	Finalise la constellation avec les étoiles de la carte.
@@ -114,6 +154,50 @@ namespace starmap
 		void add( Constellation const & constellation );
 		/**
 		*\brief
+		*	Remplace le catalogue de la carte du ciel par celui d'un
+		*	constructeur, finalisé en une fois.
+		*\remarks
+		*	A privilégier aux ajouts un par un pour un catalogue complet :
+		*	les étoiles et les constellations y sont ajoutées dans n'importe
+		*	quel ordre, et ne sont triées et indexées qu'une fois.\n
+		*	Annule le chargement asynchrone en cours, s'il y en a un. Si la
+		*	carte est déjà initialisée, les étoiles, objets, noms et lignes
+		*	du catalogue précédent sont retirés de la scène, et la sélection
+		*	est annulée ; les étoiles du nouveau catalogue sont ensuite
+		*	transférées au GPU comme après un chargement.
+		*\param[in] builder
+		*	Le constructeur, vide en retour.
+		*/
+		void build( Builder && builder );
+		/**
+		*\brief
+		*	Affiche les étoiles d'un catalogue par tuiles, lues à la demande
+		*	selon la direction de la caméra et le zoom, plutôt que celles du
+		*	catalogue.
+		*\remarks
+		*	Permet d'afficher des catalogues ne tenant pas en mémoire : seules
+		*	les tuiles visibles sont lues, jusqu'au seuil de magnitude du zoom
+		*	et dans la limite du budget mémoire du cache.\n
+		*	Le catalogue reste utilisé pour les noms des étoiles, les
+		*	constellations et la recherche. Les étoiles des tuiles n'ont pas
+		*	de mouvement propre, l'époque ne s'y applique pas.
+		*\param[in] tiles
+		*	Le cache des tuiles, valide.
+		*/
+		void stream( TileCachePtr tiles );
+		/**
+		*\brief
+		*	Définit l'époque à laquelle sont affichées les étoiles, leurs
+		*	positions étant calculées depuis leur mouvement propre.
+		*\remarks
+		*	Si un chargement asynchrone est en cours, l'époque est appliquée
+		*	au catalogue chargé.
+		*\param[in] year
+		*	L'époque, en années (2000 pour J2000).
+		*/
+		void epoch( float year );
+		/**
+		*\brief
 		*	Recherche une constellation dans la carte du ciel.
 		*\param[in] name
 		*	Le nom de la constellation.
@@ -123,6 +207,78 @@ namespace starmap
 		Constellation * findConstellation( std::string const & name );
 		/**
 		*\brief
+		*	Recherche une étoile dans la carte du ciel, par son nom.
+		*\param[in] name
+		*	Le nom de l'étoile.
+		*\return
+		*	L'étoile, \p nullptr si non trouvée.
+		*/
+		Star const * findStar( std::string const & name );
+		/**
+		*\brief
+		*	Recherche les étoiles dont un des noms commence par le texte
+		*	donné.
+		*\remarks
+		*	Le nom propre, les identifiants Gliese et Hipparcos, ainsi que la
+		*	désignation de Bayer sont cherchés, sans tenir compte de la casse
+		*	et à une faute de frappe près.
+		*\param[in] prefix
+		*	Le texte recherché.
+		*\param[in] limit
+		*	Le nombre maximal de résultats.
+		*\return
+		*	Les index des étoiles trouvées, dans catalogue().stars().
+		*/
+		std::vector< uint32_t > search( std::string const & prefix
+			, uint32_t limit );
+		/**
+		*\brief
+		*	Récupère les étoiles affichées les plus brillantes d'une zone du
+		*	ciel.
+		*\param[in] cap
+		*	La zone du ciel.
+		*\param[in] count
+		*	Le nombre maximal de résultats.
+		*\return
+		*	Les index des étoiles trouvées, dans catalogue().stars(), par
+		*	magnitude croissante.
+		*\see
+		*	SkyIndex::brightest
+		*/
+		std::vector< uint32_t > findStars( SkyCap const & cap
+			, uint32_t count )const;
+		/**
+		*\brief
+		*	Récupère les étoiles affichées les plus proches d'une direction.
+		*\remarks
+		*	Seules les étoiles transférées au GPU et de magnitude inférieure
+		*	ou égale au seuil de la scène sont retournées.
+		*\param[in] cap
+		*	La direction, au centre de la calotte, dont le rayon est la
+		*	distance maximale.
+		*\param[in] count
+		*	Le nombre maximal de résultats.
+		*\return
+		*	Les index des étoiles trouvées, dans catalogue().stars(), par
+		*	distance croissante.
+		*\see
+		*	SkyIndex::nearest
+		*/
+		std::vector< uint32_t > nearestStars( SkyCap const & cap
+			, uint32_t count )const;
+		/**
+		*\brief
+		*	Active ou désactive le survol continu.
+		*\remarks
+		*	Une fois activé, le nom de l'étoile affichée la plus proche de la
+		*	position donnée par ScreenEvents::onHover est affiché à chaque
+		*	image, sans passe GPU.
+		*\param[in] enable
+		*	\p true pour activer le survol.
+		*/
+		void hovering( bool enable );
+		/**
+		*\brief
 		*	Applique un filtre.
 		*\param[in] type
 		*	Le type d'élément sur lequel est appliqué le filtre.
@@ -131,6 +287,36 @@ namespace starmap
 		*	\p false pour les cacher
 		*/
 		void filter( ElementType type, bool show );
+		/**
+		*\return
+		*	Le catalogue des étoiles et constellations.
+		*/
+		inline StarCatalogue & catalogue()noexcept
+		{
+			return m_catalogue;
+		}
+		/**
+		*\return
+		*	L'index spatial des étoiles du catalogue.
+		*/
+		inline SkyIndex const & skyIndex()const noexcept
+		{
+			return m_catalogue.skyIndex();
+		}
+		/**
+		*\return
+		*	\p true si un chargement asynchrone est en cours.
+		*/
+		inline bool loading()const noexcept
+		{
+			return m_loader != nullptr
+				|| m_uploaded < m_catalogue.stars().size()
+				|| m_deepSkyUploaded < m_catalogue.deepSkyObjects().size();
+		}
+
+	public:
+		//! La notification d'avancement du chargement asynchrone, de 0 à 1.
+		OnLoadProgress onLoadProgress;
 
 	private:
 		/**
@@ -189,6 +375,78 @@ namespace starmap
 		StarHolder & doFindHolder( gl::RgbColour const & colour );
 		/**
 		*\brief
+		*	Exécute la sélection demandée depuis la dernière image.
+		*/
+		void doPick();
+		/**
+		*\brief
+		*	Sélectionne l'étoile affichée la plus proche de la position écran
+		*	donnée, sans passe GPU.
+		*\remarks
+		*	Les étoiles candidates sont celles de l'index spatial (ou des
+		*	tuiles) à moins d'un angle fonction du zoom du rayon passant par
+		*	la position, pondérées par leur magnitude. Celles dont le
+		*	billboard est masqué sont ignorées. L'étoile choisie est
+		*	notifiée par Picking::onBillboardPicked, comme par le picking
+		*	GPU.
+		*\param[in] position
+		*	La position écran.
+		*\return
+		*	\p true si une étoile a été sélectionnée.
+		*/
+		bool doPickStar( gl::IVec2 const & position );
+		/**
+		*\brief
+		*	Met à jour l'infobulle de l'étoile survolée.
+		*/
+		void doUpdateHover();
+		/**
+		*\brief
+		*	Recherche l'étoile affichée la plus proche de la position écran
+		*	donnée.
+		*\param[in] position
+		*	La position écran.
+		*\return
+		*	L'étoile, \p nullptr s'il n'y en a pas à moins de PickRadius
+		*	pixels.
+		*/
+		Star const * doFindHovered( gl::IVec2 const & position )const;
+		/**
+		*\brief
+		*	Calcule la calotte centrée sur le rayon passant par une position
+		*	écran, de rayon PickRadius pixels.
+		*\param[in] position
+		*	La position écran.
+		*/
+		SkyCap doGetScreenCap( gl::IVec2 const & position )const;
+		/**
+		*\brief
+		*	Calcule la calotte englobant le frustum de la caméra : son rayon
+		*	est l'angle entre l'axe de visée et un coin de l'écran.
+		*/
+		SkyCap doGetViewCap()const;
+		/**
+		*\brief
+		*	Appelle une fonction pour chaque étoile affichée des tuiles
+		*	coupant une calotte, avec sa direction normalisée et son
+		*	emplacement.
+		*\param[in] cap
+		*	La calotte.
+		*\param[in] function
+		*	La fonction.
+		*/
+		void doForEachStreamedStar( SkyCap const & cap
+			, std::function< void( Star const &, gl::Vec3 const &, StarSlot const & ) > const & function )const;
+		/**
+		*\param[in] slot
+		*	L'emplacement d'une étoile.
+		*\return
+		*	\p true si l'étoile est dans un conteneur dont le billboard est
+		*	affiché.
+		*/
+		bool doIsShown( StarSlot const & slot )const;
+		/**
+		*\brief
 		*	Initialise les billboards pour les étoiles du conteneur.
 		*\param[in] holder
 		*	Le conteneur du tampon et de la couleur.
@@ -197,20 +455,54 @@ namespace starmap
 		/**
 		*\brief
 		*	Ajoute une étoile au conteneur de billboards approprié.
-		*\param[in] star
-		*	L'étoile à ajouter.
-		*\param[in] range
-		*	L'intervalle des magnitudes.
+		*\param[in] index
+		*	L'index de l'étoile à ajouter, dans le catalogue trié.
+		*\param[in] scale
+		*	L'échelle du billboard (voir magnitudeScales).
 		*/
-		void doAddStar( Star const & star
-			, render::Range< float > const & range );
+		void doAddStar( size_t index
+			, float scale );
 		/**
 		*\brief
-		*	Ajoute une constellation à la polyligne.
+		*	Remplit la polyligne d'une constellation depuis ses liens.
 		*\param[in] constellation
-		*	La constellation à ajouter.
+		*	La constellation.
+		*\param[out] lines
+		*	La polyligne de la constellation.
+		*/
+		void doAddConstellation( Constellation const & constellation
+			, render::PolyLine & lines );
+		/**
+		*\brief
+		*	Récupère un conteneur de billboard pour les objets du ciel profond
+		*	de la famille et de la taille données.
+		*\param[in] type
+		*	La famille.
+		*\param[in] tier
+		*	La taille.
+		*\return
+		*	Le conteneur
+		*/
+		DeepSkyHolder & doFindDeepSkyHolder( DeepSkyType type
+			, DeepSkyTier tier );
+		/**
+		*\brief
+		*	Initialise les billboards pour les objets du conteneur, avec le
+		*	sprite de leur famille.
+		*\param[in] holder
+		*	Le conteneur.
+		*/
+		void doInitialiseDeepSkyHolder( DeepSkyHolder & holder );
+		/**
+		*\brief
+		*	Récupère la texture d'opacité d'une famille d'objets du ciel
+		*	profond, créée si besoin.
+		*\param[in] type
+		*	La famille.
+		*\return
+		*	La texture.
 		*/
-		void doAddConstellation( Constellation & constellation );
+		render::TexturePtr doGetDeepSkySprite( DeepSkyType type );
 		/**
 		*\brief
 		*	Charge les textures de police.
@@ -233,7 +525,7 @@ namespace starmap
 		void doInitialisePickObjects();
 		/**
 		*\brief
-		*	Initialise la polyligne contenant les constellations.
+		*	Initialise le matériau des polylignes des constellations.
 		*/
 		void doInitialiseLines();
 		/**
@@ -243,7 +535,8 @@ namespace starmap
 		void doInitialiseStarNames();
 		/**
 		*\brief
-		*	Initialise les incrustations contenant les noms des constellations.
+		*	Initialise les incrustations contenant les noms des constellations,
+		*	ainsi que leurs polylignes.
 		*/
 		void doInitialiseConstellationNames();
 		/**
@@ -304,9 +597,127 @@ namespace starmap
 		void doFilterStars( bool show );
 		/**
 		*\brief
-		*	Trie les étoiles par magnitude.
+		*	Affiche ou cache les objets du ciel profond.
+		*/
+		void doFilterDeepSky( bool show );
+		/**
+		*\brief
+		*	Affiche ou cache les billboards utilisant le tampon donné.
+		*/
+		void doFilterBuffer( render::BillboardBuffer const & buffer
+			, bool show );
+		/**
+		*\brief
+		*	Vérifie l'avancement du chargement asynchrone, et transfère le
+		*	lot d'étoiles suivant au GPU.
+		*/
+		void doUpdateLoading();
+		/**
+		*\brief
+		*	Ajoute le lot d'étoiles suivant aux conteneurs de billboards.
+		*\param[in] count
+		*	Le nombre maximal d'étoiles du lot.
+		*/
+		void doUploadStars( size_t count );
+		/**
+		*\brief
+		*	Ajoute aux billboards le lot suivant d'objets du ciel profond, des
+		*	plus brillants aux plus faibles.
+		*\param[in] count
+		*	Le nombre maximal d'objets ajoutés.
+		*/
+		void doUploadDeepSky( size_t count );
+		/**
+		*\brief
+		*	Demande au cache les tuiles visibles, puis remplit les conteneurs
+		*	de billboards si elles ont changé.
+		*/
+		void doUpdateTiles();
+		/**
+		*\brief
+		*	Remplit les conteneurs de billboards avec les étoiles des tuiles
+		*	voulues déjà chargées.
+		*/
+		void doStreamStars();
+		/**
+		*\brief
+		*	Récupère la tuile affichée contenant une étoile.
+		*\return
+		*	La tuile, \p nullptr si l'étoile est une étoile du catalogue.
+		*/
+		StarTilePtr doFindStreamedTile( Star const & star )const;
+		/**
+		*\brief
+		*	Récupère le nom d'une étoile affichée, depuis sa tuile ou depuis
+		*	le catalogue.
+		*/
+		StringView doGetName( Star const & star )const;
+		/**
+		*\brief
+		*	Range les étoiles du catalogue dans les conteneurs de billboards
+		*	dans l'ordre de l'index spatial, par groupe de noeuds voisins,
+		*	afin que le culling les teste par groupe.\n
+		*	L'index spatial est reconstruit au besoin.
+		*/
+		void doLayoutStars();
+		/**
+		*\brief
+		*	Ajuste les sphères des groupes de billboards aux calottes de
+		*	l'index spatial, après un déplacement des étoiles, sans changer
+		*	leur rangement.
+		*/
+		void doRefitClusters();
+		/**
+		*\brief
+		*	Ajoute aux groupes de chaque conteneur ses étoiles ajoutées
+		*	depuis \p firsts.
+		*\param[in] sphere
+		*	La sphère englobant les étoiles ajoutées.
+		*\param[in] firsts
+		*	Le nombre d'étoiles de chaque conteneur avant l'ajout.
+		*\param[in,out] clusters
+		*	Les groupes de chaque conteneur.
+		*/
+		void doAddClusters( SkySphere const & sphere
+			, std::vector< uint32_t > const & firsts
+			, std::vector< render::BillboardBuffer::ClusterArray > & clusters );
+		/**
+		*\brief
+		*	Donne leurs groupes aux conteneurs, puis recrée leur stockage
+		*	GPU.
+		*/
+		void doSetClusters( std::vector< render::BillboardBuffer::ClusterArray > & clusters );
+		/**
+		*\brief
+		*	Retire de la scène les étoiles, objets, noms et lignes transférés
+		*	depuis le catalogue courant, ainsi que la sélection, avant son
+		*	remplacement.
+		*/
+		void doClearUploaded();
+		/**
+		*\brief
+		*	Initialise les constellations et les noms, une fois toutes les
+		*	étoiles ajoutées.
+		*/
+		void doFinishUpload();
+		/**
+		*\brief
+		*	Applique l'époque au catalogue, puis reporte les nouvelles
+		*	positions dans les billboards, leurs groupes et les lignes déjà
+		*	transférés.
+		*/
+		void doApplyEpoch();
+		/**
+		*\brief
+		*	Range à nouveau les étoiles, une fois l'époque stable, si des
+		*	étoiles ont quitté la tuile de leur groupe.
 		*/
-		void doSortStars();
+		void doUpdateLayout();
+		/**
+		*\brief
+		*	Notifie l'avancement du chargement, s'il a changé.
+		*/
+		void doNotifyProgress( float progress );
 
 	private:
 		//! La connexion à la notification d'objet sélectionné.
@@ -323,6 +734,8 @@ namespace starmap
 		render::Connection< OnSetVelocity > m_onSetVelocity;
 		//! La connexion à la notification de définition de la vitesse de zoom de la caméra.
 		render::Connection< OnSetZoomVelocity > m_onSetZoomVelocity;
+		//! La connexion à la notification de survol.
+		render::Connection< OnHover > m_onHover;
 
 	private:
 		/**
@@ -339,36 +752,94 @@ namespace starmap
 		};
 		//! Spécialisation pour les étoiles.
 		using StarName = ElementName< Star >;
-		//! Spécialisation pour les constellations.
-		using ConstellationName = ElementName< Constellation >;
+		/**
+		*\brief
+		*	Contient une constellation, l'incrustation utilisée pour afficher
+		*	son nom et la polyligne de ses liens, cachées ensemble lorsque la
+		*	constellation est hors de la vue.
+		*/
+		struct ConstellationName
+		{
+			//! La constellation.
+			Constellation const * m_element;
+			//! L'incrustation.
+			render::TextOverlayPtr m_overlay;
+			//! Les liens de la constellation.
+			render::PolyLinePtr m_lines;
+		};
 
 	private:
 		//! Le nombre maximal d'étoiles dont le nom est affiché.
 		uint32_t m_maxDisplayedStarNames;
 		//! Le tableau de StarHolders.
 		StarHolderArray m_holders;
-		//! La polyligne contenant les constellations.
-		render::PolyLinePtr m_lines;
+		//! Les conteneurs de billboards des objets du ciel profond.
+		DeepSkyHolderArray m_deepSkyHolders;
+		//! Dit si les constellations sont affichées (voir filter).
+		bool m_showConstellations{ true };
 		//! La fenêtre où s'effectue le rendu.
 		render::RenderWindow m_window;
-		//! Les étoiles.
-		StarArray m_stars;
-		//! Dit si les étoiles sont triées.
-		bool m_sorted{ false };
-		//! Les constellations.
-		ConstellationMap m_constellations;
+		//! Le catalogue des étoiles et constellations.
+		StarCatalogue m_catalogue;
+		//! Le chargement asynchrone en cours.
+		CatalogueLoaderPtr m_loader;
+		//! Le cache des tuiles, si les étoiles affichées en proviennent.
+		TileCachePtr m_tiles;
+		//! Les tuiles voulues, par indice croissant.
+		TileCache::RequestArray m_tileRequests;
+		//! Les tuiles dont les étoiles sont dans les conteneurs de billboards.
+		StarTileArray m_streamedTiles;
+		//! Les emplacements des étoiles affichées de chaque tuile de
+		//! m_streamedTiles.
+		std::vector< StarSlotArray > m_streamedSlots;
+		//! Les emplacements des étoiles du catalogue, par indice.
+		StarSlotArray m_starSlots;
+		//! Le nombre d'étoiles du catalogue déjà ajoutées aux billboards.
+		size_t m_uploaded{ 0u };
+		//! Le nombre d'objets du ciel profond déjà ajoutés aux billboards.
+		size_t m_deepSkyUploaded{ 0u };
+		//! L'époque à laquelle sont affichées les étoiles.
+		float m_epoch{ 2000.0f };
+		//! Le nombre d'images restant avant de ranger à nouveau les étoiles,
+		//! 0 si elles n'ont pas à l'être.
+		uint32_t m_relayoutDelay{ 0u };
+		//! L'intervalle des magnitudes utilisé pour l'échelle des étoiles.
+		render::Range< float > m_range{ 0.0f, 1.0f };
+		//! L'intervalle des magnitudes utilisé pour l'échelle des objets du
+		//! ciel profond.
+		render::Range< float > m_deepSkyRange{ 0.0f, 1.0f };
+		//! Le dernier avancement notifié.
+		float m_progress{ -1.0f };
+		//! Dit si les éléments GPU ont été initialisés.
+		bool m_initialised{ false };
 		//! L'objet sélectionné.
 		render::Object * m_pickedObject{ nullptr };
 		//! Le billboard sélectionné.
 		render::Billboard * m_pickedBillboard{ nullptr };
+		//! La position de la sélection demandée.
+		gl::IVec2 m_pickPosition;
+		//! Dit si une sélection est demandée pour la prochaine image.
+		bool m_pick{ false };
 		//! L'étoile sélectionnée.
 		Star const * m_pickedStar{ nullptr };
+		//! La tuile de l'étoile sélectionnée, gardée tant qu'elle l'est.
+		StarTilePtr m_pickedTile;
+		//! L'objet du ciel profond sélectionné.
+		DeepSkyObject const * m_pickedDeepSky{ nullptr };
 		//! Le billboard apparaissant sur la sélection (billboard ou objet).
 		render::BillboardPtr m_pickBillboard;
 		//! L'incrustation contenant la description de la sélection (billboard ou objet).
 		render::BorderPanelOverlayPtr m_pickDescriptionHolder;
 		//! L'incrustation décrivant la sélection (billboard ou objet).
 		render::TextOverlayPtr m_pickDescription;
+		//! Dit si le survol continu est activé.
+		bool m_hovering{ false };
+		//! Dit si une position de survol est connue.
+		bool m_hovered{ false };
+		//! La position du survol.
+		gl::IVec2 m_hoverPosition;
+		//! L'incrustation affichant le nom de l'étoile survolée.
+		render::TextOverlayPtr m_hoverDescription;
 		//! La texture d'opacité.
 		render::TexturePtr m_opacity;
 		//! La texture de police des noms.
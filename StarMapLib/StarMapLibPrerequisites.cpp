@@ -2,13 +2,14 @@
 
 namespace starmap
 {
-	gl::RgbColour bvToRgb( float bv )
+	namespace
 	{
 		struct BvToRgb
 		{
 			float bv;
 			gl::RgbColour rgb;
 		};
+
 		static std::vector< BvToRgb > const ConversionTable
 		{
 			{  -0.32f, { 155 / 255.0f, 176 / 255.0f, 255 / 255.0f } },
@@ -71,20 +72,119 @@ namespace starmap
 			{   1.95f, { 255 / 255.0f, 195 / 255.0f, 112 / 255.0f } },
 			{   2.00f, { 255 / 255.0f, 198 / 255.0f, 109 / 255.0f } }
 		};
-		auto it = std::find_if( std::begin( ConversionTable )
-			, std::end( ConversionTable )
-			, [&bv]( BvToRgb const & conv )
+		/**
+		*\brief
+		*	Le pas de la table d'accès direct, tous les seuils de la table de
+		*	conversion en sont des multiples.
+		*/
+		static float constexpr BvLookupStep = 0.005f;
+		/**
+		*\brief
+		*	Table d'accès direct aux indices de la palette, par tranche de
+		*	BvLookupStep.
+		*\remarks
+		*	Chaque case donne le premier indice possible pour sa tranche,
+		*	il ne reste qu'à avancer d'une ou deux entrées au plus.
+		*/
+		class BvLookup
+		{
+		public:
+			BvLookup()
+				: m_lower{ ConversionTable.front().bv }
+				, m_last{ uint8_t( ConversionTable.size() - 1u ) }
 			{
-				return conv.bv >= bv;
-			} );
+				auto range = ConversionTable.back().bv - m_lower;
+				m_indices.resize( size_t( range / BvLookupStep ) + 2u );
+				uint8_t index{ 0u };
+
+				for ( size_t i = 0u; i < m_indices.size(); ++i )
+				{
+					// Une demi-tranche de marge absorbe les erreurs d'arrondi.
+					auto bv = m_lower + ( float( i ) - 0.5f ) * BvLookupStep;
+
+					while ( index < m_last && ConversionTable[index].bv < bv )
+					{
+						++index;
+					}
+
+					m_indices[i] = index;
+				}
+			}
+
+			inline uint8_t find( float bv )const noexcept
+			{
+				auto slot = ( bv - m_lower ) / BvLookupStep;
+				slot = std::min( std::max( slot, 0.0f )
+					, float( m_indices.size() - 1u ) );
+				auto index = m_indices[size_t( slot )];
 
-		if ( it != std::end( ConversionTable ) )
+				while ( index < m_last && ConversionTable[index].bv < bv )
+				{
+					++index;
+				}
+
+				return index;
+			}
+
+		private:
+			float m_lower;
+			uint8_t m_last;
+			std::vector< uint8_t > m_indices;
+		};
+
+		BvLookup const & doGetBvLookup()
 		{
-			return it->rgb;
+			static BvLookup const lookup;
+			return lookup;
 		}
-		else
+	}
+
+	uint8_t bvToPaletteIndex( float bv )
+	{
+		return doGetBvLookup().find( bv );
+	}
+
+	void bvToPaletteIndices( float const * bv
+		, size_t count
+		, uint8_t * result )
+	{
+		auto & lookup = doGetBvLookup();
+
+		for ( size_t i = 0u; i < count; ++i )
 		{
-			return ConversionTable.back().rgb;
+			result[i] = lookup.find( bv[i] );
 		}
 	}
+
+	uint8_t rgbToPaletteIndex( gl::RgbColour const & colour )
+	{
+		auto distance = []( gl::RgbColour const & lhs, gl::RgbColour const & rhs )
+		{
+			auto diff = lhs - rhs;
+			return diff.x * diff.x + diff.y * diff.y + diff.z * diff.z;
+		};
+		auto it = std::min_element( std::begin( ConversionTable )
+			, std::end( ConversionTable )
+			, [&colour, &distance]( BvToRgb const & lhs, BvToRgb const & rhs )
+			{
+				return distance( lhs.rgb, colour ) < distance( rhs.rgb, colour );
+			} );
+		return uint8_t( std::distance( std::begin( ConversionTable ), it ) );
+	}
+
+	gl::RgbColour const & paletteColour( uint8_t index )
+	{
+		assert( index < ConversionTable.size() );
+		return ConversionTable[index].rgb;
+	}
+
+	uint32_t paletteSize()
+	{
+		return uint32_t( ConversionTable.size() );
+	}
+
+	gl::RgbColour bvToRgb( float bv )
+	{
+		return paletteColour( bvToPaletteIndex( bv ) );
+	}
 }
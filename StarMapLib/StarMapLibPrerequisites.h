@@ -18,10 +18,14 @@
 
 namespace starmap
 {
+	class CatalogueLoader;
 	class Constellation;
 	class ConstellationStar;
+	class DeepSkyObject;
+	class ReadMonitor;
 	class ScreenEvents;
 	class Star;
+	class StarCatalogue;
 	class StarMap;
 
 	struct StarMapState;
@@ -30,6 +34,8 @@ namespace starmap
 	using ConstellationPtr = std::unique_ptr< Constellation >;
 	using StarArray = std::vector< Star >;
 	using StarPtrArray = std::vector< Star const * >;
+	using DeepSkyObjectArray = std::vector< DeepSkyObject >;
+	using DeepSkyObjectPtrArray = std::vector< DeepSkyObject const * >;
 	using StarPtrMap = std::map< std::string, Star const * >;
 	using ConstellationMap = std::unordered_map< std::string, ConstellationPtr >;
 	using ConstellationStarArray = std::vector< ConstellationStar >;
@@ -38,10 +44,13 @@ namespace starmap
 	using OnScreenDoubleTap = render::Signal< std::function< void( gl::IVec2 const & ) > >;
 	using OnScreenSingleMove = render::Signal< std::function< void( gl::IVec2 const & ) > >;
 	using OnScreenDoubleMove = render::Signal< std::function< void( gl::IVec2 const &, float ) > >;
+	using OnScreenHover = render::Signal< std::function< void( gl::IVec2 const & ) > >;
 	using OnPick = render::Signal< std::function< void( gl::IVec2 const & ) > >;
+	using OnHover = render::Signal< std::function< void( gl::IVec2 const & ) > >;
 	using OnReset = render::Signal< std::function< void() > >;
 	using OnSetVelocity = render::Signal< std::function< void( gl::IVec2 const & ) > >;
 	using OnSetZoomVelocity = render::Signal< std::function< void( float ) > >;
+	using OnLoadProgress = render::Signal< std::function< void( float ) > >;
 
 	using StarMapPtr = std::unique_ptr< StarMap >;
 
@@ -55,6 +64,8 @@ namespace starmap
 		eStar,
 		//! Constellations.
 		eConstellation,
+		//! Objets du ciel profond.
+		eDeepSky,
 	};
 	/**
 	*\brief
@@ -65,6 +76,52 @@ namespace starmap
 	*	La couleur correspondante.
 	*/
 	gl::RgbColour bvToRgb( float bv );
+	/**
+	*\brief
+	*	Convertit un index de couleur B-V en indice dans la palette des
+	*	couleurs d'étoiles.
+	*\param[in] bv
+	*	L'index de la couleur.
+	*\return
+	*	L'indice dans la palette.
+	*/
+	uint8_t bvToPaletteIndex( float bv );
+	/**
+	*\brief
+	*	Convertit des index de couleur B-V en indices dans la palette des
+	*	couleurs d'étoiles.
+	*\param[in] bv
+	*	Les index des couleurs.
+	*\param[in] count
+	*	Le nombre d'index.
+	*\param[out] result
+	*	Reçoit les indices dans la palette.
+	*/
+	void bvToPaletteIndices( float const * bv
+		, size_t count
+		, uint8_t * result );
+	/**
+	*\brief
+	*	Recherche la couleur de la palette la plus proche de la couleur
+	*	donnée.
+	*\param[in] colour
+	*	La couleur RVB.
+	*\return
+	*	L'indice dans la palette.
+	*/
+	uint8_t rgbToPaletteIndex( gl::RgbColour const & colour );
+	/**
+	*\param[in] index
+	*	L'indice dans la palette.
+	*\return
+	*	La couleur RVB correspondante.
+	*/
+	gl::RgbColour const & paletteColour( uint8_t index );
+	/**
+	*\return
+	*	Le nombre de couleurs de la palette.
+	*/
+	uint32_t paletteSize();
 }
 
 #endif
@@ -8,7 +8,9 @@
 #define ___StarMapLib_StarMapState_HPP___
 #pragma once
 
+#include "CatalogueMerge.h"
 #include "Constellation.h"
+#include "DeepSkyObject.h"
 #include "Star.h"
 
 #include <RenderLib/CameraState.h>
@@ -80,7 +82,30 @@ namespace starmap
 	using ConstellationInfoArray = std::array< ConstellationInfo, 88 >;
 	/**
 	*\brief
+	*	Structure contenant les informations nécessaires à la construction
+	*	d'un objet du ciel profond.
+	*/
+	struct DeepSkyInfo
+	{
+		//! Le nom de l'objet.
+		String m_name;
+		//! La famille de l'objet.
+		DeepSkyType m_type;
+		//! La magnitude de l'objet.
+		float m_magnitude;
+		//! Le rayon apparent de l'objet, en minutes d'arc.
+		float m_radius;
+		//! La direction de l'objet, en coordonnées octaédriques.
+		uint16_t m_direction[2];
+	};
+	/**
+	*\brief
 	*	Structure de sauvegarde de l'état de la carte des étoiles.
+	*\remarks
+	*	Elle est suivie des m_count StarInfo des étoiles, puis des
+	*	m_identifierCount StarIdentifiers de leurs identifiants, puis des
+	*	m_motionCount StarMotion de leurs mouvements propres, et enfin des
+	*	m_deepSkyCount DeepSkyInfo des objets du ciel profond.
 	*/
 	struct StarMapState
 	{
@@ -90,6 +115,14 @@ namespace starmap
 		render::CameraState m_state;
 		//! Le nombre d'étoiles.
 		uint32_t m_count;
+		//! Le nombre d'identifiants d'étoiles, 0 ou m_count.
+		uint32_t m_identifierCount;
+		//! Le nombre de mouvements propres d'étoiles, 0 ou m_count.
+		uint32_t m_motionCount;
+		//! Le nombre d'objets du ciel profond.
+		uint32_t m_deepSkyCount;
+		//! L'année de l'époque à laquelle sont affichées les étoiles.
+		float m_epoch;
 	};
 }
 
@@ -0,0 +1,15 @@
+#include "StarTable.h"
+
+namespace starmap
+{
+	void StarTable::build( StarArray const & stars )
+	{
+		clear();
+		m_flags.resize( stars.size(), StarFlag::eNone );
+	}
+
+	void StarTable::clear()
+	{
+		m_flags.clear();
+	}
+}
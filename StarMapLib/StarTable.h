@@ -0,0 +1,93 @@
+/**
+*\file
+*	StarTable.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_StarTable_HPP___
+#define ___StarMapLib_StarTable_HPP___
+#pragma once
+
+#include "Star.h"
+
+#include <RenderLib/FlagCombination.h>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les indicateurs associés à une étoile.
+	*/
+	enum class StarFlag
+		: uint8_t
+	{
+		//! Aucun indicateur.
+		eNone = 0x00,
+		//! L'étoile appartient à une constellation.
+		eMember = 0x01,
+	};
+	RenderLib_ImplementFlag( StarFlag )
+	/**
+	*\brief
+	*	Les données dérivées des étoiles d'un catalogue trié, qu'elles ne
+	*	portent pas elles-mêmes, rangées par colonnes.
+	*\remarks
+	*	La ligne i correspond à l'étoile d'index i du catalogue.\n
+	*	Les positions, magnitudes, couleurs et noms ne sont pas recopiés :
+	*	les boucles les lisent directement dans les données compactées des
+	*	étoiles (voir PackedStar).
+	*/
+	class StarTable
+	{
+	public:
+		/**
+		*\brief
+		*	Dimensionne les colonnes pour les étoiles triées.
+		*\remarks
+		*	Les indicateurs sont remis à zéro.
+		*\param[in] stars
+		*	Les étoiles.
+		*/
+		void build( StarArray const & stars );
+		/**
+		*\brief
+		*	Vide les colonnes.
+		*/
+		void clear();
+		/**
+		*\brief
+		*	Ajoute un indicateur à une étoile.
+		*\param[in] index
+		*	L'index de l'étoile.
+		*\param[in] flag
+		*	L'indicateur.
+		*/
+		inline void addFlag( size_t index, StarFlag flag )noexcept
+		{
+			assert( index < m_flags.size() );
+			m_flags[index] = render::addFlag( m_flags[index], flag );
+		}
+		/**
+		*\return
+		*	Le nombre de lignes.
+		*/
+		inline size_t size()const noexcept
+		{
+			return m_flags.size();
+		}
+		/**
+		*\return
+		*	Les indicateurs des étoiles.
+		*/
+		inline std::vector< StarFlags > const & flags()const noexcept
+		{
+			return m_flags;
+		}
+
+	private:
+		//! Les indicateurs des étoiles.
+		std::vector< StarFlags > m_flags;
+	};
+}
+
+#endif
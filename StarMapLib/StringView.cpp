@@ -0,0 +1,195 @@
+#include "StringView.h"
+
+namespace starmap
+{
+	namespace
+	{
+		static double const PowersOf10[]
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+		};
+		static int const MaxPowerOf10 = int( sizeof( PowersOf10 ) / sizeof( double ) ) - 1;
+
+		inline bool isDigit( char c )noexcept
+		{
+			return uint32_t( c - '0' ) < 10u;
+		}
+
+		double doScale( double value, int exponent )noexcept
+		{
+			while ( exponent > MaxPowerOf10 )
+			{
+				value *= PowersOf10[MaxPowerOf10];
+				exponent -= MaxPowerOf10;
+			}
+
+			while ( exponent < -MaxPowerOf10 )
+			{
+				value /= PowersOf10[MaxPowerOf10];
+				exponent += MaxPowerOf10;
+			}
+
+			return exponent >= 0
+				? value * PowersOf10[exponent]
+				: value / PowersOf10[-exponent];
+		}
+	}
+
+	size_t hash( StringView const & text )noexcept
+	{
+		uint64_t result{ 14695981039346656037ull };
+
+		for ( auto c : text )
+		{
+			result ^= uint8_t( c );
+			result *= 1099511628211ull;
+		}
+
+		return size_t( result );
+	}
+
+	StringView unquote( StringView const & text )noexcept
+	{
+		auto begin = text.begin();
+		auto end = text.end();
+
+		if ( end - begin >= 2
+			&& *begin == '"'
+			&& *( end - 1 ) == '"' )
+		{
+			++begin;
+			--end;
+		}
+
+		return StringView{ begin, end };
+	}
+
+	bool parseFloat( StringView const & text
+		, float & value )noexcept
+	{
+		auto view = unquote( text );
+		auto it = view.begin();
+		auto end = view.end();
+
+		while ( it != end && ( *it == ' ' || *it == '\t' ) )
+		{
+			++it;
+		}
+
+		bool negative = false;
+
+		if ( it != end && ( *it == '-' || *it == '+' ) )
+		{
+			negative = *it == '-';
+			++it;
+		}
+
+		// Les 19 premiers chiffres significatifs tiennent dans un uint64_t,
+		// les suivants ne font que décaler l'exposant.
+		uint64_t mantissa{ 0u };
+		int digits{ 0 };
+		int exponent{ 0 };
+		bool any{ false };
+
+		while ( it != end && isDigit( *it ) )
+		{
+			if ( digits < 19 )
+			{
+				mantissa = mantissa * 10u + uint64_t( *it - '0' );
+				digits += mantissa ? 1 : 0;
+			}
+			else
+			{
+				++exponent;
+			}
+
+			any = true;
+			++it;
+		}
+
+		if ( it != end && *it == '.' )
+		{
+			++it;
+
+			while ( it != end && isDigit( *it ) )
+			{
+				if ( digits < 19 )
+				{
+					mantissa = mantissa * 10u + uint64_t( *it - '0' );
+					digits += mantissa ? 1 : 0;
+					--exponent;
+				}
+
+				any = true;
+				++it;
+			}
+		}
+
+		if ( !any )
+		{
+			return false;
+		}
+
+		if ( it != end && ( *it == 'e' || *it == 'E' ) )
+		{
+			auto save = it++;
+			bool negativeExp = false;
+
+			if ( it != end && ( *it == '-' || *it == '+' ) )
+			{
+				negativeExp = *it == '-';
+				++it;
+			}
+
+			if ( it != end && isDigit( *it ) )
+			{
+				int exp{ 0 };
+
+				while ( it != end && isDigit( *it ) )
+				{
+					if ( exp < 10000 )
+					{
+						exp = exp * 10 + ( *it - '0' );
+					}
+
+					++it;
+				}
+
+				exponent += negativeExp ? -exp : exp;
+			}
+			else
+			{
+				it = save;
+			}
+		}
+
+		auto result = doScale( double( mantissa ), exponent );
+		value = float( negative ? -result : result );
+		return true;
+	}
+
+	bool parseUInt( StringView const & text
+		, uint32_t & value )noexcept
+	{
+		auto view = unquote( text );
+		auto it = view.begin();
+		auto end = view.end();
+
+		if ( it == end || !isDigit( *it ) )
+		{
+			return false;
+		}
+
+		uint32_t result{ 0u };
+
+		while ( it != end && isDigit( *it ) )
+		{
+			result = result * 10u + uint32_t( *it - '0' );
+			++it;
+		}
+
+		value = result;
+		return true;
+	}
+}
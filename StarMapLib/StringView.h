@@ -0,0 +1,220 @@
+/**
+*\file
+*	StringView.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_StringView_HPP___
+#define ___StarMapLib_StringView_HPP___
+#pragma once
+
+#include "StarMapLibPrerequisites.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Vue non possédante sur une suite de caractères.
+	*\remarks
+	*	Equivalent minimal de std::string_view, qui n'est pas disponible en
+	*	C++14. Permet de parcourir les catalogues sans allouer de chaîne
+	*	pour chaque champ.
+	*/
+	class StringView
+	{
+	public:
+		/**
+		*\brief
+		*	Constructeur, vue vide.
+		*/
+		StringView()noexcept = default;
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] begin, end
+		*	Les bornes de la vue.
+		*/
+		inline StringView( char const * begin
+			, char const * end )noexcept
+			: m_begin{ begin }
+			, m_end{ end }
+		{
+		}
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] text
+		*	La chaîne à zéro terminal.
+		*/
+		inline StringView( char const * text )noexcept
+			: m_begin{ text }
+			, m_end{ text + strlen( text ) }
+		{
+		}
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] text
+		*	La chaîne.
+		*/
+		inline StringView( std::string const & text )noexcept
+			: m_begin{ text.data() }
+			, m_end{ text.data() + text.size() }
+		{
+		}
+		/**
+		*\return
+		*	Le début de la vue.
+		*/
+		inline char const * begin()const noexcept
+		{
+			return m_begin;
+		}
+		/**
+		*\return
+		*	La fin de la vue.
+		*/
+		inline char const * end()const noexcept
+		{
+			return m_end;
+		}
+		/**
+		*\return
+		*	Le début de la vue.
+		*/
+		inline char const * data()const noexcept
+		{
+			return m_begin;
+		}
+		/**
+		*\return
+		*	La taille de la vue.
+		*/
+		inline size_t size()const noexcept
+		{
+			return size_t( m_end - m_begin );
+		}
+		/**
+		*\return
+		*	\p true si la vue est vide.
+		*/
+		inline bool empty()const noexcept
+		{
+			return m_begin == m_end;
+		}
+		/**
+		*\return
+		*	Le caractère à l'indice donné.
+		*/
+		inline char operator[]( size_t index )const noexcept
+		{
+			assert( index < size() );
+			return m_begin[index];
+		}
+		/**
+		*\return
+		*	Une copie du contenu de la vue.
+		*/
+		inline std::string str()const
+		{
+			return std::string{ m_begin, m_end };
+		}
+
+	private:
+		//! Le début de la vue.
+		char const * m_begin{ nullptr };
+		//! La fin de la vue.
+		char const * m_end{ nullptr };
+	};
+	/**
+	*\brief
+	*	Opérateur d'égalité.
+	*/
+	inline bool operator==( StringView const & lhs, StringView const & rhs )noexcept
+	{
+		return lhs.size() == rhs.size()
+			&& std::equal( lhs.begin(), lhs.end(), rhs.begin() );
+	}
+	/**
+	*\brief
+	*	Opérateur de différence.
+	*/
+	inline bool operator!=( StringView const & lhs, StringView const & rhs )noexcept
+	{
+		return !( lhs == rhs );
+	}
+	/**
+	*\brief
+	*	Opérateur d'écriture dans un flux.
+	*/
+	inline std::ostream & operator<<( std::ostream & stream, StringView const & text )
+	{
+		return stream.write( text.data(), std::streamsize( text.size() ) );
+	}
+	/**
+	*\brief
+	*	Calcule le hash d'un texte (FNV-1a).
+	*\remarks
+	*	Utilisé pour identifier les étoiles par leur nom, sans avoir à
+	*	construire de std::string.
+	*\param[in] text
+	*	Le texte.
+	*\return
+	*	Le hash.
+	*/
+	size_t hash( StringView const & text )noexcept;
+	/**
+	*\brief
+	*	Supprime les guillemets entourant le texte, s'il y en a.
+	*\param[in] text
+	*	Le texte.
+	*\return
+	*	La vue sans les guillemets.
+	*/
+	StringView unquote( StringView const & text )noexcept;
+	/**
+	*\brief
+	*	Convertit le texte donné en nombre flottant, à la manière de
+	*	std::from_chars.
+	*\remarks
+	*	Le séparateur de décimales doit être '.', la notation exponentielle
+	*	est supportée. Les guillemets entourant le nombre sont ignorés.
+	*\param[in] text
+	*	Le texte.
+	*\param[out] value
+	*	Reçoit la valeur, inchangée en cas d'échec.
+	*\return
+	*	\p false si le texte ne contient pas de nombre.
+	*/
+	bool parseFloat( StringView const & text
+		, float & value )noexcept;
+	/**
+	*\brief
+	*	Convertit le texte donné en entier non signé, à la manière de
+	*	std::from_chars.
+	*\param[in] text
+	*	Le texte.
+	*\param[out] value
+	*	Reçoit la valeur, inchangée en cas d'échec.
+	*\return
+	*	\p false si le texte ne commence pas par un chiffre.
+	*/
+	bool parseUInt( StringView const & text
+		, uint32_t & value )noexcept;
+	/**
+	*\brief
+	*	Convertit le texte donné en nombre flottant.
+	*\param[in] text
+	*	Le texte.
+	*\return
+	*	La valeur, 0 si le texte ne contient pas de nombre.
+	*/
+	inline float toFloat( StringView const & text )noexcept
+	{
+		float result{ 0.0f };
+		parseFloat( text, result );
+		return result;
+	}
+}
+
+#endif
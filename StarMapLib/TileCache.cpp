@@ -0,0 +1,298 @@
+#include "TileCache.h"
+
+#include "SkyTiling.h"
+
+namespace starmap
+{
+	TileCache::TileCache( std::string const & fileName
+		, size_t budget )
+		: m_file{ fileName, std::ios::binary }
+		, m_budget{ budget }
+	{
+		SmtHeader header{};
+
+		if ( !m_file.read( reinterpret_cast< char * >( &header ), sizeof( SmtHeader ) )
+			|| header.magic != SmtMagic
+			|| header.version != SmtVersion
+			|| header.level >= MaxTileLevel
+			|| header.tileCount != tileCount( header.level ) )
+		{
+			std::cerr << "Invalid tiled catalogue [" << fileName << "]." << std::endl;
+			return;
+		}
+
+		m_tiles.resize( header.tileCount );
+
+		if ( !m_file.read( reinterpret_cast< char * >( m_tiles.data() )
+			, std::streamsize( m_tiles.size() * sizeof( SmtTile ) ) ) )
+		{
+			std::cerr << "Invalid tiled catalogue [" << fileName << "]." << std::endl;
+			m_tiles.clear();
+			return;
+		}
+
+		// Le coût moyen d'une étoile compte la part moyenne des noms.
+		uint64_t strings{ 0u };
+
+		for ( auto & tile : m_tiles )
+		{
+			strings += tile.stringsSize;
+		}
+
+		if ( header.starCount )
+		{
+			m_starCost += size_t( strings / header.starCount );
+		}
+
+		m_header = header;
+		m_worker = std::async( std::launch::async
+			, [this]()
+			{
+				doRun();
+			} );
+	}
+
+	TileCache::~TileCache()
+	{
+		{
+			std::lock_guard< std::mutex > lock{ m_mutex };
+			m_stopped = true;
+		}
+
+		m_condition.notify_one();
+
+		if ( m_worker.valid() )
+		{
+			m_worker.wait();
+		}
+	}
+
+	void TileCache::request( RequestArray const & requests )
+	{
+		m_wanted.clear();
+
+		// Parcourues à l'envers, les tuiles voulues finissent en tête du
+		// LRU dans leur ordre de priorité.
+		for ( auto it = requests.rbegin(); it != requests.rend(); ++it )
+		{
+			m_wanted[it->tile] = it->depth;
+			doTouch( it->tile );
+		}
+
+		{
+			std::lock_guard< std::mutex > lock{ m_mutex };
+			m_queue.clear();
+
+			for ( auto request : requests )
+			{
+				assert( request.tile < m_tiles.size() );
+				request.depth = std::min( request.depth, m_tiles[request.tile].starCount );
+				auto tile = find( request.tile );
+
+				if ( request.depth
+					&& ( !tile || tile->stars.size() < request.depth )
+					&& !doIsPending( request ) )
+				{
+					m_queue.push_back( request );
+				}
+			}
+		}
+
+		m_condition.notify_one();
+	}
+
+	bool TileCache::update()
+	{
+		StarTileArray read;
+
+		{
+			std::lock_guard< std::mutex > lock{ m_mutex };
+			std::swap( read, m_read );
+		}
+
+		for ( auto & tile : read )
+		{
+			auto it = m_resident.find( tile->index );
+
+			if ( it != m_resident.end() )
+			{
+				// Une lecture moins profonde que la tuile présente, demandée
+				// avant que celle-ci ne soit intégrée, est ignorée.
+				if ( ( *it->second )->stars.size() >= tile->stars.size() )
+				{
+					continue;
+				}
+
+				m_memory -= ( *it->second )->memory();
+				m_lru.erase( it->second );
+			}
+
+			m_lru.push_front( tile );
+			m_resident[tile->index] = m_lru.begin();
+			m_memory += tile->memory();
+		}
+
+		auto it = m_lru.end();
+
+		while ( m_memory > m_budget && it != m_lru.begin() )
+		{
+			--it;
+
+			if ( m_wanted.find( ( *it )->index ) == m_wanted.end() )
+			{
+				m_memory -= ( *it )->memory();
+				m_resident.erase( ( *it )->index );
+				it = m_lru.erase( it );
+			}
+		}
+
+		return !read.empty();
+	}
+
+	StarTilePtr TileCache::find( uint32_t tile )const
+	{
+		auto it = m_resident.find( tile );
+		return it == m_resident.end()
+			? nullptr
+			: *it->second;
+	}
+
+	uint32_t TileCache::depth( uint32_t tile
+		, float magnitude )const
+	{
+		assert( tile < m_tiles.size() );
+		auto & info = m_tiles[tile];
+		auto depth = std::ceil( magnitude );
+
+		if ( depth < 0.0f )
+		{
+			return info.depths[0];
+		}
+
+		if ( depth >= float( SmtDepthCount ) )
+		{
+			return info.starCount;
+		}
+
+		return info.depths[size_t( depth )];
+	}
+
+	void TileCache::doRun()
+	{
+		while ( true )
+		{
+			Request request;
+
+			{
+				std::unique_lock< std::mutex > lock{ m_mutex };
+				m_condition.wait( lock
+					, [this]()
+					{
+						return m_stopped || !m_queue.empty();
+					} );
+
+				if ( m_stopped )
+				{
+					return;
+				}
+
+				request = m_queue.front();
+				m_queue.pop_front();
+				m_reading = request;
+			}
+
+			auto tile = doRead( request );
+
+			{
+				std::lock_guard< std::mutex > lock{ m_mutex };
+				m_reading = Request{ ~0u, 0u };
+
+				if ( tile )
+				{
+					m_read.push_back( tile );
+				}
+			}
+		}
+	}
+
+	StarTilePtr TileCache::doRead( Request const & request )
+	{
+		assert( request.tile < m_tiles.size() );
+		auto & info = m_tiles[request.tile];
+		auto count = std::min( request.depth, info.starCount );
+		std::vector< PackedStar > packed( count );
+		std::vector< uint32_t > ends( count );
+		m_file.seekg( std::streamoff( info.offset ) );
+		m_file.read( reinterpret_cast< char * >( packed.data() )
+			, std::streamsize( count * sizeof( PackedStar ) ) );
+		m_file.seekg( std::streamoff( info.offset
+			+ info.starCount * sizeof( PackedStar ) ) );
+		m_file.read( reinterpret_cast< char * >( ends.data() )
+			, std::streamsize( count * sizeof( uint32_t ) ) );
+		auto result = std::make_shared< StarTile >();
+		result->index = request.tile;
+
+		std::string strings;
+
+		if ( count && m_file )
+		{
+			strings.resize( std::min( ends.back(), info.stringsSize ) );
+			m_file.seekg( std::streamoff( info.offset
+				+ info.starCount * ( sizeof( PackedStar ) + sizeof( uint32_t ) ) ) );
+			m_file.read( &strings[0]
+				, std::streamsize( strings.size() ) );
+		}
+
+		if ( !m_file )
+		{
+			std::cerr << "Couldn't read tile " << request.tile << "." << std::endl;
+			m_file.clear();
+			return nullptr;
+		}
+
+		// Les noms sont recopiés, chacun suivi d'un zéro, afin que les
+		// étoiles n'en gardent que la position.
+		result->stars.reserve( count );
+		result->names.reserve( strings.size() + count );
+		uint32_t begin{ 0u };
+
+		for ( uint32_t i = 0u; i < count; ++i )
+		{
+			auto end = std::max( begin, std::min( ends[i], uint32_t( strings.size() ) ) );
+			result->stars.emplace_back( uint32_t( result->names.size() )
+				, packed[i] );
+			result->names.append( strings.data() + begin, end - begin );
+			result->names.push_back( '\0' );
+			begin = end;
+		}
+
+		return result;
+	}
+
+	void TileCache::doTouch( uint32_t tile )
+	{
+		auto it = m_resident.find( tile );
+
+		if ( it != m_resident.end() )
+		{
+			m_lru.splice( m_lru.begin(), m_lru, it->second );
+		}
+	}
+
+	bool TileCache::doIsPending( Request const & request )const
+	{
+		if ( m_reading.tile == request.tile
+			&& m_reading.depth >= request.depth )
+		{
+			return true;
+		}
+
+		return std::any_of( m_read.begin()
+			, m_read.end()
+			, [&request]( StarTilePtr const & tile )
+			{
+				return tile->index == request.tile
+					&& tile->stars.size() >= request.depth;
+			} );
+	}
+}
@@ -0,0 +1,285 @@
+/**
+*\file
+*	TileCache.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_TileCache_HPP___
+#define ___StarMapLib_TileCache_HPP___
+#pragma once
+
+#include "SmtFormat.h"
+#include "Star.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <list>
+#include <mutex>
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Les étoiles chargées d'une tuile.
+	*/
+	struct StarTile
+	{
+		/**
+		*\return
+		*	La mémoire occupée par la tuile.
+		*/
+		inline size_t memory()const noexcept
+		{
+			return sizeof( StarTile )
+				+ names.capacity()
+				+ stars.capacity() * sizeof( Star );
+		}
+		/**
+		*\param[in] star
+		*	Une étoile de la tuile.
+		*\return
+		*	Le nom de l'étoile.
+		*/
+		inline StringView name( Star const & star )const noexcept
+		{
+			auto begin = names.data() + star.name();
+			return StringView{ begin, begin + strlen( begin ) };
+		}
+
+		//! L'indice de la tuile.
+		uint32_t index;
+		//! Les noms des étoiles, chacun terminé par un zéro, référencés par
+		//! leur position.
+		std::string names;
+		//! Les étoiles chargées, les plus brillantes de la tuile, triées par
+		//! magnitude.
+		StarArray stars;
+	};
+	//! Un pointeur sur les étoiles d'une tuile, partagé afin qu'elles
+	//! survivent à leur éviction du cache tant qu'elles sont affichées.
+	using StarTilePtr = std::shared_ptr< StarTile const >;
+	//! Un tableau de tuiles chargées.
+	using StarTileArray = std::vector< StarTilePtr >;
+	/**
+	*\brief
+	*	Lit à la demande les tuiles d'un fichier .smt, sur un thread de
+	*	travail, et garde les tuiles lues dans un cache LRU de taille
+	*	mémoire bornée.
+	*\remarks
+	*	Le thread de rendu donne les tuiles voulues via request(), puis
+	*	récupère les tuiles lues via update(). Seul le thread de travail
+	*	accède au fichier, une fois l'en-tête lu par le constructeur.
+	*/
+	class TileCache
+	{
+	public:
+		/**
+		*\brief
+		*	Une tuile voulue.
+		*/
+		struct Request
+		{
+			//! L'indice de la tuile.
+			uint32_t tile;
+			//! Le nombre d'étoiles voulues, les plus brillantes de la tuile.
+			uint32_t depth;
+		};
+		//! Un tableau de tuiles voulues.
+		using RequestArray = std::vector< Request >;
+
+	public:
+		/**
+		*\brief
+		*	Constructeur, lit l'en-tête du fichier et démarre le thread de
+		*	travail.
+		*\remarks
+		*	Si le fichier n'est pas un fichier .smt valide, une erreur est
+		*	affichée et le cache est invalide (voir valid()).
+		*\param[in] fileName
+		*	Le chemin du fichier .smt.
+		*\param[in] budget
+		*	La mémoire maximale occupée par les tuiles chargées, en octets.
+		*/
+		TileCache( std::string const & fileName
+			, size_t budget );
+		TileCache( TileCache const & ) = delete;
+		TileCache & operator=( TileCache const & ) = delete;
+		/**
+		*\brief
+		*	Destructeur, arrête le thread de travail, après la lecture en
+		*	cours.
+		*/
+		~TileCache();
+		/**
+		*\brief
+		*	Définit les tuiles voulues, remplaçant les précédentes.
+		*\remarks
+		*	Les tuiles déjà chargées à la profondeur voulue sont marquées
+		*	comme récemment utilisées, les autres sont lues dans l'ordre
+		*	donné.
+		*\param[in] requests
+		*	Les tuiles, par ordre de priorité décroissante.
+		*/
+		void request( RequestArray const & requests );
+		/**
+		*\brief
+		*	Intègre au cache les tuiles lues depuis le dernier appel, puis
+		*	évince les tuiles les moins récemment utilisées jusqu'à revenir
+		*	sous le budget mémoire.
+		*\remarks
+		*	Les tuiles voulues ne sont jamais évincées.
+		*\return
+		*	\p true si des tuiles ont été intégrées.
+		*/
+		bool update();
+		/**
+		*\brief
+		*	Recherche une tuile dans le cache.
+		*\param[in] tile
+		*	L'indice de la tuile.
+		*\return
+		*	La tuile, \p nullptr si elle n'est pas chargée.
+		*/
+		StarTilePtr find( uint32_t tile )const;
+		/**
+		*\brief
+		*	Récupère le nombre d'étoiles d'une tuile dont la magnitude est
+		*	inférieure ou égale à celle donnée.
+		*\remarks
+		*	Les profondeurs étant connues par magnitude entière, la
+		*	magnitude est arrondie à l'entier supérieur.
+		*\param[in] tile
+		*	L'indice de la tuile.
+		*\param[in] magnitude
+		*	La magnitude.
+		*\return
+		*	Le nombre d'étoiles.
+		*/
+		uint32_t depth( uint32_t tile
+			, float magnitude )const;
+		/**
+		*\return
+		*	\p true si le fichier a été ouvert et son en-tête lu.
+		*/
+		inline bool valid()const noexcept
+		{
+			return m_header.magic == SmtMagic;
+		}
+		/**
+		*\return
+		*	Le niveau des tuiles du fichier.
+		*/
+		inline uint32_t level()const noexcept
+		{
+			return m_header.level;
+		}
+		/**
+		*\return
+		*	La magnitude de l'étoile la plus faible du fichier.
+		*/
+		inline float faintest()const noexcept
+		{
+			return m_header.faintest;
+		}
+		/**
+		*\return
+		*	Le nombre moyen d'étoiles tenant dans le budget mémoire.
+		*/
+		inline size_t capacity()const noexcept
+		{
+			return m_budget / m_starCost;
+		}
+		/**
+		*\return
+		*	La mémoire occupée par les tuiles chargées.
+		*/
+		inline size_t memory()const noexcept
+		{
+			return m_memory;
+		}
+
+	private:
+		/**
+		*\brief
+		*	La boucle du thread de travail.
+		*/
+		void doRun();
+		/**
+		*\brief
+		*	Lit les premières étoiles d'une tuile.
+		*/
+		StarTilePtr doRead( Request const & request );
+		/**
+		*\brief
+		*	Marque une tuile chargée comme la plus récemment utilisée.
+		*/
+		void doTouch( uint32_t tile );
+		/**
+		*\brief
+		*	Dit si une tuile est lue, ou en attente d'intégration, avec au
+		*	moins la profondeur donnée.
+		*\remarks
+		*	Doit être appelé avec m_mutex verrouillé.
+		*/
+		bool doIsPending( Request const & request )const;
+
+	private:
+		//! Le fichier, lu par le thread de travail.
+		std::ifstream m_file;
+		//! L'en-tête du fichier.
+		SmtHeader m_header{};
+		//! Les tuiles du fichier.
+		std::vector< SmtTile > m_tiles;
+		//! Le budget mémoire, en octets.
+		size_t m_budget;
+		//! La mémoire moyenne occupée par une étoile chargée.
+		size_t m_starCost{ sizeof( Star ) };
+		//! La mémoire occupée par les tuiles chargées.
+		size_t m_memory{ 0u };
+		//! Les tuiles chargées, de la plus récemment utilisée à la moins
+		//! récemment utilisée.
+		std::list< StarTilePtr > m_lru;
+		//! L'emplacement de chaque tuile chargée dans m_lru.
+		std::unordered_map< uint32_t, std::list< StarTilePtr >::iterator > m_resident;
+		//! Les tuiles voulues, qui ne peuvent être évincées.
+		std::unordered_map< uint32_t, uint32_t > m_wanted;
+		//! Protège les membres partagés avec le thread de travail.
+		mutable std::mutex m_mutex;
+		//! Réveille le thread de travail.
+		std::condition_variable m_condition;
+		//! Partagé : les tuiles à lire, par ordre de priorité.
+		std::list< Request > m_queue;
+		//! Partagé : la tuile en cours de lecture.
+		Request m_reading{ ~0u, 0u };
+		//! Partagé : les tuiles lues, en attente d'intégration.
+		StarTileArray m_read;
+		//! Partagé : dit si le thread de travail doit s'arrêter.
+		bool m_stopped{ false };
+		//! Le résultat du thread de travail.
+		std::future< void > m_worker;
+	};
+	//! Un pointeur sur un TileCache.
+	using TileCachePtr = std::unique_ptr< TileCache >;
+	/**
+	*\brief
+	*	Opérateur d'égalité.
+	*/
+	inline bool operator==( TileCache::Request const & lhs
+		, TileCache::Request const & rhs )
+	{
+		return lhs.tile == rhs.tile
+			&& lhs.depth == rhs.depth;
+	}
+	/**
+	*\brief
+	*	Opérateur de différence.
+	*/
+	inline bool operator!=( TileCache::Request const & lhs
+		, TileCache::Request const & rhs )
+	{
+		return !( lhs == rhs );
+	}
+}
+
+#endif
@@ -0,0 +1,299 @@
+#include "XmlPullReader.h"
+
+namespace starmap
+{
+	namespace
+	{
+		inline bool isSpace( char c )noexcept
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+
+		inline bool isNameEnd( char c )noexcept
+		{
+			return isSpace( c ) || c == '/' || c == '>' || c == '=';
+		}
+
+		inline bool startsWith( char const * it
+			, char const * end
+			, StringView const & prefix )noexcept
+		{
+			return size_t( end - it ) >= prefix.size()
+				&& std::equal( prefix.begin(), prefix.end(), it );
+		}
+
+		char const * doSkipSpaces( char const * it
+			, char const * end )noexcept
+		{
+			while ( it != end && isSpace( *it ) )
+			{
+				++it;
+			}
+
+			return it;
+		}
+
+		char const * doParseName( char const * it
+			, char const * end
+			, StringView & name )noexcept
+		{
+			auto begin = it;
+
+			while ( it != end && !isNameEnd( *it ) )
+			{
+				++it;
+			}
+
+			name = StringView{ begin, it };
+			return it;
+		}
+		/**
+		*\brief
+		*	Saute le contenu jusqu'après le terminateur donné.
+		*\return
+		*	\p nullptr si le terminateur n'est pas trouvé.
+		*/
+		char const * doSkipPast( char const * it
+			, char const * end
+			, StringView const & terminator )noexcept
+		{
+			auto result = std::search( it, end
+				, terminator.begin(), terminator.end() );
+			return result == end
+				? nullptr
+				: result + terminator.size();
+		}
+		/**
+		*\brief
+		*	Cherche le '>' fermant une balise, en ignorant ceux situés dans
+		*	la valeur d'un attribut.
+		*\return
+		*	\p nullptr s'il n'est pas trouvé.
+		*/
+		char const * doFindTagEnd( char const * it
+			, char const * end )noexcept
+		{
+			char quote = 0;
+
+			while ( it != end )
+			{
+				if ( quote )
+				{
+					if ( *it == quote )
+					{
+						quote = 0;
+					}
+				}
+				else if ( *it == '"' || *it == '\'' )
+				{
+					quote = *it;
+				}
+				else if ( *it == '>' )
+				{
+					return it;
+				}
+
+				++it;
+			}
+
+			return nullptr;
+		}
+		/**
+		*\brief
+		*	Saute une déclaration <!...>, qui peut contenir des sous-ensembles
+		*	entre crochets (DOCTYPE).
+		*/
+		char const * doSkipDeclaration( char const * it
+			, char const * end )noexcept
+		{
+			uint32_t brackets{ 0u };
+
+			while ( it != end )
+			{
+				if ( *it == '[' )
+				{
+					++brackets;
+				}
+				else if ( *it == ']' && brackets )
+				{
+					--brackets;
+				}
+				else if ( *it == '>' && !brackets )
+				{
+					return it + 1;
+				}
+
+				++it;
+			}
+
+			return nullptr;
+		}
+	}
+
+	XmlPullReader::XmlPullReader( StringView const & content )noexcept
+		: m_it{ content.begin() }
+		, m_end{ content.end() }
+	{
+	}
+
+	XmlPullReader::Event XmlPullReader::next()noexcept
+	{
+		m_attributes = StringView{};
+
+		if ( m_pendingEnd )
+		{
+			m_pendingEnd = false;
+			return Event::eEndElement;
+		}
+
+		while ( m_it != m_end )
+		{
+			auto lt = static_cast< char const * >( memchr( m_it, '<', size_t( m_end - m_it ) ) );
+
+			if ( !lt )
+			{
+				m_it = m_end;
+				break;
+			}
+
+			auto it = lt + 1;
+
+			if ( startsWith( it, m_end, "?" ) )
+			{
+				m_it = doSkipPast( it, m_end, "?>" );
+			}
+			else if ( startsWith( it, m_end, "!--" ) )
+			{
+				m_it = doSkipPast( it + 3, m_end, "-->" );
+			}
+			else if ( startsWith( it, m_end, "![CDATA[" ) )
+			{
+				m_it = doSkipPast( it, m_end, "]]>" );
+			}
+			else if ( startsWith( it, m_end, "!" ) )
+			{
+				m_it = doSkipDeclaration( it, m_end );
+			}
+			else if ( startsWith( it, m_end, "/" ) )
+			{
+				it = doParseName( it + 1, m_end, m_name );
+				it = doSkipSpaces( it, m_end );
+
+				if ( it == m_end || *it != '>' )
+				{
+					return doError( "expected >" );
+				}
+
+				if ( !m_open )
+				{
+					return doError( "unexpected end of element" );
+				}
+
+				m_it = it + 1;
+				m_depth = --m_open;
+				return Event::eEndElement;
+			}
+			else
+			{
+				it = doParseName( it, m_end, m_name );
+
+				if ( m_name.empty() )
+				{
+					return doError( "expected element name" );
+				}
+
+				auto tagEnd = doFindTagEnd( it, m_end );
+
+				if ( !tagEnd )
+				{
+					return doError( "expected >" );
+				}
+
+				auto empty = tagEnd[-1] == '/';
+				m_attributes = StringView{ it, empty ? tagEnd - 1 : tagEnd };
+				m_it = tagEnd + 1;
+				m_depth = m_open;
+
+				if ( empty )
+				{
+					m_pendingEnd = true;
+				}
+				else
+				{
+					++m_open;
+				}
+
+				return Event::eStartElement;
+			}
+
+			if ( !m_it )
+			{
+				return doError( "unterminated markup" );
+			}
+		}
+
+		if ( m_open )
+		{
+			return doError( "unexpected end of data" );
+		}
+
+		return Event::eEnd;
+	}
+
+	bool XmlPullReader::nextAttribute( StringView & name
+		, StringView & value )noexcept
+	{
+		auto end = m_attributes.end();
+		auto it = doSkipSpaces( m_attributes.begin(), end );
+		it = doParseName( it, end, name );
+
+		if ( name.empty() )
+		{
+			m_attributes = StringView{};
+			return false;
+		}
+
+		it = doSkipSpaces( it, end );
+
+		if ( it == end || *it != '=' )
+		{
+			m_attributes = StringView{};
+			return false;
+		}
+
+		it = doSkipSpaces( it + 1, end );
+
+		if ( it == end || ( *it != '"' && *it != '\'' ) )
+		{
+			m_attributes = StringView{};
+			return false;
+		}
+
+		auto quote = *it;
+		auto begin = ++it;
+
+		while ( it != end && *it != quote )
+		{
+			++it;
+		}
+
+		if ( it == end )
+		{
+			m_attributes = StringView{};
+			return false;
+		}
+
+		value = StringView{ begin, it };
+		m_attributes = StringView{ it + 1, end };
+		return true;
+	}
+
+	XmlPullReader::Event XmlPullReader::doError( char const * what )noexcept
+	{
+		std::cerr << "Parse error: " << what << std::endl;
+		m_it = m_end;
+		m_open = 0u;
+		m_pendingEnd = false;
+		return Event::eError;
+	}
+}
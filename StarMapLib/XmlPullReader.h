@@ -0,0 +1,121 @@
+/**
+*\file
+*	XmlPullReader.h
+*\author
+*	Sylvain Doremus
+*/
+#ifndef ___StarMapLib_XmlPullReader_HPP___
+#define ___StarMapLib_XmlPullReader_HPP___
+#pragma once
+
+#include "StringView.h"
+
+namespace starmap
+{
+	/**
+	*\brief
+	*	Lecteur XML séquentiel, à la demande.
+	*\remarks
+	*	Le contenu est parcouru sur place, sans construire d'arbre ni rien
+	*	copier : les noms et valeurs retournés référencent le contenu.\n
+	*	Seuls les éléments et leurs attributs sont remontés, le texte, les
+	*	commentaires, les instructions de traitement, les sections CDATA et
+	*	la DOCTYPE sont sautés. Les entités ne sont pas décodées.\n
+	*	Un élément vide (<a/>) produit un début puis une fin d'élément.
+	*/
+	class XmlPullReader
+	{
+	public:
+		/**
+		*\brief
+		*	Les évènements produits par le lecteur.
+		*/
+		enum class Event
+		{
+			//! Début d'un élément, ses attributs peuvent être lus.
+			eStartElement,
+			//! Fin d'un élément.
+			eEndElement,
+			//! Fin du contenu.
+			eEnd,
+			//! Contenu mal formé, la lecture est terminée.
+			eError,
+		};
+
+	public:
+		/**
+		*\brief
+		*	Constructeur.
+		*\param[in] content
+		*	Le contenu XML.
+		*/
+		explicit XmlPullReader( StringView const & content )noexcept;
+		/**
+		*\brief
+		*	Avance jusqu'au prochain évènement.
+		*\return
+		*	L'évènement.
+		*/
+		Event next()noexcept;
+		/**
+		*\brief
+		*	Lit l'attribut suivant de l'élément courant.
+		*\remarks
+		*	Ne peut être utilisé qu'après un Event::eStartElement.
+		*\param[out] name
+		*	Reçoit le nom de l'attribut.
+		*\param[out] value
+		*	Reçoit la valeur de l'attribut, sans les guillemets.
+		*\return
+		*	\p false s'il n'y a plus d'attribut.
+		*/
+		bool nextAttribute( StringView & name
+			, StringView & value )noexcept;
+		/**
+		*\return
+		*	Le nom de l'élément courant.
+		*/
+		inline StringView const & name()const noexcept
+		{
+			return m_name;
+		}
+		/**
+		*\return
+		*	La profondeur de l'élément courant, 0 pour la racine.
+		*/
+		inline uint32_t depth()const noexcept
+		{
+			return m_depth;
+		}
+		/**
+		*\return
+		*	La position courante dans le contenu, après le dernier
+		*	évènement.
+		*/
+		inline char const * position()const noexcept
+		{
+			return m_it;
+		}
+
+	private:
+		Event doError( char const * what )noexcept;
+
+	private:
+		//! La position courante dans le contenu.
+		char const * m_it;
+		//! La fin du contenu.
+		char const * m_end;
+		//! Le nom de l'élément courant.
+		StringView m_name;
+		//! Les attributs de l'élément courant restant à lire.
+		StringView m_attributes;
+		//! La profondeur de l'élément courant.
+		uint32_t m_depth{ 0u };
+		//! Le nombre d'éléments ouverts.
+		uint32_t m_open{ 0u };
+		//! Dit si l'élément courant est vide, sa fin est alors à émettre.
+		bool m_pendingEnd{ false };
+	};
+}
+
+#endif
@@ -1,14 +1,14 @@
 #include "XmlReader.h"
 
-#include "StarMap.h"
-
-#include <RenderLib/StringUtils.h>
+#include "Designation.h"
+#include "ReadMonitor.h"
+#include "StarCatalogue.h"
+#include "StarKernels.h"
+#include "XmlPullReader.h"
 
 #define RAPIDXML_NO_EXCEPTIONS
 #include "rapidxml/rapidxml.hpp"
 
-#include <regex>
-
 namespace rapidxml
 {
 	void parse_error_handler( char const * what, void * where )
@@ -27,23 +27,130 @@ namespace starmap
 				, node->value() + node->value_size() };
 		}
 
-		float doParseFloat( rapidxml::xml_attribute< char > * node )
+		/**
+		*\brief
+		*	Les attributs d'une étoile connus du loader.
+		*/
+		enum class Attribute
+			: uint8_t
+		{
+			eProper,
+			eGl,
+			eHip,
+			eMag,
+			eDecrad,
+			eRarad,
+			eCi,
+			eBf,
+			eBayer,
+			eCon,
+			eCount,
+			//! Attribut non utilisé.
+			eSkip = 0xFF,
+		};
+		static size_t constexpr AttributeCount = size_t( Attribute::eCount );
+
+		static StringView const AttributeNames[AttributeCount]
+		{
+			"proper",
+			"gl",
+			"hip",
+			"mag",
+			"decrad",
+			"rarad",
+			"ci",
+			"bf",
+			"bayer",
+			"con",
+		};
+		/**
+		*\brief
+		*	Le nombre d'étoiles accumulées avant d'être ajoutées au catalogue.
+		*/
+		static size_t constexpr StarBatchSize = 4096u;
+		/**
+		*\brief
+		*	Construit les étoiles du lot, puis les ajoute au catalogue.
+		*/
+		void doFlushBatch( StarBatch & batch
+			, StarCatalogue & catalogue )
+		{
+			StarArray stars;
+			appendStars( batch, stars );
+			catalogue.add( std::move( stars ) );
+			batch.clear();
+		}
+		/**
+		*\brief
+		*	La correspondance entre la position d'un attribut dans un élément
+		*	et l'attribut connu qu'il alimente.
+		*\remarks
+		*	Les éléments d'un export ont tous les mêmes attributs, dans le
+		*	même ordre : la correspondance est résolue au premier élément,
+		*	puis seulement vérifiée par une comparaison du nom. Elle est
+		*	résolue à nouveau pour les positions où le nom diffère.
+		*/
+		class AttributeSlots
+		{
+		public:
+			Attribute resolve( size_t position
+				, StringView const & name )
+			{
+				if ( position >= m_slots.size() )
+				{
+					m_slots.resize( position + 1u, { StringView{}, Attribute::eSkip } );
+				}
+
+				auto & slot = m_slots[position];
+
+				if ( slot.first != name )
+				{
+					auto it = std::find( std::begin( AttributeNames )
+						, std::end( AttributeNames )
+						, name );
+					slot.first = name;
+					slot.second = it == std::end( AttributeNames )
+						? Attribute::eSkip
+						: Attribute( std::distance( std::begin( AttributeNames ), it ) );
+				}
+
+				return slot.second;
+			}
+
+		private:
+			std::vector< std::pair< StringView, Attribute > > m_slots;
+		};
+		/**
+		*\brief
+		*	Les valeurs des attributs connus d'un élément Star, référençant le
+		*	contenu.
+		*/
+		using StarAttributes = std::array< StringView, AttributeCount >;
+
+		float doParseFloat( StringView const & text )
 		{
-			auto text = doParseString( node );
-			text = render::replace( text, "\"", "" );
-			text = render::replace( text, ",", "." );
-			std::stringstream stream{ text };
 			float result{ 0.0f };
-			stream >> result;
+
+			if ( std::find( text.begin(), text.end(), ',' ) == text.end() )
+			{
+				parseFloat( text, result );
+			}
+			else
+			{
+				// Export dont le séparateur de décimales est ','.
+				auto copy = text.str();
+				std::replace( copy.begin(), copy.end(), ',', '.' );
+				parseFloat( copy, result );
+			}
+
 			return result;
 		}
 
-		int doParseInt( std::string text )
+		bool doContains( StringView const & text
+			, StringView const & value )
 		{
-			std::stringstream stream{ text };
-			int result{ 0 };
-			stream >> result;
-			return result;
+			return std::search( text.begin(), text.end()
+				, value.begin(), value.end() ) != text.end();
 		}
 
 		void doLoadLinks( Constellation & constellation
@@ -66,297 +173,176 @@ namespace starmap
 			}
 		}
 
-		bool doExtractFromBF( std::string bf
-			, uint32_t & id
-			, uint32_t & index
-			, std::string & letter )
+		void doPreAddConstellation( StringView const & bf
+			, StringView const & bayer
+			, StringView const & constellation
+			, StringView const & star
+			, ConstellationMap & constellations )
 		{
-			bool result = false;
-			std::regex regexLetter{ R"((\d*)[^a-zA-Z]*([a-zA-Z]*)(\d*).*)" };
-			bf = bf.substr( 0u, bf.size() - 3u );
-			auto begin = std::begin( bf );
-			auto end = std::end( bf );
-			const std::sregex_iterator endit;
-			std::sregex_iterator it( begin, end, regexLetter );
-
-			if ( it != endit )
+			auto name = findConstellationName( constellation );
+
+			if ( name && *name )
 			{
-				std::smatch match = *it;
-				letter = match[2].str();
-				auto sid = match[1].str();
-				auto sindex = match[3].str();
-
-				if ( !sid.empty()
-					|| !letter.empty()
-					|| !sindex.empty() )
+				auto itc = constellations.find( name );
+
+				if ( itc == constellations.end() )
 				{
-					id = doParseInt( sid );
-					index = doParseInt( sindex );
-					result = true;
+					itc = constellations.emplace( name
+						, std::make_unique< Constellation >( name ) ).first;
 				}
-			}
 
-			return result;
-		}
+				Designation designation;
 
-		bool doExtractFromBayer( std::string const & bayer
-			, uint32_t & index
-			, std::string & letter )
-		{
-			bool result = false;
-			std::regex regexLetter{ R"(([a-zA-Z]*)-?(\d*))" };
-			auto begin = std::begin( bayer );
-			auto end = std::end( bayer );
-			const std::sregex_iterator endit;
-			std::sregex_iterator it( begin, end, regexLetter );
-
-			if ( it != endit )
-			{
-				std::smatch match = *it;
-				letter = match[1].str();
-				auto sindex = match[2].str();
-
-				if ( !letter.empty()
-					|| !sindex.empty() )
+				if ( !parseFlamsteedBayer( bf, designation )
+					|| designation.index == 0 )
 				{
-					index = doParseInt( sindex );
-					result = true;
+					parseBayer( bayer, designation );
 				}
-			}
 
-			return result;
-		}
+				auto id = designation.flamsteed;
 
-		void doPreAddConstellation( std::string bf
-			, std::string const & bayer
-			, std::string const & constellation
-			, std::string const & star
-			, ConstellationMap & constellations )
-		{
-			static std::map< std::string, std::string > const letters
-			{
-				{ "Alp", "Alpha" },
-				{ "Bet", "Beta" },
-				{ "Gam", "Gamma" },
-				{ "Del", "Delta" },
-				{ "Eps", "Epsilon" },
-				{ "Zet", "Zeta" },
-				{ "Eta", "Eta" },
-				{ "The", "Theta" },
-				{ "Iot", "Iota" },
-				{ "Kap", "Kappa" },
-				{ "Lam", "Lambda" },
-				{ "Mu", "Mu" },
-				{ "Nu", "Nu" },
-				{ "Ksi", "Ksi" },
-				{ "Omi", "Omicron" },
-				{ "Pi", "Pi" },
-				{ "Rho", "Rho" },
-				{ "Sig", "Sigma" },
-				{ "Tau", "Tau" },
-				{ "Ups", "Upsilon" },
-				{ "Phi", "Phi" },
-				{ "Chi", "Chi" },
-				{ "Psi", "Psi" },
-				{ "Ome", "Omega" },
-				{ "Xi", "Xi" },
-			};
-			static std::map< std::string, std::string > const names
-			{
-				{ "And", "Andromeda" },
-				{ "Ant", "Antlia" },
-				{ "Aps", "Apus" },
-				{ "Ara", "Ara" },
-				{ "Ari", "Aries" },
-				{ "Aql", "" },
-				{ "Aqr", "Aquarius" },
-				{ "Aur", "" },
-				{ "Boo", "Bootes" },
-				{ "Cae", "" },
-				{ "Cam", "Camelopardalis" },
-				{ "Cap", "" },
-				{ "Car", "" },
-				{ "Cas", "Cassiopea" },
-				{ "Cnc", "" },
-				{ "Cen", "Centaurus" },
-				{ "Cep", "" },
-				{ "Cet", "" },
-				{ "Cha", "" },
-				{ "Cir", "" },
-				{ "CMa", "Canis Majoris" },
-				{ "CMi", "Canis Minor" },
-				{ "Col", "" },
-				{ "Com", "" },
-				{ "CrA", "" },
-				{ "CrB", "" },
-				{ "Crt", "" },
-				{ "Cru", "" },
-				{ "Crv", "" },
-				{ "CVn", "" },
-				{ "Cyg", "Cygnus" },
-				{ "Del", "" },
-				{ "Dor", "" },
-				{ "Dra", "Dragonis" },
-				{ "Equ", "Equuleus" },
-				{ "Eri", "" },
-				{ "For", "" },
-				{ "Gem", "Gemini" },
-				{ "Gru", "Grus" },
-				{ "Her", "Hercules" },
-				{ "Hya", "Hydra" },
-				{ "Hyi", "Hydrus" },
-				{ "Hor", "Horologium" },
-				{ "Ind", "Indus" },
-				{ "Lac", "Lacerta" },
-				{ "Leo", "Leo" },
-				{ "Lep", "Lepus" },
-				{ "Lib", "Libra" },
-				{ "LMi", "Leo Minor" },
-				{ "Lup", "Lupus" },
-				{ "Lyn", "Lynx" },
-				{ "Lyr", "Lyra" },
-				{ "Men", "Mensa" },
-				{ "Mic", "Microscopium" },
-				{ "Mon", "Monoceros" },
-				{ "Mus", "Musca" },
-				{ "Nor", "Norma" },
-				{ "Oct", "Octant" },
-				{ "Oph", "Ophiuchus" },
-				{ "Ori", "Orion" },
-				{ "Pav", "Pavo" },
-				{ "Peg", "Pegasus" },
-				{ "Per", "Perseus" },
-				{ "Phe", "Phoenix" },
-				{ "Pic", "Pictor" },
-				{ "PsA", "Piscis Austrinus" },
-				{ "Psc", "Pisces" },
-				{ "Pyx", "" },
-				{ "Pup", "Puppis" },
-				{ "Ret", "Reticulum" },
-				{ "Scl", "Sculptor" },
-				{ "Sco", "Scorpio" },
-				{ "Sct", "" },
-				{ "Ser", "Serpens" },
-				{ "Sex", "Sextant" },
-				{ "Sge", "" },
-				{ "Sgr", "Sagittarius" },
-				{ "Tau", "Taurus" },
-				{ "Tel", "Telescopium" },
-				{ "TrA", "Triangulum Australe" },
-				{ "Tri", "Triangulum" },
-				{ "Tuc", "Tucana" },
-				{ "UMa", "Ursa Major" },
-				{ "UMi", "Ursa Minor" },
-				{ "Vel", "Vela" },
-				{ "Vir", "Virgo" },
-				{ "Vol", "Volans" },
-				{ "Vul", "Vulpecula" },
-			};
-			auto itn = names.find( constellation );
-
-			if ( itn != names.end() )
-			{
-				if ( !itn->second.empty() )
+				if ( !designation.letter.empty()
+					|| id != 0 )
 				{
-					auto itc = constellations.emplace( itn->second
-						, std::make_unique< Constellation >( itn->second ) ).first;
-					uint32_t id{ 0u };
-					uint32_t index{ 0u };
-					std::string letter;
-
-					if ( !doExtractFromBF( bf, id, index, letter )
-						|| index == 0 )
-					{
-						doExtractFromBayer( bayer, index, letter );
-					}
+					auto letter = findGreekLetter( designation.letter );
 
-					if ( !letter.empty()
-						|| id != 0 )
+					if ( letter )
 					{
-						auto itl = letters.find( letter );
-
-						if ( itl != letters.end() )
+						if ( designation.index != 0 )
 						{
-							if ( index != 0 )
-							{
-								std::stringstream stream;
-								stream << index;
-								itc->second->addStar( id, itl->second + stream.str(), star );
-							}
-							else
-							{
-								itc->second->addStar( id, itl->second, star );
-							}
+							itc->second->addStar( id
+								, letter + std::to_string( designation.index )
+								, star );
 						}
 						else
 						{
-							std::stringstream stream;
-							stream << id;
-							itc->second->addStar( id, stream.str(), star );
+							itc->second->addStar( id, letter, star );
 						}
 					}
+					else
+					{
+						itc->second->addStar( id, std::to_string( id ), star );
+					}
 				}
 			}
 		}
 	}
 
-	void loadStarsFromXml( StarMap & starmap, std::string content )
+	void loadStarsFromXml( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor )
 	{
-		rapidxml::xml_document<> doc;
-		doc.parse< rapidxml::parse_non_destructive >( &content[0] );
+		XmlPullReader reader{ content };
+		AttributeSlots slots;
 		ConstellationMap constellations;
-
-		for ( auto slNode = doc.first_node( "StarList" );
-			slNode;
-			slNode = slNode->next_sibling() )
+		StarBatch batch;
+		bool inList{ false };
+		auto reported = content.begin();
+		monitor.start( content.size() );
+		auto event = reader.next();
+
+		while ( event != XmlPullReader::Event::eEnd
+			&& event != XmlPullReader::Event::eError )
 		{
-			for ( auto sNode = slNode->first_node( "Star" );
-				sNode;
-				sNode = sNode->next_sibling() )
+			if ( event == XmlPullReader::Event::eStartElement )
 			{
-				auto name = doParseString( sNode->first_attribute( "proper" ) );
-
-				if ( name.empty() )
+				if ( reader.depth() == 0u )
 				{
-					name = doParseString( sNode->first_attribute( "gl" ) );
+					inList = reader.name() == "StarList";
 				}
-
-				if ( name.empty() )
+				else if ( inList
+					&& reader.depth() == 1u
+					&& reader.name() == "Star" )
 				{
-					name = doParseString( sNode->first_attribute( "hip" ) );
-				}
+					StarAttributes values;
+					StringView attribute;
+					StringView value;
+					size_t position{ 0u };
 
-				auto mag = doParseFloat( sNode->first_attribute( "mag" ) );
-				auto dec = doParseFloat( sNode->first_attribute( "decrad" ) );
-				auto ra = doParseFloat( sNode->first_attribute( "rarad" ) );
-				auto ci = doParseFloat( sNode->first_attribute( "ci" ) );
-				auto colour = bvToRgb( ci );
-				sNode->first_attribute( "spect" );
-				sNode->first_attribute( "con" );
-				starmap.add( Star{ name, mag, gl::Vec2{ ra, dec }, colour } );
-				auto bf = doParseString( sNode->first_attribute( "bf" ) );
-				auto bayer = doParseString( sNode->first_attribute( "bayer" ) );
-				auto con = doParseString( sNode->first_attribute( "con" ) );
-
-				if ( !bf.empty()
-					&& !con.empty()
-					&& bf.find( con ) != std::string::npos )
-				{
-					doPreAddConstellation( bf, bayer, con, name, constellations );
+					while ( reader.nextAttribute( attribute, value ) )
+					{
+						auto slot = slots.resolve( position++, attribute );
+
+						if ( slot != Attribute::eSkip )
+						{
+							values[size_t( slot )] = value;
+						}
+					}
+
+					auto name = values[size_t( Attribute::eProper )];
+
+					if ( name.empty() )
+					{
+						name = values[size_t( Attribute::eGl )];
+					}
+
+					if ( name.empty() )
+					{
+						name = values[size_t( Attribute::eHip )];
+					}
+
+					if ( batch.size() == 0u )
+					{
+						batch.reserve( StarBatchSize );
+					}
+
+					batch.push( catalogue.namePool().add( name )
+						, doParseFloat( values[size_t( Attribute::eMag )] )
+						, doParseFloat( values[size_t( Attribute::eRarad )] )
+						, doParseFloat( values[size_t( Attribute::eDecrad )] )
+						, doParseFloat( values[size_t( Attribute::eCi )] ) );
+					auto & bf = values[size_t( Attribute::eBf )];
+					auto & con = values[size_t( Attribute::eCon )];
+
+					if ( !bf.empty()
+						&& !con.empty()
+						&& doContains( bf, con ) )
+					{
+						doPreAddConstellation( bf
+							, values[size_t( Attribute::eBayer )]
+							, con
+							, name
+							, constellations );
+					}
+
+					if ( batch.size() == StarBatchSize )
+					{
+						doFlushBatch( batch, catalogue );
+
+						if ( !monitor.advance( size_t( reader.position() - reported ) ) )
+						{
+							return;
+						}
+
+						reported = reader.position();
+					}
 				}
 			}
+
+			event = reader.next();
 		}
 
+		doFlushBatch( batch, catalogue );
+		monitor.advance( size_t( content.end() - reported ) );
+
 		for ( auto & cons : constellations )
 		{
-			starmap.add( *cons.second );
+			catalogue.add( *cons.second );
 		}
 	}
 
-	void loadConstellationsFromXml( StarMap & starmap, std::string content )
+	void loadConstellationsFromXml( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor )
 	{
+		// rapidxml a besoin d'un texte modifiable terminé par un zéro.
+		auto text = content.str();
 		rapidxml::xml_document<> doc;
-		doc.parse< rapidxml::parse_non_destructive >( &content[0] );
+		monitor.start( content.size() );
+		doc.parse< rapidxml::parse_non_destructive >( &text[0] );
+		// Le document est analysé d'un bloc, l'avancement n'est compté que
+		// pour le parcours des constellations.
+		char const * reported = &text[0];
 
 		for ( auto clNode = doc.first_node( "ConstellationList" );
 			clNode;
@@ -368,13 +354,22 @@ namespace starmap
 			{
 				auto nAttrib = cNode->first_attribute( "Name" );
 				std::string name{ doParseString( nAttrib ) };
-				auto constellation = starmap.findConstellation( name );
+				auto constellation = catalogue.findConstellation( name );
 
 				if ( constellation )
 				{
 					doLoadLinks( *constellation, cNode );
 				}
+
+				if ( !monitor.advance( size_t( cNode->name() - reported ) ) )
+				{
+					return;
+				}
+
+				reported = cNode->name();
 			}
 		}
+
+		monitor.advance( size_t( &text[0] + text.size() - reported ) );
 	}
 }
@@ -8,20 +8,52 @@
 #define ___StarMapLib_XmlReader_HPP___
 #pragma once
 
-#include "StarMapLibPrerequisites.h"
+#include "ReadMonitor.h"
+#include "StringView.h"
 
 namespace starmap
 {
 	/**
 	*\brief
 	*	Charge des toiles depuis un fichier XML.
+	*\remarks
+	*	Le fichier doit suivre le schma StarList/Star, les attributs
+	*	suivants des lments Star sont utiliss : proper, gl, hip, mag,
+	*	decrad, rarad, ci, bf, bayer et con.\n
+	*	Le contenu est lu squentiellement, sans construire d'arbre : la
+	*	correspondance entre les attributs et leur rle est rsolue au
+	*	premier lment, et les toiles sont ajoutes au catalogue par lots.\n
+	*	L'avancement est compt en octets du contenu, et consult  chaque
+	*	lot : si la lecture est annule, le catalogue ne reoit que les
+	*	lots dj lus, sans les constellations.
+	*\param[in,out] catalogue
+	*	Le catalogue recevant les toiles.
+	*\param[in] content
+	*	Le contenu du fichier, qui peut tre une projection mmoire du
+	*	fichier (une std::string est convertie implicitement).
+	*\param[in] monitor
+	*	Le suivi de la lecture.
 	*/
-	void loadStarsFromXml( StarMap & starmap, std::string content );
+	void loadStarsFromXml( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor = ReadMonitor{} );
 	/**
 	*\brief
 	*	Charge des constellations depuis un fichier XML.
+	*\remarks
+	*	L'avancement est compt en octets du contenu, et consult  chaque
+	*	constellation.
+	*\param[in,out] catalogue
+	*	Le catalogue recevant les constellations.
+	*\param[in] content
+	*	Le contenu du fichier, qui peut tre une projection mmoire du
+	*	fichier (une std::string est convertie implicitement).
+	*\param[in] monitor
+	*	Le suivi de la lecture.
 	*/
-	void loadConstellationsFromXml( StarMap & starmap, std::string content );
+	void loadConstellationsFromXml( StarCatalogue & catalogue
+		, StringView const & content
+		, ReadMonitor const & monitor = ReadMonitor{} );
 }
 
 #endif
@@ -4,23 +4,50 @@
 
 #include <array>
 #include <chrono>
+#include <fstream>
 #include <random>
 #include <string>
 
 #include <DesktopUtils/FontLoader.h>
+#include <DesktopUtils/MappedFile.h>
 #include <DesktopUtils/ObjLoader.h>
 #include <DesktopUtils/Log.h>
 
 #include <StarMapLib/CsvReader.h>
+#include <StarMapLib/SmcReader.h>
 #include <StarMapLib/StarMapState.h>
+#include <StarMapLib/TileCache.h>
 #include <StarMapLib/XmlReader.h>
 
+namespace
+{
+	//! La mémoire allouée aux tuiles du catalogue par tuiles.
+	static size_t const TileBudget{ 256u * 1024u * 1024u };
+
+	void doStreamTiles( starmap::StarMap & starmap )
+	{
+		// Le catalogue par tuiles est optionnel, il remplace alors les
+		// étoiles du catalogue pour l'affichage.
+		if ( std::ifstream{ "stars.smt" } )
+		{
+			auto tiles = std::make_unique< starmap::TileCache >( "stars.smt"
+				, TileBudget );
+
+			if ( tiles->valid() )
+			{
+				starmap.stream( std::move( tiles ) );
+			}
+		}
+	}
+}
+
 Window::Window()
 	: MsWindow{}
 	, m_events{ m_onScreenTap
 		, m_onScreenDoubleTap
 		, m_onScreenSingleMove
-		, m_onScreenDoubleMove }
+		, m_onScreenDoubleMove
+		, m_onScreenHover }
 {
 	std::string const appName = "RenderLibTestApp";
 	m_cout = new render::LogStreambuf< utils::InfoLogStreambufTraits >( appName
@@ -58,18 +85,54 @@ void Window::onCreate()
 		, utils::FontLoader{ dataPath }
 		, utils::getFileBinaryContent( "halo.bmp" ) );
 
-	try
-	{
-		starmap::loadStarsFromXml( *m_starmap
-			, utils::getFileTextContent( "stars.xml" ) );
-		starmap::loadConstellationsFromXml( *m_starmap
-			, utils::getFileTextContent( "constellations.xml" ) );
-		m_starmap->initialise();
-	}
-	catch ( std::exception & exc )
-	{
-		std::cerr << "Csv loading failed: " << exc.what() << std::endl;
-	}
+	auto loader = std::make_unique< starmap::CatalogueLoader >();
+	loader->addStep( []( starmap::StarCatalogue & catalogue
+		, starmap::ReadMonitor const & monitor )
+		{
+			utils::MappedFile binary{ "stars.smc" };
+
+			if ( !binary.valid()
+				|| ( !starmap::loadCatalogueFromSmc( catalogue
+						, { binary.begin(), binary.end() }
+						, monitor )
+					&& !monitor.cancelled() ) )
+			{
+				utils::MappedFile stars{ "stars.xml" };
+				starmap::loadStarsFromXml( catalogue
+					, { stars.begin(), stars.end() }
+					, monitor );
+			}
+		} );
+	loader->addStep( []( starmap::StarCatalogue & catalogue
+		, starmap::ReadMonitor const & monitor )
+		{
+			// Le catalogue binaire contient déjà les constellations.
+			if ( catalogue.constellations().empty() )
+			{
+				utils::MappedFile constellations{ "constellations.xml" };
+				starmap::loadConstellationsFromXml( catalogue
+					, { constellations.begin(), constellations.end() }
+					, monitor );
+			}
+		} );
+	loader->addStep( []( starmap::StarCatalogue & catalogue
+		, starmap::ReadMonitor const & monitor )
+		{
+			// Les objets du ciel profond sont optionnels.
+			utils::MappedFile objects{ "dso.csv" };
+
+			if ( objects.valid() )
+			{
+				starmap::loadDeepSkyObjectsFromCsv( catalogue
+					, { objects.begin(), objects.end() }
+					, 0u
+					, monitor );
+			}
+		} );
+	m_starmap->load( std::move( loader ) );
+	doStreamTiles( *m_starmap );
+	m_starmap->initialise();
+	m_starmap->hovering( true );
 }
 
 void Window::onDestroy()
@@ -92,7 +155,9 @@ void Window::onRestore( gl::IVec2 const & event )
 		, utils::FontLoader{ dataPath }
 	, utils::getFileBinaryContent( "halo.bmp" ) );
 	m_starmap->restore( m_savedState );
+	doStreamTiles( *m_starmap );
 	m_starmap->initialise();
+	m_starmap->hovering( true );
 }
 
 void Window::onResize( gl::IVec2 const & event )
@@ -108,6 +173,10 @@ void Window::onMouseMove( utils::MouseEvent const & event )
 		m_onScreenSingleMove( diff );
 		m_mouse = event.position;
 	}
+	else
+	{
+		m_onScreenHover( event.position );
+	}
 }
 
 void Window::onLButtonDown( utils::MouseEvent const & event )
@@ -104,6 +104,8 @@ private:
 	starmap::OnScreenSingleMove m_onScreenSingleMove;
 	//! Le signal émis lorsque l'on effectue un déplacement avec deux doigts sur l'écran.
 	starmap::OnScreenDoubleMove m_onScreenDoubleMove;
+	//! Le signal émis lorsque la souris survole l'écran.
+	starmap::OnScreenHover m_onScreenHover;
 	//! Les évènements écran.
 	starmap::ScreenEvents m_events;
 	//! La carte des étoiles.
@@ -4,6 +4,7 @@
 #include <AndroidUtils/FontLoader.h>
 
 #include <StarMapLib/CsvReader.h>
+#include <StarMapLib/SmcReader.h>
 #include <StarMapLib/StarMapState.h>
 #include <StarMapLib/XmlReader.h>
 
@@ -25,10 +26,54 @@ Window::Window( utils::AndroidApp const & parent
 {
 	if ( state.empty() )
 	{
-		starmap::loadStarsFromXml( m_starmap
-			, m_parent.getFileTextContent( "stars.xml", true ) );
-		starmap::loadConstellationsFromXml( m_starmap
-			, m_parent.getFileTextContent( "constellations.xml", true ) );
+		// Le chargement est annulé à la destruction de la carte, avec la
+		// fenêtre, avant celle de l'application.
+		auto & parent = m_parent;
+		auto loader = std::make_unique< starmap::CatalogueLoader >();
+		loader->addStep( [&parent]( starmap::StarCatalogue & catalogue
+			, starmap::ReadMonitor const & monitor )
+			{
+				auto binary = parent.mapFileContent( "stars.smc" );
+
+				if ( !binary.valid()
+					|| ( !starmap::loadCatalogueFromSmc( catalogue
+							, { binary.begin(), binary.end() }
+							, monitor )
+						&& !monitor.cancelled() ) )
+				{
+					auto stars = parent.mapFileContent( "stars.xml" );
+					starmap::loadStarsFromXml( catalogue
+						, { stars.begin(), stars.end() }
+						, monitor );
+				}
+			} );
+		loader->addStep( [&parent]( starmap::StarCatalogue & catalogue
+			, starmap::ReadMonitor const & monitor )
+			{
+				// Le catalogue binaire contient déjà les constellations.
+				if ( catalogue.constellations().empty() )
+				{
+					auto constellations = parent.mapFileContent( "constellations.xml" );
+					starmap::loadConstellationsFromXml( catalogue
+						, { constellations.begin(), constellations.end() }
+						, monitor );
+				}
+			} );
+		loader->addStep( [&parent]( starmap::StarCatalogue & catalogue
+			, starmap::ReadMonitor const & monitor )
+			{
+				// Les objets du ciel profond sont optionnels.
+				auto objects = parent.mapFileContent( "dso.csv" );
+
+				if ( objects.valid() )
+				{
+					starmap::loadDeepSkyObjectsFromCsv( catalogue
+						, { objects.begin(), objects.end() }
+						, 0u
+						, monitor );
+				}
+			} );
+		m_starmap.load( std::move( loader ) );
 	}
 }
 